@@ -2117,8 +2117,15 @@ void Parser::ParseLV4MeshFloatTriple(ai_real* apOut)
 {
     ai_assert(NULL != apOut);
 
-    for (unsigned int i = 0; i < 3;++i)
-        ParseLV4MeshFloat(apOut[i]);
+    // parse all three floats at once, missing ones are set to zero
+    const size_t numValues = ReadRealArray(filePtr, apOut, 3, true);
+    if (numValues < 3)
+    {
+        // LOG
+        LogWarning("Unable to parse float: unexpected EOL [#1]");
+        std::fill(apOut + numValues, apOut + 3, ai_real(0.0));
+        ++iLineNumber;
+    }
 }
 // ------------------------------------------------------------------------------------------------
 void Parser::ParseLV4MeshFloat(ai_real& fOut)
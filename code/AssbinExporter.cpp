@@ -45,8 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include "ProcessHelper.h"
 #include "Exceptional.h"
+#include "TaskScheduler.h"
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #   include <zlib.h>
@@ -55,6 +57,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <time.h>
+#include <memory>
+#include <vector>
 
 
 #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -223,6 +227,44 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
     return n;
 }
 
+// Mesh blocks store arrays as they are laid out in memory, which matches the
+// element-wise serialization above unless Assimp uses double precision.
+template <typename T>
+inline size_t WriteRawArray(IOStream * stream, const T* in, unsigned int size)
+{
+#ifdef ASSIMP_DOUBLE_PRECISION
+    return WriteArray<T>(stream,in,size);
+#else
+    return size ? stream->Write(in,sizeof(T),size) * sizeof(T) : 0;
+#endif
+}
+
+// Pads a stream with zeros up to the next multiple of ASSBIN_ALIGNMENT
+inline void WritePadding(IOStream * stream)
+{
+    static const char zeros[ASSBIN_ALIGNMENT] = {};
+    const size_t pad = (ASSBIN_ALIGNMENT - stream->Tell() % ASSBIN_ALIGNMENT) % ASSBIN_ALIGNMENT;
+    if (pad) {
+        stream->Write(zeros,1,pad);
+    }
+}
+
+// A frame of a compressed file, see assbin_chunks.h
+struct AssbinFrame
+{
+    const uint8_t* data;
+    size_t size;
+};
+
+// Cuts data into frames of at most ASSBIN_FRAME_SIZE bytes
+inline void AddFrames(std::vector<AssbinFrame>& frames, const uint8_t* data, size_t size)
+{
+    for (size_t ofs = 0; ofs < size; ofs += ASSBIN_FRAME_SIZE) {
+        const AssbinFrame frame = { data + ofs, std::min<size_t>(size - ofs, ASSBIN_FRAME_SIZE) };
+        frames.push_back(frame);
+    }
+}
+
     // ----------------------------------------------------------------------------------
     /** @class  AssbinChunkWriter
      *  @brief  Chunk writer mechanism for the .assbin file structure
@@ -305,6 +347,39 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
     };
 
+    // ----------------------------------------------------------------------------------
+    /** @class  AssbinByteCounter
+     *  @brief  Output stream which only counts the bytes written to it
+     *
+     *  Used to determine the size of mesh blocks, which are written straight to
+     *  the file instead of being buffered like regular chunks.
+     */
+    class AssbinByteCounter : public IOStream
+    {
+    private:
+        size_t cursor;
+
+    public:
+        explicit AssbinByteCounter( size_t start )
+            : cursor(start)
+        {
+        }
+
+        // -------------------------------------------------------------------
+        virtual size_t Read(void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) { return 0; }
+        virtual aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) { return aiReturn_FAILURE; }
+        virtual size_t Tell() const { return cursor; }
+        virtual size_t FileSize() const { return cursor; }
+        virtual void Flush() { }
+
+        // -------------------------------------------------------------------
+        virtual size_t Write(const void* /*pvBuffer*/, size_t pSize, size_t pCount)
+        {
+            cursor += pSize * pCount;
+            return pCount;
+        }
+    };
+
     // ----------------------------------------------------------------------------------
     /** @class  AssbinExport
      *  @brief  Assbin exporter class
@@ -316,6 +391,8 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
     private:
         bool shortened;
         bool compressed;
+        int compressionLevel;
+        unsigned int numThreads;
 
     protected:
 
@@ -506,6 +583,130 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             }
         }
 
+        // -----------------------------------------------------------------------------------
+        // Writes the contents of a mesh block, see assbin_chunks.h. Positions
+        // are aligned relative to the start of the data following the header.
+        void WriteBinaryMeshBlockData(IOStream * out, const aiMesh* mesh)
+        {
+            unsigned int c = 0, numIndices = 0;
+            if (mesh->mVertices) {
+                c |= ASSBIN_MESH_HAS_POSITIONS;
+            }
+            if (mesh->mNormals) {
+                c |= ASSBIN_MESH_HAS_NORMALS;
+            }
+            if (mesh->mTangents && mesh->mBitangents) {
+                c |= ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS;
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS && mesh->mTextureCoords[n];++n) {
+                c |= ASSBIN_MESH_HAS_TEXCOORD(n);
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS && mesh->mColors[n];++n) {
+                c |= ASSBIN_MESH_HAS_COLOR(n);
+            }
+            for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+                numIndices += mesh->mFaces[i].mNumIndices;
+            }
+            Write<unsigned int>(out,c);
+            Write<unsigned int>(out,numIndices);
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS && mesh->mTextureCoords[n];++n) {
+                Write<unsigned int>(out,mesh->mNumUVComponents[n]);
+            }
+
+            if (c & ASSBIN_MESH_HAS_POSITIONS) {
+                WritePadding(out);
+                WriteRawArray<aiVector3D>(out,mesh->mVertices,mesh->mNumVertices);
+            }
+            if (c & ASSBIN_MESH_HAS_NORMALS) {
+                WritePadding(out);
+                WriteRawArray<aiVector3D>(out,mesh->mNormals,mesh->mNumVertices);
+            }
+            if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS) {
+                WritePadding(out);
+                WriteRawArray<aiVector3D>(out,mesh->mTangents,mesh->mNumVertices);
+                WritePadding(out);
+                WriteRawArray<aiVector3D>(out,mesh->mBitangents,mesh->mNumVertices);
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS && mesh->mColors[n];++n) {
+                WritePadding(out);
+                WriteRawArray<aiColor4D>(out,mesh->mColors[n],mesh->mNumVertices);
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS && mesh->mTextureCoords[n];++n) {
+                WritePadding(out);
+                WriteRawArray<aiVector3D>(out,mesh->mTextureCoords[n],mesh->mNumVertices);
+            }
+
+            // face sizes and indices are collected in batches to keep the
+            // number of writes down
+            static const size_t batchSize = 4096;
+            std::vector<uint16_t> sizes;
+            sizes.reserve(std::min<size_t>(mesh->mNumFaces,batchSize));
+            WritePadding(out);
+            for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+                static_assert(AI_MAX_FACE_INDICES <= 0xffff, "AI_MAX_FACE_INDICES <= 0xffff");
+                sizes.push_back(static_cast<uint16_t>(mesh->mFaces[i].mNumIndices));
+                if (sizes.size() == batchSize || i + 1 == mesh->mNumFaces) {
+                    out->Write(&sizes[0],sizeof(uint16_t),sizes.size());
+                    sizes.clear();
+                }
+            }
+
+            std::vector<uint32_t> indices;
+            indices.reserve(std::min<size_t>(numIndices,batchSize));
+            WritePadding(out);
+            for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+                const aiFace& f = mesh->mFaces[i];
+                indices.insert(indices.end(),f.mIndices,f.mIndices + f.mNumIndices);
+                if (indices.size() >= batchSize || (i + 1 == mesh->mNumFaces && !indices.empty())) {
+                    out->Write(&indices[0],sizeof(uint32_t),indices.size());
+                    indices.clear();
+                }
+            }
+
+            for (unsigned int a = 0; a < mesh->mNumBones;++a) {
+                const aiBone* b = mesh->mBones[a];
+                Write<aiString>(out,b->mName);
+                Write<unsigned int>(out,b->mNumWeights);
+                Write<aiMatrix4x4>(out,b->mOffsetMatrix);
+                WritePadding(out);
+                WriteRawArray<aiVertexWeight>(out,b->mWeights,b->mNumWeights);
+            }
+        }
+
+        // -----------------------------------------------------------------------------------
+        // Mesh blocks are written straight to the output, their size is
+        // determined in a first pass which only counts the bytes
+        void WriteBinaryMeshBlock(IOStream * container, const aiMesh* mesh)
+        {
+            AssbinByteCounter counter( container->Tell() + 8 );
+            WriteBinaryMeshBlockData( &counter, mesh );
+
+            const size_t size = counter.Tell() - container->Tell() - 8;
+            if (size > 0xffffffff) {
+                throw DeadlyExportError("mesh is too large for the assbin format");
+            }
+            Write<unsigned int>(container,ASSBIN_CHUNK_AIMESHBLOCK);
+            Write<unsigned int>(container,static_cast<unsigned int>(size));
+            WriteBinaryMeshBlockData( container, mesh );
+        }
+
+        // -----------------------------------------------------------------------------------
+        void WriteBinaryMeshTable(IOStream * container, const aiScene* scene, const std::vector<uint64_t>& offsets)
+        {
+            AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AIMESHTABLE );
+
+            Write<unsigned int>(&chunk,scene->mNumMeshes);
+            for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+                const aiMesh* mesh = scene->mMeshes[i];
+                Write<uint64_t>(&chunk,offsets[i]);
+                Write<unsigned int>(&chunk,mesh->mPrimitiveTypes);
+                Write<unsigned int>(&chunk,mesh->mNumVertices);
+                Write<unsigned int>(&chunk,mesh->mNumFaces);
+                Write<unsigned int>(&chunk,mesh->mNumBones);
+                Write<unsigned int>(&chunk,mesh->mMaterialIndex);
+            }
+        }
+
         // -----------------------------------------------------------------------------------
         void WriteBinaryMaterialProperty(IOStream * container, const aiMaterialProperty* prop)
         {
@@ -624,7 +825,11 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
         }
 
         // -----------------------------------------------------------------------------------
-        void WriteBinaryScene( IOStream * container, const aiScene* scene)
+        // meshOffsets refers to the mesh blocks written before, without it all
+        // meshes are stored inline as ASSBIN_CHUNK_AIMESH subchunks. frameStarts
+        // receives the offsets of the animation and texture chunks in container.
+        void WriteBinaryScene( IOStream * container, const aiScene* scene, const std::vector<uint64_t>* meshOffsets,
+            std::vector<size_t>* frameStarts = NULL)
         {
             AssbinChunkWriter chunk( container, ASSBIN_CHUNK_AISCENE );
 
@@ -641,7 +846,10 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             WriteBinaryNode( &chunk, scene->mRootNode );
 
             // write all meshes
-            for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+            if (meshOffsets) {
+                WriteBinaryMeshTable( &chunk, scene, *meshOffsets );
+            }
+            else for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
                 const aiMesh* mesh = scene->mMeshes[i];
                 WriteBinaryMesh( &chunk,mesh);
             }
@@ -655,6 +863,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             // write all animations
             for (unsigned int i = 0; i < scene->mNumAnimations;++i) {
                 const aiAnimation* anim = scene->mAnimations[i];
+                if (frameStarts) {
+                    frameStarts->push_back( container->Tell() + 2 * sizeof(uint32_t) + chunk.Tell() );
+                }
                 WriteBinaryAnim(&chunk,anim);
             }
 
@@ -662,6 +873,9 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             // write all textures
             for (unsigned int i = 0; i < scene->mNumTextures;++i) {
                 const aiTexture* mesh = scene->mTextures[i];
+                if (frameStarts) {
+                    frameStarts->push_back( container->Tell() + 2 * sizeof(uint32_t) + chunk.Tell() );
+                }
                 WriteBinaryTexture(&chunk,mesh);
             }
 
@@ -679,10 +893,121 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
         }
 
+        // -----------------------------------------------------------------------------------
+        // Write everything following the header. The stream position must be
+        // aligned, mesh blocks are aligned relative to it.
+        void WriteBinaryData( IOStream * container, const aiScene* scene )
+        {
+            // shortened dumps are only compared, never loaded, keep them inline
+            if (shortened) {
+                WriteBinaryScene( container, scene, NULL );
+                return;
+            }
+
+            const size_t base = container->Tell();
+            ai_assert( base % ASSBIN_ALIGNMENT == 0 );
+
+            std::vector<uint64_t> offsets( scene->mNumMeshes );
+            for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+                offsets[i] = container->Tell() - base;
+                WriteBinaryMeshBlock( container, scene->mMeshes[i] );
+                WritePadding( container );
+            }
+
+            const uint64_t sceneOffset = container->Tell() - base;
+            WriteBinaryScene( container, scene, &offsets );
+            Write<uint64_t>( container, sceneOffset );
+        }
+
+        // -----------------------------------------------------------------------------------
+        // Deflate frames in parallel and append them to the output in order
+        void WriteFrames( IOStream * out, TaskScheduler& scheduler, const std::vector<AssbinFrame>& frames,
+            std::vector<uint32_t>& table, uint64_t& compressedSize )
+        {
+            std::vector< std::vector<uint8_t> > deflated( frames.size() );
+            scheduler.ParallelFor( frames.size(), [&]( size_t i ) {
+                uLongf size = compressBound( static_cast<uLong>(frames[i].size) );
+                deflated[i].resize( size );
+                if (Z_OK != compress2( &deflated[i][0], &size, frames[i].data, static_cast<uLong>(frames[i].size), compressionLevel )) {
+                    throw DeadlyExportError("failed to deflate assbin data");
+                }
+                deflated[i].resize( size );
+            });
+
+            for (size_t i = 0; i < frames.size(); ++i) {
+                out->Write( &deflated[i][0], 1, deflated[i].size() );
+                table.push_back( static_cast<uint32_t>(frames[i].size) );
+                table.push_back( static_cast<uint32_t>(deflated[i].size()) );
+                compressedSize += deflated[i].size();
+                std::vector<uint8_t>().swap( deflated[i] );
+            }
+        }
+
+        // -----------------------------------------------------------------------------------
+        // Write the data of WriteBinaryData() as deflated frames. Mesh blocks are
+        // serialized in batches of one per thread, so only a few of them are kept
+        // in memory at a time.
+        void WriteCompressedData( IOStream * out, const aiScene* scene )
+        {
+            ai_assert( !shortened );
+
+            TaskScheduler scheduler( numThreads );
+            const size_t batchSize = scheduler.GetConcurrency();
+
+            std::vector<uint32_t> table;
+            std::vector<uint64_t> offsets( scene->mNumMeshes );
+            uint64_t size = 0, compressedSize = 0;
+
+            for (size_t first = 0; first < scene->mNumMeshes; first += batchSize) {
+                const size_t count = std::min<size_t>( batchSize, scene->mNumMeshes - first );
+
+                std::vector< std::unique_ptr<AssbinChunkWriter> > blocks( count );
+                scheduler.ParallelFor( count, [&]( size_t i ) {
+                    blocks[i].reset( new AssbinChunkWriter( NULL, 0 ) );
+                    WriteBinaryMeshBlock( blocks[i].get(), scene->mMeshes[first + i] );
+                    WritePadding( blocks[i].get() );
+                });
+
+                std::vector<AssbinFrame> frames;
+                for (size_t i = 0; i < count; ++i) {
+                    offsets[first + i] = size;
+                    size += blocks[i]->Tell();
+                    AddFrames( frames, static_cast<const uint8_t*>(blocks[i]->GetBufferPointer()), blocks[i]->Tell() );
+                }
+                WriteFrames( out, scheduler, frames, table, compressedSize );
+            }
+
+            // animations and textures start new frames
+            AssbinChunkWriter sceneData( NULL, 0 );
+            std::vector<size_t> starts( 1, 0 );
+            WriteBinaryScene( &sceneData, scene, &offsets, &starts );
+            Write<uint64_t>( &sceneData, size );
+            starts.push_back( sceneData.Tell() );
+
+            const uint8_t* data = static_cast<const uint8_t*>( sceneData.GetBufferPointer() );
+            std::vector<AssbinFrame> frames;
+            for (size_t i = 1; i < starts.size(); ++i) {
+                AddFrames( frames, data + starts[i-1], starts[i] - starts[i-1] );
+            }
+            WriteFrames( out, scheduler, frames, table, compressedSize );
+
+            Write<uint32_t>( out, static_cast<uint32_t>(table.size() / 2) );
+            out->Write( &table[0], sizeof(uint32_t), table.size() );
+            Write<uint64_t>( out, compressedSize );
+        }
+
     public:
-        AssbinExport()
-            : shortened(false), compressed(false) // temporary settings until properties are introduced for exporters
+        explicit AssbinExport(const ExportProperties* pProperties)
+            : shortened(false)
+            , compressed(pProperties->GetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, false))
+            , compressionLevel(pProperties->GetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_COMPRESSION_LEVEL, Z_BEST_COMPRESSION))
+            , numThreads(1)
         {
+            const int threads = pProperties->GetPropertyInteger(AI_CONFIG_EXPORT_ASSBIN_NUM_THREADS, 1);
+            numThreads = threads < 0 ? 1 : static_cast<unsigned int>(threads);
+            if (compressionLevel < Z_DEFAULT_COMPRESSION || compressionLevel > Z_BEST_COMPRESSION) {
+                compressionLevel = Z_DEFAULT_COMPRESSION;
+            }
         }
 
         // -----------------------------------------------------------------------------------
@@ -706,7 +1031,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
             out->Write( s, 44, 1 );
             // == 44 bytes
 
-            Write<unsigned int>( out, ASSBIN_VERSION_MAJOR );
+            Write<unsigned int>( out, shortened ? ASSBIN_VERSION_MAJOR_INLINE : ASSBIN_VERSION_MAJOR );
             Write<unsigned int>( out, ASSBIN_VERSION_MINOR );
             Write<unsigned int>( out, aiGetVersionRevision() );
             Write<unsigned int>( out, aiGetCompileFlags() );
@@ -732,25 +1057,17 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
             // Up to here the data is uncompressed. For compressed files, the rest
             // is compressed using standard DEFLATE from zlib.
-            if (compressed)
-            {
-                AssbinChunkWriter uncompressedStream( NULL, 0 );
-                WriteBinaryScene( &uncompressedStream, pScene );
-
-                uLongf uncompressedSize = static_cast<uLongf>(uncompressedStream.Tell());
-                uLongf compressedSize = (uLongf)(uncompressedStream.Tell() * 1.001 + 12.);
-                uint8_t* compressedBuffer = new uint8_t[ compressedSize ];
-
-                compress2( compressedBuffer, &compressedSize, (const Bytef*)uncompressedStream.GetBufferPointer(), uncompressedSize, 9 );
-
-                out->Write( &uncompressedSize, sizeof(uint32_t), 1 );
-                out->Write( compressedBuffer, sizeof(char), compressedSize );
-
-                delete[] compressedBuffer;
+            try {
+                if (compressed) {
+                    WriteCompressedData( out, pScene );
+                }
+                else {
+                    WriteBinaryData( out, pScene );
+                }
             }
-            else
-            {
-                WriteBinaryScene( out, pScene );
+            catch (...) {
+                pIOSystem->Close( out );
+                throw;
             }
 
             pIOSystem->Close( out );
@@ -759,7 +1076,8 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
 void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-    AssbinExport exporter;
+    ExportProperties emptyProperties;
+    AssbinExport exporter( pProperties ? pProperties : &emptyProperties );
     exporter.WriteBinaryDump( pFile, pIOSystem, pScene );
 }
 } // end of namespace Assimp
@@ -51,9 +51,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssbinLoader.h"
 #include "assbin_chunks.h"
 #include "MemoryIOWrapper.h"
+#include "MMapIOStream.h"
+#include "MaterialSystem.h"
+#include "ScenePrivate.h"
+#include "TaskScheduler.h"
 #include <assimp/mesh.h>
 #include <assimp/anim.h>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #   include <zlib.h>
@@ -81,6 +93,14 @@ const aiImporterDesc* AssbinImporter::GetInfo() const
     return &desc;
 }
 
+void AssbinImporter::SetupProperties(const Importer* pImp)
+{
+    configPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_POOL_FACE_INDICES, false);
+    configLazyMeshes = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES, false);
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_ASSBIN_NUM_THREADS, 1);
+    configNumThreads = numThreads < 0 ? 1 : static_cast<unsigned int>(numThreads);
+}
+
 bool AssbinImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool /*checkSig*/ ) const
 {
     IOStream * in = pIOHandler->Open(pFile);
@@ -140,7 +160,9 @@ aiString Read<aiString>(IOStream * stream)
 {
     aiString s;
     stream->Read(&s.length,4,1);
-    stream->Read(s.data,s.length,1);
+    if (s.length) {
+        stream->Read(s.data,s.length,1);
+    }
     s.data[s.length] = 0;
     return s;
 }
@@ -196,6 +218,359 @@ template <typename T> void ReadBounds( IOStream * stream, T* /*p*/, unsigned int
     stream->Seek( sizeof(T) * n, aiOrigin_CUR );
 }
 
+// The arrays of mesh blocks match the in-memory layout of the types they are
+// read into unless Assimp uses double precision. Only then they can be used
+// in place or copied at once.
+#ifndef ASSIMP_DOUBLE_PRECISION
+#   define ASSBIN_RAW_ARRAYS
+#endif
+
+namespace {
+
+// size of the elements of the arrays in mesh blocks
+template <typename T> struct BlockElementSize;
+template <> struct BlockElementSize<aiVector3D>     { static const size_t value = 12; };
+template <> struct BlockElementSize<aiColor4D>      { static const size_t value = 16; };
+template <> struct BlockElementSize<aiVertexWeight> { static const size_t value = 8; };
+template <> struct BlockElementSize<unsigned int>   { static const size_t value = 4; };
+
+// ------------------------------------------------------------------------------------------------
+// Bounds-checked cursor over the contents of a mesh block. Positions are
+// offsets into the data following the file header, like in the file.
+struct BlockReader
+{
+    const uint8_t* data; // contents of the block, found at offset begin
+    uint64_t begin, end, pos;
+
+    const uint8_t* Get(uint64_t size) {
+        if (size > end - pos) {
+            throw DeadlyImportError("ASSBIN: Mesh block is truncated");
+        }
+        const uint8_t* p = data + (pos - begin);
+        pos += size;
+        return p;
+    }
+
+    void Align() {
+        pos = std::min(end, (pos + ASSBIN_ALIGNMENT - 1) & ~static_cast<uint64_t>(ASSBIN_ALIGNMENT - 1));
+    }
+
+    template <typename T>
+    T ReadValue() {
+        T t;
+        ::memcpy(&t, Get(sizeof(T)), sizeof(T));
+        return t;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Returns an array of a mesh block, either in place or as a copy
+template <typename T>
+T* ReadBlockArray(BlockReader& in, aiScene* scene, unsigned int num, bool inPlace)
+{
+    in.Align();
+    const uint8_t* src = in.Get(static_cast<uint64_t>(num) * BlockElementSize<T>::value);
+#ifdef ASSBIN_RAW_ARRAYS
+    static_assert(sizeof(T) == BlockElementSize<T>::value, "unexpected element size");
+    if (inPlace && num) {
+        return reinterpret_cast<T*>(const_cast<uint8_t*>(src));
+    }
+    T* out = NewSceneArray<T>(scene, num);
+    ::memcpy(static_cast<void*>(out), src, num * sizeof(T));
+#else
+    (void)inPlace;
+    T* out = NewSceneArray<T>(scene, num);
+    MemoryIOStream io(src, num * BlockElementSize<T>::value);
+    ReadArray<T>(&io, out, num);
+#endif
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Inflates the frames of a compressed file with major version 2, which follow
+// the header at the current stream position
+std::shared_ptr<const void> InflateFrames(IOStream* stream, TaskScheduler* scheduler,
+    unsigned int numThreads, uint64_t& size)
+{
+    const size_t base = stream->Tell();
+    const uint64_t available = stream->FileSize() - base;
+    if (available < sizeof(uint32_t) + sizeof(uint64_t)) {
+        throw DeadlyImportError("ASSBIN: File is truncated");
+    }
+
+    // the frame table follows the frames, its offset is stored at the end
+    stream->Seek(base + static_cast<size_t>(available - sizeof(uint64_t)), aiOrigin_SET);
+    const uint64_t tableOffset = Read<uint64_t>(stream);
+    if (tableOffset > available - sizeof(uint32_t) - sizeof(uint64_t)) {
+        throw DeadlyImportError("ASSBIN: Invalid frame table offset");
+    }
+    stream->Seek(base + static_cast<size_t>(tableOffset), aiOrigin_SET);
+    const uint32_t numFrames = Read<uint32_t>(stream);
+    if (numFrames > (available - tableOffset - sizeof(uint32_t) - sizeof(uint64_t)) / 8) {
+        throw DeadlyImportError("ASSBIN: Frame table is truncated");
+    }
+    std::vector<uint32_t> table(numFrames * 2);
+    if (numFrames) {
+        stream->Read(&table[0], sizeof(uint32_t), table.size());
+    }
+
+    // offsets of the frames in the inflated and in the deflated data
+    std::vector<uint64_t> inflatedOfs(numFrames + 1), deflatedOfs(numFrames + 1);
+    for (uint32_t i = 0; i < numFrames; ++i) {
+        inflatedOfs[i + 1] = inflatedOfs[i] + table[i * 2];
+        deflatedOfs[i + 1] = deflatedOfs[i] + table[i * 2 + 1];
+    }
+    if (deflatedOfs[numFrames] != tableOffset) {
+        throw DeadlyImportError("ASSBIN: Frame table does not match the file size");
+    }
+    size = inflatedOfs[numFrames];
+    if (static_cast<size_t>(size) != size) {
+        throw DeadlyImportError("ASSBIN: File is too large to be inflated");
+    }
+
+    // memory mapped files are inflated in place
+    std::vector<uint8_t> deflated;
+    const uint8_t* src = static_cast<const uint8_t*>(stream->GetMappedData());
+    if (src) {
+        src += base;
+    }
+    else if (tableOffset) {
+        deflated.resize(static_cast<size_t>(tableOffset));
+        stream->Seek(base, aiOrigin_SET);
+        stream->Read(&deflated[0], 1, deflated.size());
+        src = &deflated[0];
+    }
+
+    uint8_t* data = new uint8_t[static_cast<size_t>(size) + 1];
+    std::shared_ptr<const void> inflated(data, std::default_delete<uint8_t[]>());
+
+    TaskScheduler::ParallelFor(scheduler, numFrames, [&](size_t i) {
+        uLongf len = table[i * 2];
+        if (Z_OK != uncompress(data + inflatedOfs[i], &len, src + deflatedOfs[i], table[i * 2 + 1]) ||
+            len != table[i * 2]) {
+            throw DeadlyImportError("ASSBIN: Failed to inflate the file");
+        }
+    }, numThreads);
+    return inflated;
+}
+
+} // ! namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Mesh table of a file with major version 2. Loads the mesh blocks of the
+ *  file into the meshes of the scene, and stays with the scene as its
+ *  SceneSource if meshes are loaded lazily. */
+class AssbinMeshTable : public SceneSource
+{
+public:
+    // data is the data following the header if it is in memory as a whole,
+    // otherwise mesh blocks are read from stream, at offset base
+    AssbinMeshTable(IOStream* stream, size_t base, uint64_t size, const uint8_t* data, bool poolFaceIndices)
+        : mStream(stream)
+        , mBase(base)
+        , mSize(size)
+        , mData(data)
+        , mInPlace(false)
+        , mPoolFaceIndices(poolFaceIndices)
+    {}
+
+    // Reads the mesh table chunk and creates the meshes of the scene
+    void ReadTable(IOStream* stream, aiScene* scene);
+
+    // Keeps the data alive after the file has been read, the meshes use
+    // it in place if inPlace is set and the scene has an arena
+    void Retain(const std::shared_ptr<const void>& owner, bool inPlace) {
+        ai_assert(mData);
+        mOwner = owner;
+        mInPlace = inPlace;
+        mStream = NULL;
+    }
+
+    void LoadMesh(aiScene* scene, unsigned int index);
+
+private:
+    void ReadMeshBlock(BlockReader& in, aiScene* scene, aiMesh* mesh, bool inPlace);
+
+    IOStream* mStream;
+    size_t mBase;
+    uint64_t mSize;
+    const uint8_t* mData;
+    std::shared_ptr<const void> mOwner;
+    bool mInPlace, mPoolFaceIndices;
+    std::vector<uint64_t> mOffsets;
+    std::vector<bool> mLoaded;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::mutex mMutex;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+void AssbinMeshTable::ReadTable(IOStream* stream, aiScene* scene)
+{
+    const uint32_t chunkID = Read<uint32_t>(stream);
+    /*uint32_t size =*/ Read<uint32_t>(stream);
+    if (chunkID != ASSBIN_CHUNK_AIMESHTABLE || Read<unsigned int>(stream) != scene->mNumMeshes) {
+        throw DeadlyImportError("ASSBIN: Mesh table is missing or invalid");
+    }
+
+    mOffsets.resize(scene->mNumMeshes);
+    mLoaded.assign(scene->mNumMeshes, false);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        mOffsets[i] = Read<uint64_t>(stream);
+
+        aiMesh* mesh = scene->mMeshes[i] = new aiMesh();
+        mesh->mPrimitiveTypes = Read<unsigned int>(stream);
+        mesh->mNumVertices = Read<unsigned int>(stream);
+        mesh->mNumFaces = Read<unsigned int>(stream);
+        mesh->mNumBones = Read<unsigned int>(stream);
+        mesh->mMaterialIndex = Read<unsigned int>(stream);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AssbinMeshTable::LoadMesh(aiScene* scene, unsigned int index)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif
+    if (index >= mLoaded.size() || mLoaded[index]) {
+        return;
+    }
+
+    const uint64_t offset = mOffsets[index];
+    uint32_t header[2] = {};
+    if (offset <= mSize && mSize - offset >= sizeof(header)) {
+        if (mData) {
+            ::memcpy(header, mData + offset, sizeof(header));
+        }
+        else {
+            mStream->Seek(mBase + static_cast<size_t>(offset), aiOrigin_SET);
+            mStream->Read(header, sizeof(header), 1);
+        }
+    }
+    if (header[0] != ASSBIN_CHUNK_AIMESHBLOCK || header[1] > mSize - offset - sizeof(header)) {
+        throw DeadlyImportError("ASSBIN: Invalid mesh block");
+    }
+
+    BlockReader in;
+    in.begin = in.pos = offset + sizeof(header);
+    in.end = in.begin + header[1];
+
+    // without the data in memory, each block is read into a buffer of its own
+    std::vector<uint8_t> buffer;
+    if (mData) {
+        in.data = mData + in.begin;
+    }
+    else {
+        buffer.resize(header[1]);
+        if (header[1] && mStream->Read(&buffer[0], header[1], 1) != 1) {
+            throw DeadlyImportError("ASSBIN: Mesh block is truncated");
+        }
+        in.data = buffer.data();
+    }
+
+    ReadMeshBlock(in, scene, scene->mMeshes[index], mInPlace && ScenePriv(scene)->mArena);
+    mLoaded[index] = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AssbinMeshTable::ReadMeshBlock(BlockReader& in, aiScene* scene, aiMesh* mesh, bool inPlace)
+{
+    const unsigned int c = in.ReadValue<uint32_t>();
+    const unsigned int numIndices = in.ReadValue<uint32_t>();
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS && (c & ASSBIN_MESH_HAS_TEXCOORD(n)); ++n) {
+        mesh->mNumUVComponents[n] = in.ReadValue<uint32_t>();
+    }
+
+    if (c & ASSBIN_MESH_HAS_POSITIONS) {
+        mesh->mVertices = ReadBlockArray<aiVector3D>(in, scene, mesh->mNumVertices, inPlace);
+    }
+    if (c & ASSBIN_MESH_HAS_NORMALS) {
+        mesh->mNormals = ReadBlockArray<aiVector3D>(in, scene, mesh->mNumVertices, inPlace);
+    }
+    if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS) {
+        mesh->mTangents = ReadBlockArray<aiVector3D>(in, scene, mesh->mNumVertices, inPlace);
+        mesh->mBitangents = ReadBlockArray<aiVector3D>(in, scene, mesh->mNumVertices, inPlace);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS && (c & ASSBIN_MESH_HAS_COLOR(n)); ++n) {
+        mesh->mColors[n] = ReadBlockArray<aiColor4D>(in, scene, mesh->mNumVertices, inPlace);
+    }
+    // the mapping is read-only, but the ScenePreprocessor clears unused
+    // components of texture coordinates, so these need a copy
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS && (c & ASSBIN_MESH_HAS_TEXCOORD(n)); ++n) {
+        mesh->mTextureCoords[n] = ReadBlockArray<aiVector3D>(in, scene, mesh->mNumVertices,
+            inPlace && 3 == mesh->mNumUVComponents[n]);
+    }
+
+    // The faces themselves always need to be allocated. Their indices stay
+    // in place, or go into one array if pooled or allocated from an arena.
+    in.Align();
+    const uint8_t* sizes = in.Get(static_cast<uint64_t>(mesh->mNumFaces) * sizeof(uint16_t));
+    unsigned int* pool = NULL;
+    const uint8_t* indices = NULL;
+    if (inPlace || mPoolFaceIndices || ScenePriv(scene)->mArena) {
+        pool = ReadBlockArray<unsigned int>(in, scene, numIndices, inPlace);
+    }
+    else {
+        in.Align();
+        indices = in.Get(static_cast<uint64_t>(numIndices) * sizeof(uint32_t));
+    }
+
+    mesh->mFaces = NewSceneArray<aiFace>(scene, mesh->mNumFaces);
+    unsigned int cur = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        aiFace& f = mesh->mFaces[i];
+
+        uint16_t num;
+        ::memcpy(&num, sizes + i * sizeof(uint16_t), sizeof(uint16_t));
+        if (num > numIndices - cur) {
+            throw DeadlyImportError("ASSBIN: Face indices are out of range");
+        }
+        f.mNumIndices = num;
+        if (!num) {
+            continue;
+        }
+
+        if (pool) {
+            f.mIndices = pool + cur;
+        }
+        else {
+            f.mIndices = new unsigned int[num];
+            ::memcpy(f.mIndices, indices + cur * sizeof(uint32_t), num * sizeof(uint32_t));
+        }
+        cur += num;
+    }
+    if (pool && mPoolFaceIndices && numIndices) {
+        mesh->mNumFaceIndices = numIndices;
+        mesh->mFaceIndices = pool;
+    }
+
+    if (mesh->mNumBones) {
+        mesh->mBones = new aiBone*[mesh->mNumBones]();
+        for (unsigned int a = 0; a < mesh->mNumBones; ++a) {
+            aiBone* b = mesh->mBones[a] = new aiBone();
+
+            const uint32_t length = in.ReadValue<uint32_t>();
+            if (length >= MAXLEN) {
+                throw DeadlyImportError("ASSBIN: Bone name is too long");
+            }
+            b->mName.length = length;
+            ::memcpy(b->mName.data, in.Get(length), length);
+            b->mName.data[length] = '\0';
+
+            b->mNumWeights = in.ReadValue<uint32_t>();
+            MemoryIOStream io(in.Get(64), 64);
+            b->mOffsetMatrix = Read<aiMatrix4x4>(&io);
+            b->mWeights = ReadBlockArray<aiVertexWeight>(in, scene, b->mNumWeights, inPlace);
+        }
+    }
+}
+
+} // ! namespace Assimp
+
 void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node )
 {
     uint32_t chunkID = Read<uint32_t>(stream);
@@ -222,6 +597,7 @@ void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node )
         (*node)->mChildren = new aiNode*[(*node)->mNumChildren];
         for (unsigned int i = 0; i < (*node)->mNumChildren; ++i) {
             ReadBinaryNode( stream, &(*node)->mChildren[i] );
+            (*node)->mChildren[i]->mParent = *node;
         }
     }
 
@@ -246,7 +622,7 @@ void AssbinImporter::ReadBinaryBone( IOStream * stream, aiBone* b )
     } // else write as usual
     else
     {
-        b->mWeights = new aiVertexWeight[b->mNumWeights];
+        b->mWeights = NewSceneArray<aiVertexWeight>(mScene,b->mNumWeights);
         ReadArray<aiVertexWeight>(stream,b->mWeights,b->mNumWeights);
     }
 }
@@ -274,7 +650,7 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         } // else write as usual
         else
         {
-            mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+            mesh->mVertices = NewSceneArray<aiVector3D>(mScene,mesh->mNumVertices);
             ReadArray<aiVector3D>(stream,mesh->mVertices,mesh->mNumVertices);
         }
     }
@@ -285,7 +661,7 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         } // else write as usual
         else
         {
-            mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+            mesh->mNormals = NewSceneArray<aiVector3D>(mScene,mesh->mNumVertices);
             ReadArray<aiVector3D>(stream,mesh->mNormals,mesh->mNumVertices);
         }
     }
@@ -297,9 +673,9 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         } // else write as usual
         else
         {
-            mesh->mTangents = new aiVector3D[mesh->mNumVertices];
+            mesh->mTangents = NewSceneArray<aiVector3D>(mScene,mesh->mNumVertices);
             ReadArray<aiVector3D>(stream,mesh->mTangents,mesh->mNumVertices);
-            mesh->mBitangents = new aiVector3D[mesh->mNumVertices];
+            mesh->mBitangents = NewSceneArray<aiVector3D>(mScene,mesh->mNumVertices);
             ReadArray<aiVector3D>(stream,mesh->mBitangents,mesh->mNumVertices);
         }
     }
@@ -314,7 +690,7 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         } // else write as usual
         else
         {
-            mesh->mColors[n] = new aiColor4D[mesh->mNumVertices];
+            mesh->mColors[n] = NewSceneArray<aiColor4D>(mScene,mesh->mNumVertices);
             ReadArray<aiColor4D>(stream,mesh->mColors[n],mesh->mNumVertices);
         }
     }
@@ -331,7 +707,7 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
         } // else write as usual
         else
         {
-            mesh->mTextureCoords[n] = new aiVector3D[mesh->mNumVertices];
+            mesh->mTextureCoords[n] = NewSceneArray<aiVector3D>(mScene,mesh->mNumVertices);
             ReadArray<aiVector3D>(stream,mesh->mTextureCoords[n],mesh->mNumVertices);
         }
     }
@@ -346,22 +722,57 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
     else // else write as usual
     {
         // if there are less than 2^16 vertices, we can simply use 16 bit integers ...
-        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        mesh->mFaces = NewSceneArray<aiFace>(mScene,mesh->mNumFaces);
+
+        // the face sizes are stored inline, so pooled indices are collected
+        // first and handed over to the faces once the pool is complete.
+        // With an arena, all indices go into one block of it in any case.
+        SceneArena* arena = ScenePriv(mScene)->mArena;
+        const bool collect = configPoolFaceIndices || arena;
+        std::vector<unsigned int> pool;
+        if (collect) {
+            pool.reserve(mesh->mNumFaces * 3);
+        }
         for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
             aiFace& f = mesh->mFaces[i];
 
             static_assert(AI_MAX_FACE_INDICES <= 0xffff, "AI_MAX_FACE_INDICES <= 0xffff");
             f.mNumIndices = Read<uint16_t>(stream);
-            f.mIndices = new unsigned int[f.mNumIndices];
+
+            unsigned int* out;
+            if (collect) {
+                pool.resize(pool.size() + f.mNumIndices);
+                out = pool.data() + pool.size() - f.mNumIndices;
+            }
+            else {
+                out = f.mIndices = new unsigned int[f.mNumIndices];
+            }
 
             for (unsigned int a = 0; a < f.mNumIndices;++a) {
                 if (mesh->mNumVertices < (1u<<16))
                 {
-                    f.mIndices[a] = Read<uint16_t>(stream);
+                    out[a] = Read<uint16_t>(stream);
                 }
                 else
                 {
-                    f.mIndices[a] = Read<unsigned int>(stream);
+                    out[a] = Read<unsigned int>(stream);
+                }
+            }
+        }
+
+        if (collect && !pool.empty()) {
+            unsigned int* cur = arena ? arena->AllocateArray<unsigned int>(pool.size()) : new unsigned int[pool.size()];
+            ::memcpy(cur, pool.data(), pool.size() * sizeof(unsigned int));
+            if (configPoolFaceIndices) {
+                mesh->mNumFaceIndices = static_cast<unsigned int>(pool.size());
+                mesh->mFaceIndices = cur;
+            }
+
+            for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+                aiFace& f = mesh->mFaces[i];
+                if (f.mNumIndices) {
+                    f.mIndices = cur;
+                    cur += f.mNumIndices;
                 }
             }
         }
@@ -412,6 +823,7 @@ void AssbinImporter::ReadBinaryMaterial(IOStream * stream, aiMaterial* mat)
             mat->mProperties[i] = new aiMaterialProperty();
             ReadBinaryMaterialProperty( stream, mat->mProperties[i]);
         }
+        UpdateMaterialIndex(mat);
     }
 }
 
@@ -435,7 +847,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
 
         } // else write as usual
         else {
-            nd->mPositionKeys = new aiVectorKey[nd->mNumPositionKeys];
+            nd->mPositionKeys = NewSceneArray<aiVectorKey>(mScene,nd->mNumPositionKeys);
             ReadArray<aiVectorKey>(stream,nd->mPositionKeys,nd->mNumPositionKeys);
         }
     }
@@ -446,7 +858,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
         } // else write as usual
         else
         {
-            nd->mRotationKeys = new aiQuatKey[nd->mNumRotationKeys];
+            nd->mRotationKeys = NewSceneArray<aiQuatKey>(mScene,nd->mNumRotationKeys);
             ReadArray<aiQuatKey>(stream,nd->mRotationKeys,nd->mNumRotationKeys);
         }
     }
@@ -457,7 +869,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
         } // else write as usual
         else
         {
-            nd->mScalingKeys = new aiVectorKey[nd->mNumScalingKeys];
+            nd->mScalingKeys = NewSceneArray<aiVectorKey>(mScene,nd->mNumScalingKeys);
             ReadArray<aiVectorKey>(stream,nd->mScalingKeys,nd->mNumScalingKeys);
         }
     }
@@ -555,6 +967,7 @@ void AssbinImporter::ReadBinaryCamera( IOStream * stream, aiCamera* cam )
 
 void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 {
+    mScene = scene;
     uint32_t chunkID = Read<uint32_t>(stream);
     ai_assert(chunkID == ASSBIN_CHUNK_AISCENE);
     /*uint32_t size =*/ Read<uint32_t>(stream);
@@ -571,15 +984,20 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
     scene->mRootNode = new aiNode[1];
     ReadBinaryNode( stream, &scene->mRootNode );
 
-    // Read all meshes
+    // Read all meshes, or just the table of the mesh blocks
     if (scene->mNumMeshes)
     {
-        scene->mMeshes = new aiMesh*[scene->mNumMeshes];
-        for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
-            scene->mMeshes[i] = new aiMesh();
-            ReadBinaryMesh( stream,scene->mMeshes[i]);
+        scene->mMeshes = new aiMesh*[scene->mNumMeshes]();
+        if (!mMeshTable) {
+            for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+                scene->mMeshes[i] = new aiMesh();
+                ReadBinaryMesh( stream,scene->mMeshes[i]);
+            }
         }
     }
+    if (mMeshTable) {
+        mMeshTable->ReadTable( stream, scene );
+    }
 
     // Read materials
     if (scene->mNumMaterials)
@@ -639,9 +1057,30 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     if (!stream)
         return;
 
+    // set once the stream is kept alive for the scene instead of being closed
+    bool streamRetained = false;
+    try {
+        InternReadStream( stream, pScene, streamRetained );
+    }
+    catch (...) {
+        if (!streamRetained) {
+            pIOHandler->Close(stream);
+        }
+        throw;
+    }
+
+    if (!streamRetained) {
+        pIOHandler->Close(stream);
+    }
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::InternReadStream( IOStream * stream, aiScene* pScene, bool& streamRetained )
+{
+    mMeshTable = NULL;
     stream->Seek( 44, aiOrigin_CUR ); // signature
 
-    /*unsigned int versionMajor =*/ Read<unsigned int>(stream);
+    const unsigned int versionMajor = Read<unsigned int>(stream);
     /*unsigned int versionMinor =*/ Read<unsigned int>(stream);
     /*unsigned int versionRevision =*/ Read<unsigned int>(stream);
     /*unsigned int compileFlags =*/ Read<unsigned int>(stream);
@@ -651,36 +1090,124 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 
     if (shortened)
         throw DeadlyImportError( "Shortened binaries are not supported!" );
+    if (versionMajor > ASSBIN_VERSION_MAJOR || stream->FileSize() < ASSBIN_HEADER_LENGTH)
+        throw DeadlyImportError( "ASSBIN: Unsupported format version or truncated file" );
 
     stream->Seek( 256, aiOrigin_CUR ); // original filename
     stream->Seek( 128, aiOrigin_CUR ); // options
     stream->Seek( 64, aiOrigin_CUR ); // padding
 
-    if (compressed)
+    // the data following the header, if it is in memory as a whole
+    const uint8_t* data = NULL;
+    uint64_t dataSize = 0;
+    size_t base = ASSBIN_HEADER_LENGTH;
+    IOStream* in = stream;
+    std::shared_ptr<const void> inflated;
+    std::unique_ptr<MemoryIOStream> io;
+
+    if (compressed && versionMajor > ASSBIN_VERSION_MAJOR_INLINE)
+    {
+        inflated = InflateFrames( stream, m_scheduler, configNumThreads, dataSize );
+        data = static_cast<const uint8_t*>( inflated.get() );
+        base = 0;
+        io.reset( new MemoryIOStream( data, static_cast<size_t>(dataSize) ) );
+        in = io.get();
+    }
+    else if (compressed)
     {
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
-        unsigned char * compressedData = new unsigned char[ compressedSize ];
-        stream->Read( compressedData, 1, compressedSize );
+        // memory mapped files are decompressed in place
+        unsigned char * compressedData = NULL;
+        const unsigned char * compressedSrc = static_cast<const unsigned char*>( stream->GetMappedData() );
+        if ( compressedSrc ) {
+            compressedSrc += stream->Tell();
+        } else {
+            compressedData = new unsigned char[ compressedSize ];
+            stream->Read( compressedData, 1, compressedSize );
+            compressedSrc = compressedData;
+        }
 
         unsigned char * uncompressedData = new unsigned char[ uncompressedSize ];
+        inflated.reset( uncompressedData, std::default_delete<unsigned char[]>() );
 
-        uncompress( uncompressedData, &uncompressedSize, compressedData, compressedSize );
+        uncompress( uncompressedData, &uncompressedSize, compressedSrc, compressedSize );
+        delete[] compressedData;
 
-        MemoryIOStream io( uncompressedData, uncompressedSize );
+        data = uncompressedData;
+        dataSize = uncompressedSize;
+        base = 0;
+        io.reset( new MemoryIOStream( uncompressedData, uncompressedSize ) );
+        in = io.get();
+    }
+    else
+    {
+        data = static_cast<const uint8_t*>( stream->GetMappedData() );
+        if ( data ) {
+            data += ASSBIN_HEADER_LENGTH;
+        }
+        dataSize = stream->FileSize() - ASSBIN_HEADER_LENGTH;
+    }
 
-        ReadBinaryScene(&io,pScene);
+    if (versionMajor <= ASSBIN_VERSION_MAJOR_INLINE)
+    {
+        ReadBinaryScene(in,pScene);
+        return;
+    }
 
-        delete[] uncompressedData;
-        delete[] compressedData;
+    // the scene chunk follows the mesh blocks, its offset is stored at the end
+    if (dataSize < sizeof(uint64_t)) {
+        throw DeadlyImportError( "ASSBIN: File is truncated" );
     }
-    else
+    in->Seek( base + static_cast<size_t>(dataSize - sizeof(uint64_t)), aiOrigin_SET );
+    const uint64_t sceneOffset = Read<uint64_t>(in);
+    if (sceneOffset >= dataSize) {
+        throw DeadlyImportError( "ASSBIN: Invalid scene offset" );
+    }
+    in->Seek( base + static_cast<size_t>(sceneOffset), aiOrigin_SET );
+
+    std::unique_ptr<AssbinMeshTable> table( new AssbinMeshTable( in, base, dataSize, data, configPoolFaceIndices ) );
+    mMeshTable = table.get();
+    try {
+        ReadBinaryScene(in,pScene);
+    }
+    catch (...) {
+        mMeshTable = NULL;
+        throw;
+    }
+    mMeshTable = NULL;
+
+    // The inflated data and the mapping of a file can be kept for the scene,
+    // which allows for using the mesh arrays in place as arena memory and for
+    // loading meshes lazily. Mapped streams are only created by the default
+    // IO system, whose Close() just deletes them.
+    SceneArena* arena = ScenePriv(pScene)->mArena;
+    const bool retainable = inflated || ( data && dynamic_cast<MMapIOStream*>(stream) );
+    const bool inPlace = retainable && arena && !( reinterpret_cast<uintptr_t>(data) % ASSBIN_ALIGNMENT );
+    const bool lazy = retainable && configLazyMeshes;
+    if (inPlace || lazy)
     {
-        ReadBinaryScene(stream,pScene);
+        std::shared_ptr<const void> owner = inflated;
+        if (!owner) {
+            owner.reset( stream );
+            streamRetained = true;
+        }
+        if (inPlace) {
+            arena->AddExternalMemory( data, static_cast<size_t>(dataSize), owner );
+        }
+        table->Retain( owner, inPlace );
     }
 
-    pIOHandler->Close(stream);
+    // the preprocessor needs the faces of meshes without primitive types
+    for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+        if (!lazy || !pScene->mMeshes[i]->mPrimitiveTypes) {
+            table->LoadMesh( pScene, i );
+        }
+    }
+    if (lazy) {
+        ScenePriv(pScene)->mSource = table.release();
+    }
 }
 
 #endif // !! ASSIMP_BUILD_NO_ASSBIN_IMPORTER
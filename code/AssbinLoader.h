@@ -63,6 +63,8 @@ struct aiCamera;
 
 namespace Assimp    {
 
+class AssbinMeshTable;
+
 // ---------------------------------------------------------------------------------
 /** Importer class for 3D Studio r3 and r4 3DS files
  */
@@ -71,6 +73,11 @@ class AssbinImporter : public BaseImporter
 private:
   bool shortened;
   bool compressed;
+  bool configPoolFaceIndices;
+  bool configLazyMeshes;
+  unsigned int configNumThreads;
+  aiScene* mScene;
+  AssbinMeshTable* mMeshTable;
 protected:
 
 public:
@@ -80,11 +87,13 @@ public:
     bool checkSig
     ) const;
   virtual const aiImporterDesc* GetInfo() const;
+  virtual void SetupProperties(const Importer* pImp);
   virtual void InternReadFile(
     const std::string& pFile,
     aiScene* pScene,
     IOSystem* pIOHandler
     );
+  void InternReadStream( IOStream * stream, aiScene* pScene, bool& streamRetained );
   void ReadBinaryScene( IOStream * stream, aiScene* pScene );
   void ReadBinaryNode( IOStream * stream, aiNode** mRootNode );
   void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
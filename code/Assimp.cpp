@@ -102,8 +102,9 @@ namespace Assimp
 
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
-/** Global mutex to manage the access to the log-stream map */
-static std::mutex gLogStreamMutex;
+/** Global mutex to manage the access to the log-stream map. Recursive, as
+ *  detaching a stream destroys it, which enters the mutex again. */
+static std::recursive_mutex gLogStreamMutex;
 #endif
 
 
@@ -119,7 +120,7 @@ public:
 
     ~LogToCallbackRedirector()  {
 #ifndef ASSIMP_BUILD_SINGLETHREADED
-        std::lock_guard<std::mutex> lock(gLogStreamMutex);
+        std::lock_guard<std::recursive_mutex> lock(gLogStreamMutex);
 #endif
         // (HACK) Check whether the 'stream.user' pointer points to a
         // custom LogStream allocated by #aiGetPredefinedLogStream.
@@ -383,7 +384,7 @@ ASSIMP_API void aiAttachLogStream( const aiLogStream* stream )
     ASSIMP_BEGIN_EXCEPTION_REGION();
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
-    std::lock_guard<std::mutex> lock(gLogStreamMutex);
+    std::lock_guard<std::recursive_mutex> lock(gLogStreamMutex);
 #endif
 
     LogStream* lg = new LogToCallbackRedirector(*stream);
@@ -402,7 +403,7 @@ ASSIMP_API aiReturn aiDetachLogStream( const aiLogStream* stream)
     ASSIMP_BEGIN_EXCEPTION_REGION();
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
-    std::lock_guard<std::mutex> lock(gLogStreamMutex);
+    std::lock_guard<std::recursive_mutex> lock(gLogStreamMutex);
 #endif
     // find the log-stream associated with this data
     LogStreamMap::iterator it = gActiveLogStreams.find( *stream);
@@ -427,7 +428,7 @@ ASSIMP_API void aiDetachAllLogStreams(void)
 {
     ASSIMP_BEGIN_EXCEPTION_REGION();
 #ifndef ASSIMP_BUILD_SINGLETHREADED
-    std::lock_guard<std::mutex> lock(gLogStreamMutex);
+    std::lock_guard<std::recursive_mutex> lock(gLogStreamMutex);
 #endif
     Logger *logger( DefaultLogger::get() );
     if ( NULL == logger ) {
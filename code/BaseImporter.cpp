@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileSystemFilter.h"
 #include "Importer.h"
 #include "ByteSwapper.h"
+#include "TaskScheduler.h"
+#include "ScenePrivate.h"
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -56,12 +58,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <cctype>
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter()
 : m_progress()
+, m_scheduler()
 {
     // nothing to do here
 }
@@ -79,6 +86,7 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
 {
     m_progress = pImp->GetProgressHandler();
     ai_assert(m_progress);
+    m_scheduler = pImp->Pimpl()->mScheduler;
 
     // Gather configuration properties for this run
     SetupProperties( pImp );
@@ -89,6 +97,11 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
     // create a scene object to hold the data
     ScopeGuard<aiScene> sc(new aiScene());
 
+    // let the importer allocate large arrays from an arena, if requested
+    if (pImp->GetPropertyBool(AI_CONFIG_GLOB_SCENE_ARENA, false)) {
+        ScenePriv(sc)->mArena = new SceneArena();
+    }
+
     // dispatch importing
     try
     {
@@ -495,25 +508,24 @@ namespace Assimp {
 struct Assimp::BatchData {
     BatchData( IOSystem* pIO, bool validate )
     : pIOSystem( pIO )
-    , pImporter( nullptr )
     , next_id(0xffff)
-    , validate( validate ) {
+    , validate( validate )
+    , numThreads( 1 )
+    , scheduler( NULL ) {
         ai_assert( NULL != pIO );
-        
-        pImporter = new Importer();
-        pImporter->SetIOHandler( pIO );
     }
 
-    ~BatchData() {
-        pImporter->SetIOHandler( NULL ); /* get pointer back into our possession */
-        delete pImporter;
-    }
+    // Imports a single request using its own importer instance, which
+    // runs its parallel work on the given scheduler
+    void Load( LoadRequest& req, TaskScheduler* parent );
 
     // IO system to be used for all imports
     IOSystem* pIOSystem;
 
-    // Importer used to load all meshes
-    Importer* pImporter;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // Serializes all calls into pIOSystem
+    std::mutex ioMutex;
+#endif
 
     // List of all imports
     std::list<LoadRequest> requests;
@@ -526,7 +538,99 @@ struct Assimp::BatchData {
 
     // Validation enabled state
     bool validate;
+
+    // Number of worker threads, 0 picks all threads of the scheduler
+    unsigned int numThreads;
+
+    // Scheduler of the importer which uses the batch loader, may be NULL
+    TaskScheduler* scheduler;
+};
+
+namespace Assimp {
+// ------------------------------------------------------------------------------------------------
+// IOSystem view handed to every single import of a batch. Each view owns its
+// directory stack, all file system calls are forwarded to the IOSystem of the
+// BatchLoader. These calls are serialized as the wrapped IOSystem is supplied
+// by the caller and is not required to be thread-safe.
+class BatchIOSystem : public IOSystem
+{
+public:
+    explicit BatchIOSystem( BatchData* data )
+    : m_data( data ) {
+        ai_assert( NULL != data );
+    }
+
+    bool Exists( const char* pFile ) const {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock( m_data->ioMutex );
+#endif
+        return m_data->pIOSystem->Exists( pFile );
+    }
+
+    char getOsSeparator() const {
+        return m_data->pIOSystem->getOsSeparator();
+    }
+
+    IOStream* Open( const char* pFile, const char* pMode = "rb" ) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock( m_data->ioMutex );
+#endif
+        return m_data->pIOSystem->Open( pFile, pMode );
+    }
+
+    void Close( IOStream* pFile ) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock( m_data->ioMutex );
+#endif
+        m_data->pIOSystem->Close( pFile );
+    }
+
+    bool ComparePaths( const char* one, const char* second ) const {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock( m_data->ioMutex );
+#endif
+        return m_data->pIOSystem->ComparePaths( one, second );
+    }
+
+private:
+    BatchData* m_data;
 };
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchData::Load( LoadRequest& req, TaskScheduler* parent )
+{
+    // force validation in debug builds
+    unsigned int pp = req.flags;
+    if ( validate ) {
+        pp |= aiProcess_ValidateDataStructure;
+    }
+
+    BatchIOSystem io( this );
+    Importer importer;
+    importer.SetIOHandler( &io );
+    importer.SetTaskExecutor( parent );
+
+    // setup config properties if necessary
+    ImporterPimpl* pimpl = importer.Pimpl();
+    pimpl->mFloatProperties  = req.map.floats;
+    pimpl->mIntProperties    = req.map.ints;
+    pimpl->mStringProperties = req.map.strings;
+    pimpl->mMatrixProperties = req.map.matrices;
+
+    if (!DefaultLogger::isNullLogger())
+    {
+        DefaultLogger::get()->info("%%% BEGIN EXTERNAL FILE %%%");
+        DefaultLogger::get()->info("File: " + req.file);
+    }
+    importer.ReadFile(req.file,pp);
+    req.scene = importer.GetOrphanedScene();
+    req.loaded = true;
+
+    DefaultLogger::get()->info("%%% END EXTERNAL FILE %%%");
+
+    importer.SetIOHandler( NULL ); /* get pointer back into our possession */
+}
 
 typedef std::list<LoadRequest>::iterator LoadReqIt;
 
@@ -558,6 +662,16 @@ bool BatchLoader::getValidation() const {
     return m_data->validate;
 }
 
+// ------------------------------------------------------------------------------------------------
+void BatchLoader::setNumThreads( unsigned int numThreads ) {
+    m_data->numThreads = numThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BatchLoader::getNumThreads() const {
+    return m_data->numThreads;
+}
+
 // ------------------------------------------------------------------------------------------------
 unsigned int BatchLoader::AddLoadRequest(const std::string& file,
     unsigned int steps /*= 0*/, const PropertyMap* map /*= NULL*/)
@@ -605,30 +719,36 @@ aiScene* BatchLoader::GetImport( unsigned int which )
 // ------------------------------------------------------------------------------------------------
 void BatchLoader::LoadAll()
 {
-    // no threaded implementation for the moment
+    // collect all requests which have not been loaded so far. Results are stored
+    // in their request, so the order of completion doesn't matter.
+    std::vector<LoadRequest*> pending;
     for ( LoadReqIt it = m_data->requests.begin();it != m_data->requests.end(); ++it) {
-        // force validation in debug builds
-        unsigned int pp = (*it).flags;
-        if ( m_data->validate ) {
-            pp |= aiProcess_ValidateDataStructure;
+        if ( !(*it).loaded ) {
+            pending.push_back( &(*it) );
         }
+    }
 
-        // setup config properties if necessary
-        ImporterPimpl* pimpl = m_data->pImporter->Pimpl();
-        pimpl->mFloatProperties  = (*it).map.floats;
-        pimpl->mIntProperties    = (*it).map.ints;
-        pimpl->mStringProperties = (*it).map.strings;
-        pimpl->mMatrixProperties = (*it).map.matrices;
-
-        if (!DefaultLogger::isNullLogger())
-        {
-            DefaultLogger::get()->info("%%% BEGIN EXTERNAL FILE %%%");
-            DefaultLogger::get()->info("File: " + (*it).file);
-        }
-        m_data->pImporter->ReadFile((*it).file,pp);
-        (*it).scene = m_data->pImporter->GetOrphanedScene();
-        (*it).loaded = true;
-
-        DefaultLogger::get()->info("%%% END EXTERNAL FILE %%%");
+    // without a scheduler of the calling importer, bring up one for this batch
+    std::unique_ptr<TaskScheduler> own;
+    TaskScheduler* scheduler = m_data->scheduler;
+    if ( NULL == scheduler && 1 != m_data->numThreads && pending.size() > 1 ) {
+        own.reset( new TaskScheduler( m_data->numThreads ) );
+        scheduler = own.get();
     }
+
+    // the nested imports share the scheduler's threads as well
+    BatchData* data = m_data;
+    TaskScheduler::ParallelFor( scheduler, pending.size(), [ &pending, data, scheduler ]( size_t i ) {
+        data->Load( *pending[ i ], scheduler );
+    }, m_data->numThreads );
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchLoader::setTaskScheduler( TaskScheduler* scheduler ) {
+    m_data->scheduler = scheduler;
+}
+
+// ------------------------------------------------------------------------------------------------
+TaskScheduler* BatchLoader::getTaskScheduler() const {
+    return m_data->scheduler;
 }
@@ -60,6 +60,7 @@ class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
+class TaskScheduler;
 
 
 // utility to do char4 to uint32 in a portable manner
@@ -392,6 +393,8 @@ protected:
     std::string m_ErrorText;
     /// Currently set progress handler.
     ProgressHandler* m_progress;
+    /// Task scheduler of the importer, may be NULL.
+    TaskScheduler* m_scheduler;
 };
 
 
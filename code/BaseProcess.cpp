@@ -46,6 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include "Importer.h"
+#include "TaskScheduler.h"
+#include <assimp/config.h>
+#include <algorithm>
 
 using namespace Assimp;
 
@@ -54,6 +57,8 @@ using namespace Assimp;
 BaseProcess::BaseProcess()
 : shared()
 , progress()
+, numThreads( 1 )
+, scheduler()
 {
 }
 
@@ -71,6 +76,13 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 
     progress = pImp->GetProgressHandler();
     ai_assert(progress);
+    scheduler = pImp->Pimpl()->mScheduler;
+
+    // per-mesh parallel execution is opt-in
+    numThreads = 1;
+    if ( pImp->GetPropertyBool( AI_CONFIG_PP_PARALLEL_MESHES, false ) ) {
+        numThreads = std::max( pImp->GetPropertyInteger( AI_CONFIG_PP_PARALLEL_NUM_THREADS, 0 ), 0 );
+    }
 
     SetupProperties( pImp );
 
@@ -103,3 +115,11 @@ bool BaseProcess::RequireVerboseFormat() const
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecutePerMesh(unsigned int numMeshes,
+    const std::function<void (unsigned int)>& fn) const
+{
+    TaskScheduler::ParallelFor( scheduler, numMeshes, [ &fn ]( size_t i ) {
+        fn( static_cast<unsigned int>( i ) );
+    }, numThreads );
+}
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_BASEPROCESS_H
 
 #include <map>
+#include <functional>
 
 #include <assimp/types.h>
 #include "GenericProperty.h"
@@ -52,6 +53,7 @@ struct aiScene;
 namespace Assimp    {
 
 class Importer;
+class TaskScheduler;
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -279,6 +281,55 @@ public:
         return shared;
     }
 
+    // -------------------------------------------------------------------
+    /** Set the number of threads to be used by ExecutePerMesh().
+     *  ExecuteOnScene() sets it from #AI_CONFIG_PP_PARALLEL_MESHES
+     *  and #AI_CONFIG_PP_PARALLEL_NUM_THREADS.
+     * @param num 1 to process all meshes on the calling thread (the
+     *   default), 0 for all threads of the task scheduler.
+    */
+    inline void SetNumThreads(unsigned int num)    {
+        numThreads = num;
+    }
+
+    // -------------------------------------------------------------------
+    /** Get the number of threads to be used by ExecutePerMesh().
+    */
+    inline unsigned int GetNumThreads() const   {
+        return numThreads;
+    }
+
+    // -------------------------------------------------------------------
+    /** Assign the task scheduler ExecutePerMesh() runs on.
+     *  ExecuteOnScene() sets it to the scheduler of the importer.
+     * @param sc May be NULL, ExecutePerMesh() starts threads of its
+     *   own then.
+    */
+    inline void SetTaskScheduler(TaskScheduler* sc)    {
+        scheduler = sc;
+    }
+
+    // -------------------------------------------------------------------
+    /** Get the task scheduler that is assigned to the step.
+    */
+    inline TaskScheduler* GetTaskScheduler() const   {
+        return scheduler;
+    }
+
+protected:
+
+    // -------------------------------------------------------------------
+    /** Calls the given function once for each mesh index in [0,numMeshes).
+     * The calls are distributed over several threads if parallel mesh
+     * processing is enabled, so the function may only touch data which
+     * belongs to the given mesh. The first exception thrown by the
+     * function is rethrown on the calling thread.
+     * @param numMeshes Number of meshes to process
+     * @param fn Function to be called for each mesh index
+    */
+    void ExecutePerMesh(unsigned int numMeshes,
+        const std::function<void (unsigned int)>& fn) const;
+
 protected:
 
     /** See the doc of #SharedPostProcessInfo for more details */
@@ -286,6 +337,12 @@ protected:
 
     /** Currently active progress handler */
     ProgressHandler* progress;
+
+    /** Number of threads for ExecutePerMesh(), 0 for all threads of the scheduler */
+    unsigned int numThreads;
+
+    /** Task scheduler of the importer, may be NULL */
+    TaskScheduler* scheduler;
 };
 
 
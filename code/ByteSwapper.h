@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/types.h>
 #include <stdint.h>
+#include <string.h>
 
 #if _MSC_VER >= 1400
 #include <stdlib.h>
@@ -164,6 +165,51 @@ public:
         Swap8(fOut);
     }
 
+    // ----------------------------------------------------------------------
+    /** Swap an array of two, four or eight byte values in place. The
+     *  loops are kept free of branches so compilers can vectorize them.
+     *  @param[inout] _szOut Start of the array, needs no alignment
+     *  @param size Size of a single value in bytes
+     *  @param num Number of values in the array */
+    static inline void SwapArray(void* _szOut, size_t size, size_t num)
+    {
+        ai_assert(_szOut || !num);
+
+        uint8_t* const szOut = reinterpret_cast<uint8_t*>(_szOut);
+        switch (size)
+        {
+        case 2:
+            for (size_t i = 0; i < num; ++i) {
+                uint16_t v;
+                ::memcpy(&v, szOut + i * 2, 2);
+                v = static_cast<uint16_t>((v >> 8) | (v << 8));
+                ::memcpy(szOut + i * 2, &v, 2);
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < num; ++i) {
+                uint32_t v;
+                ::memcpy(&v, szOut + i * 4, 4);
+                v = (v >> 24) | ((v >> 8) & 0xff00u) | ((v << 8) & 0xff0000u) | (v << 24);
+                ::memcpy(szOut + i * 4, &v, 4);
+            }
+            break;
+        case 8:
+            for (size_t i = 0; i < num; ++i) {
+                uint32_t lo, hi;
+                ::memcpy(&lo, szOut + i * 8, 4);
+                ::memcpy(&hi, szOut + i * 8 + 4, 4);
+                lo = (lo >> 24) | ((lo >> 8) & 0xff00u) | ((lo << 8) & 0xff0000u) | (lo << 24);
+                hi = (hi >> 24) | ((hi >> 8) & 0xff00u) | ((hi << 8) & 0xff0000u) | (hi << 24);
+                ::memcpy(szOut + i * 8, &hi, 4);
+                ::memcpy(szOut + i * 8 + 4, &lo, 4);
+            }
+            break;
+        default:
+            ai_assert(1 == size);
+        }
+    }
+
     // ----------------------------------------------------------------------
     //! Templatized ByteSwap
     //! \returns param tOut as swapped
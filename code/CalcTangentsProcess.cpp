@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "TinyFormatter.h"
 #include "qnan.h"
+#include <algorithm>
 
 using namespace Assimp;
 
@@ -95,10 +96,13 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 
     DefaultLogger::get()->debug("CalcTangentsProcess begin");
 
-    bool bHas = false;
-    for ( unsigned int a = 0; a < pScene->mNumMeshes; a++ ) {
-        if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
-    }
+    // not std::vector<bool>, the meshes may be processed concurrently
+    std::vector<unsigned char> abHas( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene->mNumMeshes, [ this, pScene, &abHas ]( unsigned int a ) {
+        abHas[ a ] = ProcessMesh( pScene->mMeshes[ a ], a );
+    } );
+
+    const bool bHas = std::find( abHas.begin(), abHas.end(), 1 ) != abHas.end();
 
     if ( bHas ) {
         DefaultLogger::get()->info("CalcTangentsProcess finished. Tangents have been calculated");
@@ -95,6 +95,7 @@ ColladaLoader::ColladaLoader()
 	, mAnims()
 	, noSkeletonMesh( false )
     , ignoreUpDirection(false)
+    , numThreads( 1 )
     , mNodeNameCounter( 0 )
 {}
 
@@ -131,6 +132,8 @@ void ColladaLoader::SetupProperties(const Importer* pImp)
 {
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES,0) != 0;
     ignoreUpDirection = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_IGNORE_UP_DIRECTION,0) != 0;
+    const int threads = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_NUM_THREADS,1);
+    numThreads = threads < 0 ? 1 : static_cast<unsigned int>(threads);
 }
 
 
@@ -159,7 +162,7 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
     mAnims.clear();
 
     // parse the input file
-    ColladaParser parser( pIOHandler, pFile);
+    ColladaParser parser( pIOHandler, pFile, numThreads, m_scheduler);
 
     if( !parser.mRootNode)
         throw DeadlyImportError( "Collada: File came out empty. Something is wrong here.");
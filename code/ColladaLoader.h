@@ -246,6 +246,7 @@ protected:
 
     bool noSkeletonMesh;
     bool ignoreUpDirection;
+    unsigned int numThreads;
 
     /** Used by FindNameForNode() to generate unique node names */
     unsigned int mNodeNameCounter;
@@ -56,16 +56,85 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 #include <assimp/light.h>
 #include "TinyFormatter.h"
+#include "TaskScheduler.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace Assimp;
 using namespace Assimp::Collada;
 using namespace Assimp::Formatter;
 
+namespace {
+
+// Text blocks smaller than this are always parsed on the calling thread
+const size_t ParallelBlockSize = 256 * 1024;
+
+// ------------------------------------------------------------------------------------------------
+// Parses a whitespace separated list of numbers in blocks of ParallelBlockSize on several
+// threads. The blocks start at token boundaries, the tokens of each block are counted first
+// so every block can write straight into its part of the pre-sized output array.
+// Returns false if the text is not a plain list of pNumber tokens, the caller falls back to
+// the serial path then, which also reports any errors.
+template <typename T, typename Parser>
+bool ParseNumbersParallel( TaskScheduler* pScheduler, unsigned int pNumThreads, const char* pContent,
+    std::vector<T>& pValues, Parser pParse)
+{
+    const size_t length = ::strlen( pContent);
+    if( 1 == pNumThreads || length < 2 * ParallelBlockSize)
+        return false;
+
+    // find the block boundaries, each block begins with the first character of a token
+    std::vector<const char*> bounds( 1, pContent);
+    for( size_t pos = ParallelBlockSize; pos < length; pos += ParallelBlockSize)
+    {
+        const char* cur = std::max( pContent + pos, bounds.back());
+        while( !IsSpaceOrNewLine( *cur))
+            ++cur;
+        SkipSpacesAndLineEnd( &cur);
+        if( *cur == 0)
+            break;
+        bounds.push_back( cur);
+    }
+    bounds.push_back( pContent + length);
+    const size_t numBlocks = bounds.size() - 1;
+
+    // count the tokens in each block
+    std::vector<size_t> offsets( numBlocks + 1, 0);
+    TaskScheduler::ParallelFor( pScheduler, numBlocks, [&bounds, &offsets]( size_t block) {
+        size_t count = 0;
+        bool inToken = false;
+        for( const char* cur = bounds[ block]; cur != bounds[ block + 1]; ++cur)
+        {
+            const bool space = IsSpaceOrNewLine( *cur);
+            count += !space && !inToken;
+            inToken = !space;
+        }
+        offsets[ block + 1] = count;
+    }, pNumThreads);
+    for( size_t block = 0; block < numBlocks; ++block)
+        offsets[ block + 1] += offsets[ block];
+
+    // parse each block into its part of the array
+    pValues.resize( offsets.back());
+    std::vector<unsigned char> valid( numBlocks, 0);
+    TaskScheduler::ParallelFor( pScheduler, numBlocks, [&]( size_t block) {
+        const char* cur = bounds[ block];
+        const size_t count = offsets[ block + 1] - offsets[ block];
+        const bool complete = count == ReadNumberArray( cur, pValues.data() + offsets[ block], count, pParse);
+        SkipSpacesAndLineEnd( &cur);
+        valid[ block] = ( complete && cur == bounds[ block + 1]);
+    }, pNumThreads);
+
+    return std::find( valid.begin(), valid.end(), 0) == valid.end();
+}
+
+} // anonymous namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
+ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile,
+    unsigned int pNumThreads, TaskScheduler* pScheduler)
     : mFileName( pFile )
     , mReader( NULL )
     , mDataLibrary()
@@ -83,6 +152,8 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
     , mUnitSize( 1.0f )
     , mUpDirection( UP_Y )
     , mFormat(FV_1_5_n )    // We assume the newest file format by default
+    , mNumThreads( pNumThreads )
+    , mScheduler( pScheduler )
 {
     // validate io-handler instance
     if ( NULL == pIOHandler ) {
@@ -104,6 +175,10 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
 
     // start reading
     ReadContents();
+
+    // everything is copied out by now, free the text before the loader builds the scene
+    delete mReader;
+    mReader = NULL;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1975,22 +2050,17 @@ void ColladaParser::ReadDataArray()
 
                 SkipSpacesAndLineEnd( &content);
             }
+        } else if( ParseNumbersParallel( mScheduler, mNumThreads, content, data.mValues,
+            []( const char* c, ai_real& value) { return fast_atoreal_move<ai_real>( c, value); })
+            && data.mValues.size() >= count)
+        {
+            // surplus values are ignored, as below
+            data.mValues.resize( count);
         } else
         {
-            data.mValues.reserve( count);
-
-            for( unsigned int a = 0; a < count; a++)
-            {
-                if( *content == 0)
-                    ThrowException( "Expected more values while reading float_array contents.");
-
-                ai_real value;
-                // read a number
-                content = fast_atoreal_move<ai_real>( content, value);
-                data.mValues.push_back( value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd( &content);
-            }
+            data.mValues.resize( count);
+            if( count > 0 && ReadRealArray( content, &data.mValues[0], count) < count)
+                ThrowException( "Expected more values while reading float_array contents.");
         }
     }
 
@@ -2328,15 +2398,17 @@ size_t ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pP
 
     if (pNumPrimitives > 0) // It is possible to not contain any indices
     {
+        // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
+        const auto parseIndex = []( const char* c, size_t& value) {
+            value = size_t( std::max( 0, strtol10( c, &c)));
+            return c;
+        };
+
         const char* content = GetTextContent();
-        while( *content != 0)
+        if( !ParseNumbersParallel( mScheduler, mNumThreads, content, indices, parseIndex))
         {
-            // read a value.
-            // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-            int value = std::max( 0, strtol10( content, &content));
-            indices.push_back( size_t( value));
-            // skip whitespace after it
-            SkipSpacesAndLineEnd( &content);
+            indices.clear();
+            ReadNumberList( content, indices, parseIndex);
         }
     }
 
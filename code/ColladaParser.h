@@ -53,6 +53,7 @@
 
 namespace Assimp
 {
+    class TaskScheduler;
 
     // ------------------------------------------------------------------------------------------
     /** Parser helper class for the Collada loader.
@@ -65,8 +66,10 @@ namespace Assimp
         friend class ColladaLoader;
 
     protected:
-        /** Constructor from XML file */
-        ColladaParser( IOSystem* pIOHandler, const std::string& pFile);
+        /** Constructor from XML file. Large number arrays are parsed on up to
+         *  pNumThreads threads of the given scheduler, 0 for all of them. */
+        ColladaParser( IOSystem* pIOHandler, const std::string& pFile,
+            unsigned int pNumThreads = 1, TaskScheduler* pScheduler = NULL);
 
         /** Destructor */
         ~ColladaParser();
@@ -341,6 +344,12 @@ namespace Assimp
 
         /** Collada file format version */
         Collada::FormatVersion mFormat;
+
+        /** Number of threads to parse large number arrays with */
+        unsigned int mNumThreads;
+
+        /** Scheduler of the importer, may be NULL */
+        TaskScheduler* mScheduler;
     };
 
     // ------------------------------------------------------------------------------------------------
@@ -42,11 +42,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "DefaultIOSystem.h"
 #include "DefaultIOStream.h"
+#include "MMapIOStream.h"
 #include "StringComparison.h"
 
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/ai_assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 #ifdef __unix__
@@ -59,6 +61,7 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor.
 DefaultIOSystem::DefaultIOSystem()
+: mMemoryMapping( false )
 {
     // nothing to do here
 }
@@ -89,6 +92,14 @@ IOStream* DefaultIOSystem::Open( const char* strFile, const char* strMode)
     ai_assert(NULL != strFile);
     ai_assert(NULL != strMode);
 
+    // map read-only files into memory if requested, fall back to stdio on failure
+    if (mMemoryMapping && ::strchr(strMode, 'r') && !::strchr(strMode, '+')) {
+        IOStream* stream = MMapIOStream::Open( strFile);
+        if (stream) {
+            return stream;
+        }
+    }
+
     FILE* file = ::fopen( strFile, strMode);
     if( NULL == file)
         return NULL;
@@ -77,6 +77,12 @@ public:
     /** Compare two paths */
     bool ComparePaths (const char* one, const char* second) const;
 
+    // -------------------------------------------------------------------
+    /** Map files opened for reading into memory, see #AI_CONFIG_GLOB_MEMORY_MAPPED_IO */
+    void SetMemoryMapping( bool enable ) {
+        mMemoryMapping = enable;
+    }
+
     /** @brief get the file name of a full filepath
      * example: /tmp/archive.tar.gz -> archive.tar.gz
      */
@@ -91,6 +97,9 @@ public:
      * example: /tmp/archive.tar.gz -> /tmp/
      */
     static std::string absolutePath( const std::string &path);
+
+private:
+    bool mMemoryMapping;
 };
 
 } //!ns Assimp
@@ -379,6 +379,12 @@ void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev )
 {
     ai_assert(NULL != message);
 
+    // imports may run on several threads (see BatchLoader), so guard
+    // the repeat detection buffer as well as the streams
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(loggerMutex);
+#endif
+
     // Check whether this is a repeated message
     if (! ::strncmp( message,lastMsg, lastLen-1))
     {
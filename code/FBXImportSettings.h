@@ -62,6 +62,7 @@ struct ImportSettings
         , readWeights(true)
         , preservePivots(true)
         , optimizeEmptyAnimationCurves(true)
+        , numThreads(1)
     {}
 
 
@@ -136,6 +137,11 @@ struct ImportSettings
      *  values matching the corresponding node transformation.
      *  The default value is true. */
     bool optimizeEmptyAnimationCurves;
+
+    /** number of threads to inflate compressed arrays in advance with,
+     *  0 for one per core. The default value is 1, arrays are
+     *  inflated when they are read. */
+    unsigned int numThreads;
 };
 
 
@@ -132,6 +132,9 @@ void FBXImporter::SetupProperties(const Importer* pImp)
     settings.strictMode = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_STRICT_MODE, false);
     settings.preservePivots = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, true);
     settings.optimizeEmptyAnimationCurves = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_OPTIMIZE_EMPTY_ANIMATION_CURVES, true);
+
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_FBX_NUM_THREADS, 1);
+    settings.numThreads = numThreads < 0 ? 1 : static_cast<unsigned int>(numThreads);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -149,11 +152,18 @@ void FBXImporter::InternReadFile( const std::string& pFile,
     // then becomes very large, too. Assimp doesn't support
     // streaming for its output data structures so the net win with
     // streaming input data would be very low.
+    // Binary files are tokenized in place if the file is mapped into
+    // memory, the text tokenizer needs a terminating zero.
     std::vector<char> contents;
-    contents.resize(stream->FileSize()+1);
-    stream->Read( &*contents.begin(), 1, contents.size()-1 );
-    contents[ contents.size() - 1 ] = 0;
-    const char* const begin = &*contents.begin();
+    const char* begin = static_cast<const char*>(stream->GetMappedData());
+    size_t length = stream->FileSize();
+    if (!begin || length < 18 || strncmp(begin,"Kaydara FBX Binary",18)) {
+        contents.resize(stream->FileSize()+1);
+        stream->Read( &*contents.begin(), 1, contents.size()-1 );
+        contents[ contents.size() - 1 ] = 0;
+        begin = &*contents.begin();
+        length = contents.size();
+    }
 
     // broadphase tokenizing pass in which we identify the core
     // syntax elements of FBX (brackets, commas, key:value mappings)
@@ -163,7 +173,7 @@ void FBXImporter::InternReadFile( const std::string& pFile,
         bool is_binary = false;
         if (!strncmp(begin,"Kaydara FBX Binary",18)) {
             is_binary = true;
-            TokenizeBinary(tokens,begin,static_cast<unsigned int>(contents.size()));
+            TokenizeBinary(tokens,begin,static_cast<unsigned int>(length));
         }
         else {
             Tokenize(tokens,begin);
@@ -171,7 +181,7 @@ void FBXImporter::InternReadFile( const std::string& pFile,
 
         // use this information to construct a very rudimentary
         // parse-tree representing the FBX scope structure
-        Parser parser(tokens, is_binary);
+        Parser parser(tokens, is_binary, settings.numThreads, m_scheduler);
 
         // take the raw parse-tree and convert it to a FBX DOM
         Document doc(parser,settings);
@@ -59,8 +59,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "fast_atof.h"
 #include "ByteSwapper.h"
+#include "TaskScheduler.h"
 
 #include <iostream>
+#include <algorithm>
 
 using namespace Assimp;
 using namespace Assimp::FBX;
@@ -116,6 +118,7 @@ namespace FBX {
 // ------------------------------------------------------------------------------------------------
 Element::Element(const Token& key_token, Parser& parser)
 : key_token(key_token)
+, parser(parser)
 {
     TokenPtr n = NULL;
     do {
@@ -214,7 +217,8 @@ Scope::~Scope()
 
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenList& tokens, bool is_binary, unsigned int numThreads,
+    TaskScheduler* scheduler)
 : tokens(tokens)
 , last()
 , current()
@@ -222,6 +226,10 @@ Parser::Parser (const TokenList& tokens, bool is_binary)
 , is_binary(is_binary)
 {
     root.reset(new Scope(*this,true));
+
+    if (is_binary && numThreads != 1) {
+        InflateBinaryArrays(numThreads, scheduler);
+    }
 }
 
 
@@ -521,11 +529,66 @@ void ReadBinaryDataArrayHead(const char*& data, const char* end, char& type, uin
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// get the size of a single element of a binary data array
+uint32_t GetBinaryDataArrayStride(char type)
+{
+    switch(type)
+    {
+    case 'f':
+    case 'i':
+        return 4;
+
+    case 'd':
+    case 'l':
+        return 8;
+
+    default:
+        ai_assert(false);
+    };
+    return 0;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// inflate zlib compressed data, buff must already have the size of the uncompressed data
+void InflateBinaryData(const char* data, uint32_t comp_len, std::vector<char>& buff)
+{
+    // zlib/deflate, next comes ZIP head (0x78 0x01)
+    // see http://www.ietf.org/rfc/rfc1950.txt
+
+    z_stream zstream;
+    zstream.opaque = Z_NULL;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree  = Z_NULL;
+    zstream.data_type = Z_BINARY;
+
+    // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
+    if(Z_OK != inflateInit(&zstream)) {
+        ParseError("failure initializing zlib");
+    }
+
+    zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
+    zstream.avail_in  = comp_len;
+
+    zstream.avail_out = static_cast<uInt>(buff.size());
+    zstream.next_out = reinterpret_cast<Bytef*>(&*buff.begin());
+    const int ret = inflate(&zstream, Z_FINISH);
+
+    if (ret != Z_STREAM_END && ret != Z_OK) {
+        ParseError("failure decompressing compressed data section");
+    }
+
+    // terminate zlib
+    inflateEnd(&zstream);
+}
+
+
 // ------------------------------------------------------------------------------------------------
 // read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header)
 void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
     std::vector<char>& buff,
-    const Element& /*el*/)
+    const Element& el)
 {
     BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
     AI_SWAP4(encmode);
@@ -539,60 +602,21 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
     ai_assert(data + comp_len == end);
 
     // determine the length of the uncompressed data by looking at the type signature
-    uint32_t stride = 0;
-    switch(type)
-    {
-    case 'f':
-    case 'i':
-        stride = 4;
-        break;
-
-    case 'd':
-    case 'l':
-        stride = 8;
-        break;
-
-    default:
-        ai_assert(false);
-    };
-
-    const uint32_t full_length = stride * count;
-    buff.resize(full_length);
+    const uint32_t full_length = GetBinaryDataArrayStride(type) * count;
 
     if(encmode == 0) {
         ai_assert(full_length == comp_len);
 
         // plain data, no compression
+        buff.resize(full_length);
         std::copy(data, end, buff.begin());
     }
     else if(encmode == 1) {
-        // zlib/deflate, next comes ZIP head (0x78 0x01)
-        // see http://www.ietf.org/rfc/rfc1950.txt
-
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        if(Z_OK != inflateInit(&zstream)) {
-            ParseError("failure initializing zlib");
+        // maybe the parser has already done the work
+        if (!el.GetParser().TakeInflatedArray(data, buff) || buff.size() != full_length) {
+            buff.resize(full_length);
+            InflateBinaryData(data, comp_len, buff);
         }
-
-        zstream.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>(data) );
-        zstream.avail_in  = comp_len;
-
-        zstream.avail_out = static_cast<uInt>(buff.size());
-        zstream.next_out = reinterpret_cast<Bytef*>(&*buff.begin());
-        const int ret = inflate(&zstream, Z_FINISH);
-
-        if (ret != Z_STREAM_END && ret != Z_OK) {
-            ParseError("failure decompressing compressed data section");
-        }
-
-        // terminate zlib
-        inflateEnd(&zstream);
     }
 #ifdef ASSIMP_BUILD_DEBUG
     else {
@@ -608,6 +632,79 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
 } // !anon
 
 
+// ------------------------------------------------------------------------------------------------
+// Inflate all compressed binary arrays concurrently. Geometry, skin weights and animation
+// curves are read much later, when the objects are resolved, and just pick up the results.
+void Parser::InflateBinaryArrays(unsigned int numThreads, TaskScheduler* scheduler)
+{
+    // collect the compressed arrays, i.e. data tokens with a lowercase
+    // type code and the encoding field set to 1
+    std::vector<TokenPtr> arrays;
+    for(TokenList::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+        const Token& t = **it;
+        if (t.Type() != TokenType_DATA || t.end() - t.begin() < 13) {
+            continue;
+        }
+        const char type = *t.begin();
+        if (type != 'f' && type != 'd' && type != 'i' && type != 'l') {
+            continue;
+        }
+        BE_NCONST uint32_t encmode = SafeParse<uint32_t>(t.begin() + 5, t.end());
+        AI_SWAP4(encmode);
+        if (encmode == 1) {
+            arrays.push_back(&t);
+        }
+    }
+
+    std::vector< std::pair<const char*, std::vector<char> > > results(arrays.size());
+    auto inflateArray = [&results, &arrays](size_t i) {
+        const Token& t = *arrays[i];
+        BE_NCONST uint32_t count = SafeParse<uint32_t>(t.begin() + 1, t.end());
+        AI_SWAP4(count);
+        BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(t.begin() + 9, t.end());
+        AI_SWAP4(comp_len);
+
+        const char* data = t.begin() + 13;
+        if (data + comp_len != t.end()) {
+            return;
+        }
+
+        std::vector<char> buff(GetBinaryDataArrayStride(*t.begin()) * count);
+        try {
+            InflateBinaryData(data, comp_len, buff);
+        }
+        catch (const DeadlyImportError&) {
+            // leave the error to ReadBinaryDataArray(), which knows the element
+            return;
+        }
+        results[i].first = data;
+        results[i].second.swap(buff);
+    };
+
+    TaskScheduler::ParallelFor(scheduler, arrays.size(), inflateArray, numThreads);
+
+    // drop the failed ones
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].first) {
+            inflated[results[i].first].swap(results[i].second);
+        }
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------------
+bool Parser::TakeInflatedArray(const char* data, std::vector<char>& out) const
+{
+    std::map<const char*, std::vector<char> >::iterator it = inflated.find(data);
+    if (it == inflated.end()) {
+        return false;
+    }
+    out.swap(it->second);
+    inflated.erase(it);
+    return true;
+}
+
+
 // ------------------------------------------------------------------------------------------------
 // read an array of float3 tuples
 void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
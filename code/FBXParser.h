@@ -53,6 +53,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 
 namespace Assimp {
+
+class TaskScheduler;
+
 namespace FBX {
 
 class Scope;
@@ -101,9 +104,14 @@ public:
         return tokens;
     }
 
+    const Parser& GetParser() const {
+        return parser;
+    }
+
 private:
 
     const Token& key_token;
+    const Parser& parser;
     TokenList tokens;
     std::unique_ptr<Scope> compound;
 };
@@ -157,8 +165,12 @@ class Parser
 public:
 
     /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+     *  the objects must persist during the entire parser lifetime.
+     *  If numThreads is not 1, all compressed binary arrays are inflated
+     *  in advance using this number of threads (0 for all threads of the
+     *  scheduler, which may be NULL). */
+    Parser (const TokenList& tokens,bool is_binary, unsigned int numThreads = 1,
+        TaskScheduler* scheduler = NULL);
     ~Parser();
 
 public:
@@ -171,6 +183,13 @@ public:
         return is_binary;
     }
 
+    /** Take the contents of a compressed binary array inflated in advance.
+     *  The parser drops its copy, so each array can be taken once.
+     *  @param data Begin of the compressed data of the array
+     *  @param out Receives the inflated data
+     *  @return false if the array hasn't been inflated in advance */
+    bool TakeInflatedArray(const char* data, std::vector<char>& out) const;
+
 private:
     friend class Scope;
     friend class Element;
@@ -180,6 +199,8 @@ private:
     TokenPtr LastToken() const;
     TokenPtr CurrentToken() const;
 
+    void InflateBinaryArrays(unsigned int numThreads, TaskScheduler* scheduler);
+
 
 private:
     const TokenList& tokens;
@@ -189,6 +210,10 @@ private:
     std::unique_ptr<Scope> root;
 
     const bool is_binary;
+
+    // arrays inflated in advance, by the address of their compressed data.
+    // Entries are removed once the DOM has read them.
+    mutable std::map< const char*, std::vector<char> > inflated;
 };
 
 
@@ -190,7 +190,9 @@ evil_jump_outside:
             }
             else {
                 // Otherwise delete it if we don't need this face
-                delete[] face_src.mIndices;
+                if (!mesh->IsInFaceIndexPool(face_src.mIndices)) {
+                    delete[] face_src.mIndices;
+                }
                 face_src.mIndices = NULL;
                 face_src.mNumIndices = 0;
             }
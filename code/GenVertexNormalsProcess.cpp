@@ -48,15 +48,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
+#include "SpatialGrid.h"
 #include "Exceptional.h"
 #include "qnan.h"
+#include <algorithm>
 
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess()
-: configMaxAngle( AI_DEG_TO_RAD( 175.f ) ) {
+: configMaxAngle( AI_DEG_TO_RAD( 175.f ) )
+, configUseSpatialGrid( false ) {
     // empty
 }
 
@@ -80,6 +83,9 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,(ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,(ai_real)175.0),(ai_real)0.0));
+
+    // Get the current value of the AI_CONFIG_PP_GSN_USE_SPATIAL_GRID property
+    configUseSpatialGrid = pImp->GetPropertyBool(AI_CONFIG_PP_GSN_USE_SPATIAL_GRID,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -91,12 +97,13 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
     if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-    {
-        if(GenMeshVertexNormals( pScene->mMeshes[a],a))
-            bHas = true;
-    }
+    // not std::vector<bool>, the meshes may be processed concurrently
+    std::vector<unsigned char> abHas( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene->mNumMeshes, [ this, pScene, &abHas ]( unsigned int a ) {
+        abHas[ a ] = GenMeshVertexNormals( pScene->mMeshes[ a ], a );
+    } );
+
+    const bool bHas = std::find( abHas.begin(), abHas.end(), 1 ) != abHas.end();
 
     if (bHas)   {
         DefaultLogger::get()->info("GenVertexNormalsProcess finished. "
@@ -154,8 +161,13 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
     // check whether we can reuse the SpatialSort of a previous step.
     SpatialSort* vertexFinder = NULL;
     SpatialSort  _vertexFinder;
+    SpatialGrid  gridFinder;
     ai_real posEpsilon = ai_real( 1e-5 );
-    if (shared) {
+    if (configUseSpatialGrid) {
+        // the grid isn't shared with other steps
+        gridFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
+        posEpsilon = ComputePositionEpsilon(pMesh);
+    } else if (shared) {
         std::vector<std::pair<SpatialSort,ai_real> >* avf;
         shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
         if (avf)
@@ -165,7 +177,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
             posEpsilon = blubb.second;
         }
     }
-    if (!vertexFinder)  {
+    if (!vertexFinder && !configUseSpatialGrid)  {
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
@@ -184,7 +196,11 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
             }
 
             // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            if (configUseSpatialGrid) {
+                gridFinder.FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            } else {
+                vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            }
 
             aiVector3D pcNor;
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
@@ -208,7 +224,11 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
         const ai_real fLimit = std::cos(configMaxAngle);
         for (unsigned int i = 0; i < pMesh->mNumVertices;++i)   {
             // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
+            if (configUseSpatialGrid) {
+                gridFinder.FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+            } else {
+                vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
+            }
 
             aiVector3D vr = pMesh->mNormals[i];
             ai_real vrlen = vr.Length();
@@ -91,6 +91,12 @@ public:
         configMaxAngle =f;
     }
 
+    // setter for configUseSpatialGrid
+    inline void SetUseSpatialGrid(bool b)
+    {
+        configUseSpatialGrid = b;
+    }
+
 public:
 
     // -------------------------------------------------------------------
@@ -105,6 +111,9 @@ private:
 
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+
+    /** Configuration option: use a SpatialGrid instead of a SpatialSort */
+    bool configUseSpatialGrid;
 };
 
 } // end of namespace Assimp
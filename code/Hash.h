@@ -113,4 +113,19 @@ int rem;
     return hash;
 }
 
+// ------------------------------------------------------------------------------------------------
+// 64 bit FNV-1a hash (incremental version). Slower than SuperFastHash, but
+// wide enough to identify file contents rather than just short keys.
+// ------------------------------------------------------------------------------------------------
+static const uint64_t FNV1aHashBasis64 = 14695981039346656037ull;
+
+inline uint64_t FNV1aHash64 (const void * data, size_t len, uint64_t hash = FNV1aHashBasis64) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (const uint8_t* const end = p + len; p != end; ++p) {
+        hash ^= *p;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 #endif // !! AI_HASH_H_INCLUDED
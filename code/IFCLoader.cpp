@@ -156,6 +156,9 @@ void IFCImporter::SetupProperties(const Importer* pImp)
     settings.skipCurveRepresentations = pImp->GetPropertyBool(AI_CONFIG_IMPORT_IFC_SKIP_CURVE_REPRESENTATIONS,true);
     settings.useCustomTriangulation = pImp->GetPropertyBool(AI_CONFIG_IMPORT_IFC_CUSTOM_TRIANGULATION,true);
 
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_IFC_NUM_THREADS,1);
+    settings.numThreads = numThreads < 0 ? 1 : static_cast<unsigned int>(numThreads);
+
     settings.conicSamplingAngle = 10.f;
     settings.skipAnnotations = true;
 }
@@ -264,6 +267,12 @@ void IFCImporter::InternReadFile( const std::string& pFile,
 
     // feed the IFC schema into the reader and pre-parse all lines
     STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track);
+
+    // convert the entity records up front if we're allowed to use multiple threads
+    if (settings.numThreads != 1) {
+        db->PreEvaluate(settings.numThreads,m_scheduler);
+    }
+
     const STEP::LazyObject* proj =  db->GetObject("ifcproject");
     if (!proj) {
         ThrowException("missing IfcProject entity");
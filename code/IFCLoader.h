@@ -111,6 +111,7 @@ public:
             , useCustomTriangulation()
             , skipAnnotations()
             , conicSamplingAngle(10.f)
+            , numThreads(1)
         {}
 
 
@@ -119,6 +120,7 @@ public:
         bool useCustomTriangulation;
         bool skipAnnotations;
         float conicSamplingAngle;
+        unsigned int numThreads;
     };
 
 
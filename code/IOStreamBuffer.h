@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 
 #include <iostream>
+#include <algorithm>
 
 namespace Assimp {
 
@@ -99,6 +100,12 @@ public:
     /// @return true if successful.
     bool getNextLine( std::vector<T> &buffer );
 
+    /// @brief  Will read all complete lines of the next block at once. The
+    ///         block is terminated by a line end and a binary zero.
+    /// @param  buffer      The buffer for the lines.
+    /// @return true if successful.
+    bool getNextLineBlock( std::vector<T> &buffer );
+
 private:
     IOStream *m_stream;
     size_t m_filesize;
@@ -236,14 +243,31 @@ bool IOStreamBuffer<T>::getNextLine( std::vector<T> &buffer ) {
         }
     }
     size_t i = 0;
-    while ( !IsLineEnd( m_cache[ m_cachePos ] ) ) {
-        buffer[ i ] = m_cache[ m_cachePos ];
-        m_cachePos++;
-        i++;
-        if ( m_cachePos >= m_cacheSize ) {
-            if ( !readNextBlock() ) {
+    for ( ;; ) {
+        // find the line end in the cached block, then copy the line at once
+        size_t end = m_cachePos;
+        while ( end < m_cacheSize && !IsLineEnd( m_cache[ end ] ) ) {
+            end++;
+        }
+
+        // lines may be longer than the cache
+        const size_t len = end - m_cachePos;
+        if ( i + len + 1 > buffer.size() ) {
+            buffer.resize( std::max( i + len + 1, buffer.size() * 2 ) );
+        }
+        std::copy( m_cache.begin() + m_cachePos, m_cache.begin() + end, buffer.begin() + i );
+        i += len;
+        m_cachePos = end;
+        if ( end < m_cacheSize ) {
+            break;
+        }
+        if ( !readNextBlock() ) {
+            // the last line of the file has no line end
+            if ( 0 == i ) {
                 return false;
             }
+            buffer[ i ] = '\n';
+            return true;
         }
     }
     buffer[ i ] = '\n';
@@ -252,4 +276,39 @@ bool IOStreamBuffer<T>::getNextLine( std::vector<T> &buffer ) {
     return true;
 }
 
+template<class T>
+inline
+bool IOStreamBuffer<T>::getNextLineBlock( std::vector<T> &buffer ) {
+    buffer.clear();
+    if ( m_cachePos == m_cacheSize || 0 == m_filePos ) {
+        if ( !readNextBlock() ) {
+            return false;
+        }
+    }
+    for ( ;; ) {
+        // everything up to the last line end in the cache goes into the block
+        size_t end = m_cacheSize;
+        while ( end > m_cachePos && !IsLineEnd( m_cache[ end - 1 ] ) ) {
+            end--;
+        }
+        if ( end > m_cachePos ) {
+            buffer.insert( buffer.end(), m_cache.begin() + m_cachePos, m_cache.begin() + end );
+            m_cachePos = end;
+            break;
+        }
+
+        // the line continues in the next block
+        buffer.insert( buffer.end(), m_cache.begin() + m_cachePos, m_cache.begin() + m_cacheSize );
+        m_cachePos = m_cacheSize;
+        if ( !readNextBlock() ) {
+            // the last line of the file has no line end
+            buffer.push_back( '\n' );
+            break;
+        }
+    }
+    buffer.push_back( '\0' );
+
+    return true;
+}
+
 } // !ns Assimp
@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SceneCombiner.h"
 #include "StandardShapes.h"
 #include "Importer.h"
+#include "MaterialSystem.h"
 
 // We need MathFunctions.h to compute the lcm/gcd of a number
 #include "MathFunctions.h"
@@ -646,6 +647,7 @@ void SetupMapping (aiMaterial* mat, aiTextureMapping mode, const aiVector3D& axi
     }
     mat->mNumProperties = (unsigned int)p.size();
     ::memcpy(mat->mProperties,&p[0],sizeof(void*)*mat->mNumProperties);
+    UpdateMaterialIndex(mat);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -932,6 +934,7 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 
     // Batch loader used to load external models
     BatchLoader batch(pIOHandler);
+    batch.setTaskScheduler(m_scheduler);
 //  batch.SetBasePath(pFile);
 
     cameras.reserve(5);
@@ -0,0 +1,457 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  ImportCache.cpp
+ *  @brief Implementation of the on-disk import cache
+ */
+#include "ImportCache.h"
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+
+#include "AssbinLoader.h"
+#include "BaseImporter.h"
+#include "DefaultIOSystem.h"
+#include "Hash.h"
+#include "Importer.h"
+#include "StringUtils.h"
+#include <assimp/ai_assert.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+#include <assimp/version.h>
+#include <assimp/config.h>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace Assimp;
+
+namespace Assimp {
+    class ExportProperties;
+
+    // defined in AssbinExporter.cpp
+    void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+}
+
+namespace {
+
+// properties which don't change the imported scene, so they
+// should not invalidate the cache either
+const char* const NeutralProperties[] = {
+    AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY,
+    AI_CONFIG_GLOB_MEASURE_TIME,
+    AI_CONFIG_GLOB_MEMORY_MAPPED_IO,
+    AI_CONFIG_GLOB_MULTITHREADING,
+    AI_CONFIG_GLOB_SCENE_ARENA,
+    AI_CONFIG_PP_PARALLEL_MESHES,
+    AI_CONFIG_PP_PARALLEL_NUM_THREADS,
+    AI_CONFIG_IMPORT_OBJ_NUM_THREADS,
+    AI_CONFIG_IMPORT_STL_NUM_THREADS,
+    AI_CONFIG_IMPORT_FBX_NUM_THREADS,
+    AI_CONFIG_IMPORT_IFC_NUM_THREADS,
+    AI_CONFIG_IMPORT_COLLADA_NUM_THREADS,
+    AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES,
+    AI_CONFIG_IMPORT_ASSBIN_NUM_THREADS
+};
+
+// ------------------------------------------------------------------------------------------------
+bool IsNeutralProperty(unsigned int key)
+{
+    for (size_t i = 0; i < sizeof(NeutralProperties) / sizeof(NeutralProperties[0]); ++i) {
+        if (key == SuperFastHash(NeutralProperties[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+uint64_t HashValue(uint64_t hash, const T& value)
+{
+    return FNV1aHash64(&value, sizeof(T), hash);
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t HashValue(uint64_t hash, const std::string& value)
+{
+    hash = HashValue(hash, value.length());
+    return FNV1aHash64(value.data(), value.length(), hash);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename TMap>
+uint64_t HashProperties(uint64_t hash, const TMap& properties)
+{
+    size_t count = 0;
+    for (typename TMap::const_iterator it = properties.begin(); it != properties.end(); ++it) {
+        if (IsNeutralProperty((*it).first)) {
+            continue;
+        }
+        hash = HashValue(hash, (*it).first);
+        hash = HashValue(hash, (*it).second);
+        ++count;
+    }
+    // separate the maps from each other
+    return HashValue(hash, count);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hashes the contents of a file, returns false if it cannot be opened
+bool HashFile(IOSystem* pIOHandler, const std::string& pFile, uint64_t& hash)
+{
+    IOStream* stream = pIOHandler->Open(pFile, "rb");
+    if (!stream) {
+        return false;
+    }
+
+    const size_t fileSize = stream->FileSize();
+    hash = HashValue(hash, fileSize);
+    const void* mapped = stream->GetMappedData();
+    if (mapped) {
+        hash = FNV1aHash64(mapped, fileSize, hash);
+    }
+    else {
+        std::vector<char> buffer(1 << 16);
+        size_t read;
+        while ((read = stream->Read(&buffer[0], 1, buffer.size())) > 0) {
+            hash = FNV1aHash64(&buffer[0], read, hash);
+        }
+    }
+    pIOHandler->Close(stream);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Directory part of a path including the trailing separator, empty if there is none
+std::string DirectoryOf(const std::string& pFile)
+{
+    const std::string::size_type pos = pFile.find_last_of("/\\");
+    return pos == std::string::npos ? std::string() : pFile.substr(0, pos + 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Dependencies are listed one per line: the hash of the file or '-' if it
+// didn't exist, 'r' for a path relative to the directory of the source file
+// or 'a' for any other path, and the path itself. Relative paths keep copies
+// of a file and its dependencies in different directories apart.
+const char DependencyRelative = 'r';
+const char DependencyAbsolute = 'a';
+const char DependencyMissing[] = "-";
+
+} // ! namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Forwards to another IO handler and records the files an importer opens or
+// looks for. Importers may read files from several threads.
+class DependencyRecorder : public IOSystem
+{
+public:
+    explicit DependencyRecorder(IOSystem* io)
+        : mIO(io)
+    {}
+
+    bool Exists(const char* pFile) const {
+        const bool exists = mIO->Exists(pFile);
+        if (!exists) {
+            Record(pFile);
+        }
+        return exists;
+    }
+
+    char getOsSeparator() const {
+        return mIO->getOsSeparator();
+    }
+
+    IOStream* Open(const char* pFile, const char* pMode = "rb") {
+        Record(pFile);
+        return mIO->Open(pFile, pMode);
+    }
+
+    void Close(IOStream* pFile) {
+        mIO->Close(pFile);
+    }
+
+    bool ComparePaths(const char* one, const char* second) const {
+        return mIO->ComparePaths(one, second);
+    }
+
+    bool PushDirectory(const std::string& path) {
+        return mIO->PushDirectory(path);
+    }
+
+    const std::string& CurrentDirectory() const {
+        return mIO->CurrentDirectory();
+    }
+
+    size_t StackSize() const {
+        return mIO->StackSize();
+    }
+
+    bool PopDirectory() {
+        return mIO->PopDirectory();
+    }
+
+    std::set<std::string> GetFiles() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mFiles;
+    }
+
+private:
+    void Record(const char* pFile) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFiles.insert(pFile);
+    }
+
+    IOSystem* mIO;
+    mutable std::mutex mMutex;
+    mutable std::set<std::string> mFiles;
+};
+
+} // ! namespace Assimp
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string& directory)
+    : mDirectory(directory)
+    , mIOHandler(NULL)
+{
+    DefaultIOSystem io;
+    if (!mDirectory.empty() && mDirectory[mDirectory.length() - 1] != io.getOsSeparator()
+        && mDirectory[mDirectory.length() - 1] != '/') {
+        mDirectory += io.getOsSeparator();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::~ImportCache()
+{
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::ComputeKey(const Importer* pImp, const std::string& pFile,
+    const BaseImporter* imp, unsigned int pFlags)
+{
+    // hash the contents of the source file
+    uint64_t hash = FNV1aHashBasis64;
+    if (!HashFile(pImp->GetIOHandler(), pFile, hash)) {
+        return false;
+    }
+
+    // .. and everything else which determines the outcome of the import
+    hash = HashValue(hash, std::string(imp->GetInfo()->mName));
+    hash = HashValue(hash, aiGetVersionMajor());
+    hash = HashValue(hash, aiGetVersionMinor());
+    hash = HashValue(hash, aiGetVersionRevision());
+    hash = HashValue(hash, aiGetCompileFlags());
+    hash = HashValue(hash, pFlags);
+
+    const ImporterPimpl* pimpl = pImp->Pimpl();
+    hash = HashProperties(hash, pimpl->mIntProperties);
+    hash = HashProperties(hash, pimpl->mFloatProperties);
+    hash = HashProperties(hash, pimpl->mStringProperties);
+    hash = HashProperties(hash, pimpl->mMatrixProperties);
+
+    char name[32];
+    ai_snprintf(name, sizeof(name), "%016llx.assbin", static_cast<unsigned long long>(hash));
+    mEntryPath = mDirectory + name;
+    mFile = pFile;
+    mIOHandler = pImp->GetIOHandler();
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* ImportCache::Load(const Importer* pImp) const
+{
+    DefaultIOSystem io;
+    if (mEntryPath.empty() || !io.Exists(mEntryPath.c_str())) {
+        return NULL;
+    }
+
+    // all files the scene was imported from must be unchanged
+    IOStream* stream = io.Open(GetDependencyPath().c_str(), "rb");
+    if (!stream) {
+        return NULL;
+    }
+    std::string dependencies(stream->FileSize(), '\0');
+    const size_t read = dependencies.empty() ? 0 : stream->Read(&dependencies[0], 1, dependencies.size());
+    io.Close(stream);
+    if (read != dependencies.size()) {
+        return NULL;
+    }
+
+    const std::string directory = DirectoryOf(mFile);
+    IOSystem* pIOHandler = pImp->GetIOHandler();
+    std::string::size_type begin = 0, end;
+    while ((end = dependencies.find('\n', begin)) != std::string::npos) {
+        const std::string line = dependencies.substr(begin, end - begin);
+        begin = end + 1;
+
+        const std::string::size_type space = line.find(' ');
+        if (space == std::string::npos || line.length() < space + 3) {
+            return NULL;
+        }
+        const std::string expected = line.substr(0, space);
+        std::string file = line.substr(space + 3);
+        if (line[space + 1] == DependencyRelative) {
+            file = directory + file;
+        }
+
+        uint64_t hash = FNV1aHashBasis64;
+        char actual[32];
+        if (HashFile(pIOHandler, file, hash)) {
+            ai_snprintf(actual, sizeof(actual), "%016llx", static_cast<unsigned long long>(hash));
+        }
+        else {
+            ai_snprintf(actual, sizeof(actual), "%s", DependencyMissing);
+        }
+        if (expected != actual) {
+            DefaultLogger::get()->info("Import cache entry " + mEntryPath + " is outdated, " + file + " has changed");
+            return NULL;
+        }
+    }
+
+    AssbinImporter loader;
+    aiScene* scene = loader.ReadFile(pImp, mEntryPath, &io);
+    if (!scene) {
+        DefaultLogger::get()->warn("Import cache entry " + mEntryPath + " is unreadable, ignoring it");
+    }
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+IOSystem* ImportCache::GetRecordingIOHandler()
+{
+    ai_assert(NULL != mIOHandler);
+    mRecorder.reset(new DependencyRecorder(mIOHandler));
+    return mRecorder.get();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Store(const aiScene* pScene) const
+{
+    if (mEntryPath.empty()) {
+        return;
+    }
+
+    // hash everything the importer read besides the source file
+    std::string dependencies;
+    const std::string directory = DirectoryOf(mFile);
+    const std::set<std::string> files = mRecorder ? mRecorder->GetFiles() : std::set<std::string>();
+    for (std::set<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+        const std::string& file = *it;
+        if (file == mFile) {
+            continue;
+        }
+        if (file.find('\n') != std::string::npos) {
+            DefaultLogger::get()->warn("Unable to store " + file + " in the import cache");
+            return;
+        }
+
+        uint64_t hash = FNV1aHashBasis64;
+        char line[48];
+        if (HashFile(mIOHandler, file, hash)) {
+            ai_snprintf(line, sizeof(line), "%016llx ", static_cast<unsigned long long>(hash));
+        }
+        else {
+            ai_snprintf(line, sizeof(line), "%s ", DependencyMissing);
+        }
+        dependencies += line;
+        if (!directory.empty() && file.compare(0, directory.length(), directory) == 0) {
+            dependencies += DependencyRelative;
+            dependencies += ' ' + file.substr(directory.length()) + '\n';
+        }
+        else {
+            dependencies += DependencyAbsolute;
+            dependencies += ' ' + file + '\n';
+        }
+    }
+
+    // readers must not see the previous entry together with the new dependencies
+    DefaultIOSystem io;
+    ::remove(mEntryPath.c_str());
+    const std::string dependencyPath = GetDependencyPath();
+    IOStream* stream = io.Open(dependencyPath.c_str(), "wb");
+    if (!stream) {
+        DefaultLogger::get()->warn("Unable to write import cache entry " + dependencyPath);
+        return;
+    }
+    const size_t written = dependencies.empty() ? 0 : stream->Write(dependencies.data(), 1, dependencies.length());
+    io.Close(stream);
+    if (written != dependencies.length()) {
+        ::remove(dependencyPath.c_str());
+        DefaultLogger::get()->warn("Unable to write import cache entry " + dependencyPath);
+        return;
+    }
+
+    // write to a temporary file first so readers never see a partial entry
+    // the scene has been imported anyway, a failed export only loses the entry
+    const std::string temp = mEntryPath + ".tmp";
+    try {
+        ExportSceneAssbin(temp.c_str(), &io, pScene, NULL);
+    }
+    catch (const std::exception& e) {
+        ::remove(temp.c_str());
+        ::remove(dependencyPath.c_str());
+        DefaultLogger::get()->warn("Unable to write import cache entry " + temp + ": " + e.what());
+        return;
+    }
+    if (!io.Exists(temp.c_str())) {
+        ::remove(dependencyPath.c_str());
+        DefaultLogger::get()->warn("Unable to write import cache entry " + temp);
+        return;
+    }
+
+    ::remove(mEntryPath.c_str());
+    if (::rename(temp.c_str(), mEntryPath.c_str()) != 0) {
+        ::remove(temp.c_str());
+        ::remove(dependencyPath.c_str());
+        DefaultLogger::get()->warn("Unable to write import cache entry " + mEntryPath);
+    }
+}
+
+#endif // !! ASSIMP_BUILD_NO_IMPORT_CACHE
@@ -0,0 +1,143 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  ImportCache.h
+ *  @brief On-disk cache of post-processed scenes, see #AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY
+ */
+#ifndef AI_IMPORT_CACHE_H_INC
+#define AI_IMPORT_CACHE_H_INC
+
+#include <assimp/defs.h>
+#include <memory>
+#include <string>
+
+// the cache is stored in the Assbin format, so we need both ends of it
+#if (defined ASSIMP_BUILD_NO_EXPORT) || (defined ASSIMP_BUILD_NO_ASSBIN_EXPORTER) || (defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
+#   ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+#       define ASSIMP_BUILD_NO_IMPORT_CACHE
+#   endif
+#endif
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+
+struct aiScene;
+
+namespace Assimp    {
+
+class Importer;
+class IOSystem;
+class BaseImporter;
+class DependencyRecorder;
+
+// ----------------------------------------------------------------------------------
+/** ImportCache: Looks up and stores fully post-processed scenes in a
+ *  cache directory.
+ *
+ *  Cache entries are keyed by the contents of the source file, the importer
+ *  which reads it, the post-processing flags and all configuration
+ *  properties which may influence the result. Every other file the importer
+ *  opens or looks for (materials, buffers, textures, referenced scenes) is
+ *  listed with the hash of its contents next to the entry, the entry is
+ *  only used while all of them are unchanged.
+*/
+// ----------------------------------------------------------------------------------
+class ASSIMP_API ImportCache
+{
+public:
+    // ----------------------------------------------------------------
+    /** Constructs a cache working on the given directory.
+     *  @param directory Cache directory, must exist already. */
+    explicit ImportCache(const std::string& directory);
+
+    ~ImportCache();
+
+    // ----------------------------------------------------------------
+    /** Computes the cache key for an import.
+     *  @param pImp Importer instance providing the IO handler and
+     *    configuration properties.
+     *  @param pFile Source file to be read.
+     *  @param imp Importer plugin which will read the file.
+     *  @param pFlags Post-processing flags.
+     *  @return false if the source file cannot be read. */
+    bool ComputeKey(const Importer* pImp, const std::string& pFile,
+        const BaseImporter* imp, unsigned int pFlags);
+
+    // ----------------------------------------------------------------
+    /** Loads the cached scene for the current key.
+     *  @return NULL if there is no (readable) cache entry or if one of
+     *    the files the scene was imported from has changed since. */
+    aiScene* Load(const Importer* pImp) const;
+
+    // ----------------------------------------------------------------
+    /** Returns the IO handler to be passed to the importer plugin. It
+     *  forwards to the IO handler of the importer and records the files
+     *  the plugin reads, the cache keeps it. */
+    IOSystem* GetRecordingIOHandler();
+
+    // ----------------------------------------------------------------
+    /** Stores a scene under the current key, along with the hashes of
+     *  the files recorded during the import. Failures are logged, but
+     *  never fatal. */
+    void Store(const aiScene* pScene) const;
+
+    // ----------------------------------------------------------------
+    /** Returns the path of the cache entry for the current key. */
+    const std::string& GetEntryPath() const {
+        return mEntryPath;
+    }
+
+    // ----------------------------------------------------------------
+    /** Returns the path of the list of files the entry depends on. */
+    std::string GetDependencyPath() const {
+        return mEntryPath + ".deps";
+    }
+
+private:
+    std::string mDirectory;
+    std::string mEntryPath;
+    std::string mFile;
+    IOSystem* mIOHandler;
+    std::unique_ptr<DependencyRecorder> mRecorder;
+};
+
+} // ! namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_IMPORT_CACHE
+#endif // !! AI_IMPORT_CACHE_H_INC
@@ -76,10 +76,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Profiler.h"
 #include "TinyFormatter.h"
 #include "Exceptional.h"
-#include "Profiler.h"
+#include "ImportCache.h"
+#include "TaskScheduler.h"
 #include <set>
 #include <memory>
 #include <cctype>
+#include <algorithm>
+#include <typeinfo>
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 #   include "ValidateDataStructure.h"
@@ -154,10 +157,14 @@ Importer::Importer()
     pimpl->mIOHandler = new DefaultIOSystem;
     pimpl->mIsDefaultHandler = true;
     pimpl->bExtraVerbose     = false; // disable extra verbose mode by default
+    pimpl->mProfilePeakMemory = 0;
 
     pimpl->mProgressHandler = new DefaultProgressHandler();
     pimpl->mIsDefaultProgressHandler = true;
 
+    pimpl->mTaskExecutor = NULL;
+    pimpl->mScheduler = NULL;
+
     GetImporterInstanceList(pimpl->mImporter);
     GetPostProcessingStepInstanceList(pimpl->mPostProcessingSteps);
 
@@ -192,6 +199,9 @@ Importer::~Importer()
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Stop the worker threads
+    delete pimpl->mScheduler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -378,6 +388,36 @@ bool Importer::IsDefaultProgressHandler() const
     return pimpl->mIsDefaultProgressHandler;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Supply a custom task executor
+void Importer::SetTaskExecutor( TaskExecutor* pExecutor )
+{
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+    pimpl->mTaskExecutor = pExecutor;
+    ASSIMP_END_EXCEPTION_REGION(void);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the currently set task executor
+TaskExecutor* Importer::GetTaskExecutor() const
+{
+    return pimpl->mTaskExecutor;
+}
+
+// ------------------------------------------------------------------------------------------------
+// (Re-)create the task scheduler if its configuration changed since the last run
+static void SetupTaskScheduler(const Importer* pImp, ImporterPimpl* pimpl)
+{
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,0);
+    const unsigned int threads = numThreads < 0 ? 0 : static_cast<unsigned int>(numThreads);
+    if (pimpl->mScheduler && pimpl->mScheduler->GetNumThreads() == threads
+        && pimpl->mScheduler->GetExecutor() == pimpl->mTaskExecutor) {
+        return;
+    }
+    delete pimpl->mScheduler;
+    pimpl->mScheduler = new TaskScheduler(threads,pimpl->mTaskExecutor);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Validate post process step flags
 bool _ValidateFlags(unsigned int pFlags)
@@ -427,6 +467,29 @@ const aiScene* Importer::GetScene() const
     return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get a mesh of the current scene, loading it first if necessary
+const aiMesh* Importer::LoadMesh(unsigned int pIndex)
+{
+    aiScene* scene = pimpl->mScene;
+    if (!scene || pIndex >= scene->mNumMeshes) {
+        return NULL;
+    }
+
+    ScenePrivateData* priv = ScenePriv(scene);
+    if (priv->mSource) {
+        try {
+            priv->mSource->LoadMesh(scene, pIndex);
+        }
+        catch (const DeadlyImportError& e) {
+            // may run on several threads, so leave mErrorString alone
+            DefaultLogger::get()->error(std::string("Unable to load mesh: ") + e.what());
+            return NULL;
+        }
+    }
+    return scene->mMeshes[pIndex];
+}
+
 // ------------------------------------------------------------------------------------------------
 // Orphan the current scene and return it.
 aiScene* Importer::GetOrphanedScene()
@@ -434,6 +497,10 @@ aiScene* Importer::GetOrphanedScene()
     aiScene* s = pimpl->mScene;
 
     ASSIMP_BEGIN_EXCEPTION_REGION();
+    // LoadMesh() is no longer available for the scene
+    if (s) {
+        LoadDeferredMeshes(s);
+    }
     pimpl->mScene = NULL;
 
     pimpl->mErrorString = ""; /* reset error string */
@@ -605,6 +672,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             FreeScene();
         }
 
+        SetupTaskScheduler(this,pimpl);
+
+        // Memory mapped files are supported by our own IO handler only
+        if (pimpl->mIsDefaultHandler) {
+            static_cast<DefaultIOSystem*>(pimpl->mIOHandler)->SetMemoryMapping(
+                GetPropertyBool(AI_CONFIG_GLOB_MEMORY_MAPPED_IO,false));
+        }
+
         // First check if the file is accessible at all
         if( !pimpl->mIOHandler->Exists( pFile)) {
 
@@ -613,6 +688,10 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             return NULL;
         }
 
+        // drop the timings of the previous import
+        pimpl->mProfile.clear();
+        pimpl->mProfilePeakMemory = 0;
+
         std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
         if (profiler) {
             profiler->BeginRegion("total");
@@ -649,6 +728,27 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             }
         }
 
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+        // Look for an already post-processed copy of the scene in the cache
+        std::unique_ptr<ImportCache> cache;
+        const std::string cacheDirectory = GetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY,"");
+        if (!cacheDirectory.empty()) {
+            cache.reset(new ImportCache(cacheDirectory));
+            if (!cache->ComputeKey(this, pFile, imp, pFlags)) {
+                cache.reset();
+            }
+            else if ((pimpl->mScene = cache->Load(this)) != NULL) {
+                DefaultLogger::get()->info("Loaded the scene from the import cache: " + cache->GetEntryPath());
+                ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+
+                if (profiler) {
+                    AddProfileEntry(ImportProfileEntry::Phase_Total, "total", profiler->EndRegion("total"));
+                }
+                return pimpl->mScene;
+            }
+        }
+#endif // no import cache
+
         // Get file size for progress handler
         IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
         uint32_t fileSize = 0;
@@ -671,16 +771,28 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             profiler->BeginRegion("import");
         }
 
-        pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        IOSystem* pIOHandler = pimpl->mIOHandler;
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+        // the cache needs to know which other files the scene is made of
+        if (cache) {
+            pIOHandler = cache->GetRecordingIOHandler();
+        }
+#endif // no import cache
+        pimpl->mScene = imp->ReadFile( this, pFile, pIOHandler);
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
-            profiler->EndRegion("import");
+            AddProfileEntry(ImportProfileEntry::Phase_Import, ext, profiler->EndRegion("import"));
         }
 
         // If successful, apply all active post processing steps to the imported data
         if( pimpl->mScene)  {
 
+            // meshes are loaded on demand only if the scene is used as it is
+            if (pFlags) {
+                LoadDeferredMeshes(pimpl->mScene);
+            }
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure)
@@ -702,11 +814,18 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             pre.ProcessScene();
 
             if (profiler) {
-                profiler->EndRegion("preprocess");
+                AddProfileEntry(ImportProfileEntry::Phase_Preprocess, "preprocess", profiler->EndRegion("preprocess"));
             }
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+            if (cache && pimpl->mScene) {
+                LoadDeferredMeshes(pimpl->mScene);
+                cache->Store(pimpl->mScene);
+            }
+#endif // no import cache
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -717,7 +836,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
         pimpl->mPPShared->Clean();
 
         if (profiler) {
-            profiler->EndRegion("total");
+            AddProfileEntry(ImportProfileEntry::Phase_Total, "total", profiler->EndRegion("total"));
         }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
@@ -758,8 +877,16 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 
     // In debug builds: run basic flag validation
     ai_assert(_ValidateFlags(pFlags));
+    SetupTaskScheduler(this,pimpl);
     DefaultLogger::get()->info("Entering post processing pipeline");
 
+    LoadDeferredMeshes(pimpl->mScene);
+
+    // The steps free and replace scene arrays, which must not live in an arena then
+    if (pFlags & ~aiProcess_ValidateDataStructure) {
+        SceneArena::MoveToHeap(pimpl->mScene);
+    }
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
@@ -793,14 +920,15 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
 
+            const std::string name = profiler ? GetTypeName(typeid(*process)) : std::string();
             if (profiler) {
-                profiler->BeginRegion("postprocess");
+                profiler->BeginRegion(name);
             }
 
             process->ExecuteOnScene ( this );
 
             if (profiler) {
-                profiler->EndRegion("postprocess");
+                AddProfileEntry(ImportProfileEntry::Phase_PostProcess, name, profiler->EndRegion(name));
             }
         }
         if( !pimpl->mScene) {
@@ -855,6 +983,11 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
 
     // In debug builds: run basic flag validation
     DefaultLogger::get()->info( "Entering customized post processing pipeline" );
+    SetupTaskScheduler( this, pimpl );
+
+    // The steps free and replace scene arrays, which must not live in an arena then
+    LoadDeferredMeshes( pimpl->mScene );
+    SceneArena::MoveToHeap( pimpl->mScene );
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
@@ -883,14 +1016,15 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
 
     std::unique_ptr<Profiler> profiler( GetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 0 ) ? new Profiler() : NULL );
 
+    const std::string name = profiler ? GetTypeName( typeid( *rootProcess ) ) : std::string();
     if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
+        profiler->BeginRegion( name );
     }
 
     rootProcess->ExecuteOnScene( this );
 
     if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
+        AddProfileEntry( ImportProfileEntry::Phase_PostProcess, name, profiler->EndRegion( name ) );
     }
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -913,6 +1047,45 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Record the timing of a profiled region along with the current scene statistics
+void Importer::AddProfileEntry(ImportProfileEntry::Phase phase, const std::string& name, double seconds)
+{
+    ImportProfileEntry entry;
+    entry.mPhase = phase;
+    entry.mName.Set(name);
+    entry.mSeconds = seconds;
+    entry.mNumMeshes = pimpl->mScene ? pimpl->mScene->mNumMeshes : 0;
+
+    aiMemoryInfo mem;
+    GetMemoryRequirements(mem);
+    entry.mSceneMemory = mem.total;
+    pimpl->mProfilePeakMemory = std::max(pimpl->mProfilePeakMemory, mem.total);
+
+    pimpl->mProfile.push_back(entry);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t Importer::GetProfileEntryCount() const
+{
+    return pimpl->mProfile.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+const ImportProfileEntry* Importer::GetProfileEntry(size_t index) const
+{
+    if (index >= pimpl->mProfile.size()) {
+        return NULL;
+    }
+    return &pimpl->mProfile[index];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Importer::GetProfilePeakMemory() const
+{
+    return pimpl->mProfilePeakMemory;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Helper function to check whether an extension is supported by ASSIMP
 bool Importer::IsExtensionSupported(const char* szExtension) const
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <vector>
 #include <assimp/matrix4x4.h>
+#include <assimp/Importer.hpp>
 
 struct aiScene;
 
@@ -56,6 +57,8 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class TaskExecutor;
+    class TaskScheduler;
 
 
 //! @cond never
@@ -90,6 +93,13 @@ public:
     ProgressHandler* mProgressHandler;
     bool mIsDefaultProgressHandler;
 
+    /** Executor supplied by the application, not owned. */
+    TaskExecutor* mTaskExecutor;
+
+    /** Scheduler shared by all parallel code paths, see #AI_CONFIG_GLOB_MULTITHREADING.
+     *  Set up at the start of every import or post-processing run. */
+    TaskScheduler* mScheduler;
+
     /** Format-specific importer worker objects - one for each format we can read.*/
     std::vector< BaseImporter* > mImporter;
 
@@ -120,6 +130,12 @@ public:
 
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
+
+    /** Timings of the last import, see #AI_CONFIG_GLOB_MEASURE_TIME */
+    std::vector< ImportProfileEntry > mProfile;
+
+    /** Largest scene memory footprint of all entries in mProfile */
+    unsigned int mProfilePeakMemory;
 };
 //! @endcond
 
@@ -130,8 +146,9 @@ struct BatchData;
 /** FOR IMPORTER PLUGINS ONLY: A helper class to the pleasure of importers
  *  that need to load many external meshes recursively.
  *
- *  The class uses several threads to load these meshes (or at least it
- *  could, this has not yet been implemented at the moment).
+ *  The class uses several threads to load these meshes. Every request is
+ *  imported by its own Importer instance, calls into the IOSystem passed
+ *  to the constructor are serialized.
  *
  *  @note The class may not be used by more than one thread*/
 class ASSIMP_API BatchLoader
@@ -184,7 +201,39 @@ public:
      *  @return The current validation step.
      */
     bool getValidation() const;
-    
+
+    // -------------------------------------------------------------------
+    /** Sets the number of threads used by LoadAll().
+     *  Some importers still build generated names from global counters,
+     *  which makes these names depend on the order of completion if
+     *  files are loaded concurrently.
+     *  @param  numThreads  Number of threads, 0 for all threads of
+     *          the task scheduler, 1 to load on the calling thread
+     *          only (the default).
+     */
+    void setNumThreads( unsigned int numThreads );
+
+    // -------------------------------------------------------------------
+    /** Returns the number of threads used by LoadAll().
+     *  @return The number of threads, 0 for all threads of the scheduler,
+     *          1 by default.
+     */
+    unsigned int getNumThreads() const;
+
+    // -------------------------------------------------------------------
+    /** Sets the task scheduler LoadAll() and the nested imports run on,
+     *  usually the one of the calling importer.
+     *  @param  scheduler  Scheduler to be used, not owned. If NULL (the
+     *          default), LoadAll() starts threads of its own.
+     */
+    void setTaskScheduler( TaskScheduler* scheduler );
+
+    // -------------------------------------------------------------------
+    /** Returns the task scheduler used by LoadAll().
+     *  @return The scheduler or NULL.
+     */
+    TaskScheduler* getTaskScheduler() const;
+
     // -------------------------------------------------------------------
     /** Add a new file to the list of files to be loaded.
      *  @param file File to be loaded
@@ -214,7 +263,9 @@ public:
 
     // -------------------------------------------------------------------
     /** Waits until all scenes have been loaded. This returns
-     *  immediately if no scenes are queued.*/
+     *  immediately if no scenes are queued. The requests are
+     *  distributed over the worker threads, the results can be
+     *  polled by their ID regardless of the order of completion.*/
     void LoadAll();
 
 private:
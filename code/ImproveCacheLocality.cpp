@@ -99,10 +99,15 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 
     DefaultLogger::get()->debug("ImproveCacheLocalityProcess begin");
 
+    std::vector<float> afRes( pScene->mNumMeshes, 0.f );
+    ExecutePerMesh( pScene->mNumMeshes, [ this, pScene, &afRes ]( unsigned int a ) {
+        afRes[ a ] = ProcessMesh( pScene->mMeshes[ a ], a );
+    } );
+
     float out = 0.f;
     unsigned int numf = 0, numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
+        const float res = afRes[a];
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
             out  += res;
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "JoinVerticesProcess.h"
 #include "ProcessHelper.h"
+#include "SpatialGrid.h"
 #include "Vertex.h"
 #include "TinyFormatter.h"
 #include <stdio.h>
@@ -56,6 +57,7 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
+: configUseSpatialGrid( false )
 {
     // nothing to do here
 }
@@ -73,6 +75,15 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void JoinVerticesProcess::SetupProperties(const Importer* pImp)
+{
+    // Get the current value of the AI_CONFIG_PP_JIV_USE_SPATIAL_GRID property
+    configUseSpatialGrid = pImp->GetPropertyBool(AI_CONFIG_PP_JIV_USE_SPATIAL_GRID,false);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -88,9 +99,14 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
     }
 
     // execute the step
+    std::vector<int> aiNumVertices( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene->mNumMeshes, [ this, pScene, &aiNumVertices ]( unsigned int a ) {
+        aiNumVertices[ a ] = ProcessMesh( pScene->mMeshes[ a ], a );
+    } );
+
     int iNumVertices = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+        iNumVertices += aiNumVertices[a];
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger())
@@ -143,8 +159,15 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     SpatialSort* vertexFinder = NULL;
     SpatialSort _vertexFinder;
 
+    // The grid is built for this step only, it doesn't suffer from vertices
+    // laying on a plane parallel to the sorting plane.
+    SpatialGrid gridFinder;
+    if (configUseSpatialGrid) {
+        gridFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
+    }
+
     typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
+    if (shared && !configUseSpatialGrid) {
         std::vector<SpatPair >* avf;
         shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
         if (avf)    {
@@ -153,7 +176,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
             // posEpsilonSqr = blubb.second;
         }
     }
-    if (!vertexFinder)  {
+    if (!vertexFinder && !configUseSpatialGrid)  {
         // bad, need to compute it.
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
         vertexFinder = &_vertexFinder;
@@ -177,7 +200,11 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         Vertex v(pMesh,a);
 
         // collect all vertices that are close enough to the given position
-        vertexFinder->FindIdenticalPositions( v.position, verticesFound);
+        if (configUseSpatialGrid) {
+            gridFinder.FindIdenticalPositions( v.position, verticesFound);
+        } else {
+            vertexFinder->FindIdenticalPositions( v.position, verticesFound);
+        }
         unsigned int matchIndex = 0xffffffff;
 
         // check all unique vertices close to the position if this vertex is already present among them
@@ -74,6 +74,13 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -89,7 +96,16 @@ public:
      */
     int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
+    // setter for configUseSpatialGrid
+    inline void SetUseSpatialGrid(bool b)
+    {
+        configUseSpatialGrid = b;
+    }
+
 private:
+
+    /** Configuration option: use a SpatialGrid instead of a SpatialSort */
+    bool configUseSpatialGrid;
 };
 
 } // end of namespace Assimp
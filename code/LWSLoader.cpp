@@ -528,6 +528,7 @@ void LWSImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 
     // Construct a Batchimporter to read more files recursively
     BatchLoader batch(pIOHandler);
+    batch.setTaskScheduler(m_scheduler);
 //  batch.SetBasePath(pFile);
 
     // Construct an array to receive the flat output graph
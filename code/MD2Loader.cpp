@@ -226,9 +226,17 @@ void MD2Importer::InternReadFile( const std::string& pFile,
     if( fileSize < sizeof(MD2::Header))
         throw DeadlyImportError( "MD2 File is too small");
 
-    std::vector<uint8_t> mBuffer2(fileSize);
-    file->Read(&mBuffer2[0], 1, fileSize);
-    mBuffer = &mBuffer2[0];
+    // memory mapped files are read in place unless they need to be byte-swapped
+    std::vector<uint8_t> mBuffer2;
+#ifndef AI_BUILD_BIG_ENDIAN
+    mBuffer = static_cast<const uint8_t*>(file->GetMappedData());
+    if (!mBuffer)
+#endif
+    {
+        mBuffer2.resize(fileSize);
+        file->Read(&mBuffer2[0], 1, fileSize);
+        mBuffer = &mBuffer2[0];
+    }
 
 
     m_pcHeader = (BE_NCONST MD2::Header*)mBuffer;
@@ -586,6 +586,7 @@ bool MD3Importer::ReadMultipartFile()
 
         // now read these three files
         BatchLoader batch(mIOHandler);
+        batch.setTaskScheduler(m_scheduler);
         const unsigned int _lower = batch.AddLoadRequest(lower,0,&props);
         const unsigned int _upper = batch.AddLoadRequest(upper,0,&props);
         const unsigned int _head  = batch.AddLoadRequest(head,0,&props);
@@ -756,10 +757,18 @@ void MD3Importer::InternReadFile( const std::string& pFile,
     if( fileSize < sizeof(MD3::Header))
         throw DeadlyImportError( "MD3 File is too small.");
 
-    // Allocate storage and copy the contents of the file to a memory buffer
-    std::vector<unsigned char> mBuffer2 (fileSize);
-    file->Read( &mBuffer2[0], 1, fileSize);
-    mBuffer = &mBuffer2[0];
+    // Memory mapped files are read in place unless they need to be byte-swapped,
+    // otherwise allocate storage and copy the contents of the file to a memory buffer
+    std::vector<unsigned char> mBuffer2;
+#ifndef AI_BUILD_BIG_ENDIAN
+    mBuffer = static_cast<const unsigned char*>(file->GetMappedData());
+    if (!mBuffer)
+#endif
+    {
+        mBuffer2.resize(fileSize);
+        file->Read( &mBuffer2[0], 1, fileSize);
+        mBuffer = &mBuffer2[0];
+    }
 
     pcHeader = (BE_NCONST MD3::Header*)mBuffer;
 
@@ -0,0 +1,226 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file  MMapIOStream.cpp
+ *  @brief Read-only file I/O using memory mapped files
+ */
+
+#include <assimp/ai_assert.h>
+#include "MMapIOStream.h"
+#include <string.h>
+#include <algorithm>
+#include <memory>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <sys/types.h>
+#   include <sys/stat.h>
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+// ----------------------------------------------------------------------------------
+MMapIOStream::MMapIOStream()
+: mData(NULL)
+, mLength(0)
+, mPos(0)
+#ifdef _WIN32
+, mFile(INVALID_HANDLE_VALUE)
+, mMapping(NULL)
+#endif
+{
+    // empty
+}
+
+// ----------------------------------------------------------------------------------
+MMapIOStream* MMapIOStream::Open(const char* pFile)
+{
+    ai_assert(NULL != pFile);
+
+    std::unique_ptr<MMapIOStream> stream(new MMapIOStream());
+#ifdef _WIN32
+    stream->mFile = ::CreateFileA(pFile, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == stream->mFile) {
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(stream->mFile, &size) || 0 == size.QuadPart) {
+        return NULL;
+    }
+    stream->mLength = static_cast<size_t>(size.QuadPart);
+
+    stream->mMapping = ::CreateFileMappingA(stream->mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == stream->mMapping) {
+        return NULL;
+    }
+
+    stream->mData = static_cast<const uint8_t*>(::MapViewOfFile(stream->mMapping, FILE_MAP_READ, 0, 0, 0));
+    if (NULL == stream->mData) {
+        return NULL;
+    }
+#else
+    const int fd = ::open(pFile, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    // mmap() fails for empty files, let the caller fall back to stdio
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat) || !S_ISREG(fileStat.st_mode) || 0 == fileStat.st_size) {
+        ::close(fd);
+        return NULL;
+    }
+    stream->mLength = static_cast<size_t>(fileStat.st_size);
+
+    // the mapping stays valid after the descriptor has been closed
+    void* data = ::mmap(NULL, stream->mLength, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == data) {
+        return NULL;
+    }
+    stream->mData = static_cast<const uint8_t*>(data);
+#endif
+
+    return stream.release();
+}
+
+// ----------------------------------------------------------------------------------
+MMapIOStream::~MMapIOStream()
+{
+#ifdef _WIN32
+    if (mData) {
+        ::UnmapViewOfFile(mData);
+    }
+    if (mMapping) {
+        ::CloseHandle(mMapping);
+    }
+    if (INVALID_HANDLE_VALUE != mFile) {
+        ::CloseHandle(mFile);
+    }
+#else
+    if (mData) {
+        ::munmap(const_cast<uint8_t*>(mData), mLength);
+    }
+#endif
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Read(void* pvBuffer,
+    size_t pSize,
+    size_t pCount)
+{
+    ai_assert(NULL != pvBuffer && 0 != pSize && 0 != pCount);
+
+    const size_t cnt = std::min(pCount, (mLength - mPos) / pSize), ofs = pSize * cnt;
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+
+    return cnt;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Write(const void* /*pvBuffer*/,
+    size_t /*pSize*/,
+    size_t /*pCount*/)
+{
+    return 0;
+}
+
+// ----------------------------------------------------------------------------------
+aiReturn MMapIOStream::Seek(size_t pOffset,
+     aiOrigin pOrigin)
+{
+    // same semantics as fseek(): the end of the file is a valid position
+    size_t pos;
+    switch (pOrigin) {
+    case aiOrigin_SET:
+        pos = pOffset;
+        break;
+    case aiOrigin_CUR:
+        pos = mPos + pOffset;
+        break;
+    case aiOrigin_END:
+        if (pOffset > mLength) {
+            return AI_FAILURE;
+        }
+        pos = mLength - pOffset;
+        break;
+    default:
+        return AI_FAILURE;
+    }
+
+    if (pos > mLength) {
+        return AI_FAILURE;
+    }
+    mPos = pos;
+    return AI_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::Tell() const
+{
+    return mPos;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MMapIOStream::FileSize() const
+{
+    return mLength;
+}
+
+// ----------------------------------------------------------------------------------
+void MMapIOStream::Flush()
+{
+    // read-only, nothing to do
+}
+
+// ----------------------------------------------------------------------------------
+const void* MMapIOStream::GetMappedData() const
+{
+    return mData;
+}
@@ -0,0 +1,122 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  MMapIOStream.h
+ *  @brief Read-only file I/O using memory mapped files
+ */
+#ifndef AI_MMAPIOSTREAM_H_INC
+#define AI_MMAPIOSTREAM_H_INC
+
+#include <assimp/IOStream.hpp>
+#include <stdint.h>
+
+namespace Assimp    {
+
+// ----------------------------------------------------------------------------------
+//! @class  MMapIOStream
+//! @brief  Read-only IO implementation which maps the whole file into memory.
+//!         Importers can access the mapping directly via GetMappedData()
+//!         instead of copying the file into a buffer of their own.
+//!         The mapping is read-only, data which is modified later on
+//!         has to be copied out of it.
+class ASSIMP_API MMapIOStream : public IOStream
+{
+protected:
+    MMapIOStream();
+
+public:
+    // -------------------------------------------------------------------
+    /// Map the given file into memory
+    /// @return NULL if the file cannot be mapped, i.e. it is empty
+    static MMapIOStream* Open(const char* pFile);
+
+    /** Destructor public to allow simple deletion to unmap the file. */
+    ~MMapIOStream();
+
+    // -------------------------------------------------------------------
+    /// Read from stream
+    size_t Read(void* pvBuffer,
+        size_t pSize,
+        size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Write to stream, always fails
+    size_t Write(const void* pvBuffer,
+        size_t pSize,
+        size_t pCount);
+
+    // -------------------------------------------------------------------
+    /// Seek specific position
+    aiReturn Seek(size_t pOffset,
+        aiOrigin pOrigin);
+
+    // -------------------------------------------------------------------
+    /// Get current seek position
+    size_t Tell() const;
+
+    // -------------------------------------------------------------------
+    /// Get size of file
+    size_t FileSize() const;
+
+    // -------------------------------------------------------------------
+    /// Flush file contents, nothing to do
+    void Flush();
+
+    // -------------------------------------------------------------------
+    /// Get the mapped file contents
+    const void* GetMappedData() const;
+
+private:
+    //  Start of the mapping
+    const uint8_t* mData;
+
+    //  Size of the file and current read position
+    size_t mLength, mPos;
+
+#ifdef _WIN32
+    //  Win32 file and file mapping handles
+    void* mFile;
+    void* mMapping;
+#endif
+};
+
+} // ns assimp
+
+#endif //!!AI_MMAPIOSTREAM_H_INC
@@ -50,9 +50,112 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include "Macros.h"
+#include <vector>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Hash table from key, semantic and index to the position of a property in
+// aiMaterial::mProperties, stored in aiMaterial::mPrivate. It is only written
+// by the aiMaterial members which modify the properties, so concurrent
+// lookups are fine. Code which writes the arrays directly leaves the table
+// stale, which is detected by the array pointer and the number of properties.
+struct MaterialPropertyIndex
+{
+    //! Property array the positions refer to
+    const aiMaterialProperty* const* mProperties;
+    //! Number of properties in the table
+    unsigned int mNumProperties;
+    //! Open addressing slots, UINT_MAX marks an empty slot
+    std::vector<unsigned int> mSlots;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Combine key, semantic and index into one hash, like ComputeMaterialHash() does
+uint32_t HashPropertyKey(const char* pKey, size_t pKeyLength, unsigned int type, unsigned int index)
+{
+    uint32_t hash = SuperFastHash(pKey, (unsigned int)pKeyLength);
+    hash = SuperFastHash((const char*)&type, sizeof(unsigned int), hash);
+    return SuperFastHash((const char*)&index, sizeof(unsigned int), hash);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsMatchingProperty(const aiMaterialProperty* prop, const char* pKey,
+    unsigned int type, unsigned int index)
+{
+    return prop /* just for safety */ && prop->mSemantic == type && prop->mIndex == index
+        && 0 == strcmp( prop->mKey.data, pKey );
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the lookup table of a material if it matches the property array
+const MaterialPropertyIndex* GetValidIndex(const aiMaterial* pMat)
+{
+    const MaterialPropertyIndex* idx = static_cast<const MaterialPropertyIndex*>( pMat->mPrivate );
+    if (idx && idx->mProperties == pMat->mProperties && idx->mNumProperties == pMat->mNumProperties) {
+        return idx;
+    }
+    return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the slot holding the property or the empty slot it would be stored in
+unsigned int FindSlot(const MaterialPropertyIndex& idx, const char* pKey,
+    unsigned int type, unsigned int index)
+{
+    const unsigned int mask = (unsigned int)idx.mSlots.size() - 1;
+    unsigned int slot = HashPropertyKey(pKey, strlen(pKey), type, index) & mask;
+    for (;;) {
+        const unsigned int pos = idx.mSlots[slot];
+        if (UINT_MAX == pos || IsMatchingProperty(idx.mProperties[pos], pKey, type, index)) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Fills the lookup table from scratch. The first property wins if there are duplicates,
+// just as for the linear search.
+void BuildIndex(MaterialPropertyIndex& idx, const aiMaterial* pMat)
+{
+    idx.mProperties = pMat->mProperties;
+    idx.mNumProperties = pMat->mNumProperties;
+
+    // keep the load factor below 0.5
+    size_t numSlots = 16;
+    while (numSlots < 2 * (size_t)pMat->mNumProperties) {
+        numSlots *= 2;
+    }
+    idx.mSlots.assign(numSlots, UINT_MAX);
+
+    for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+        const aiMaterialProperty* prop = pMat->mProperties[i];
+        if (prop) {
+            const unsigned int slot = FindSlot(idx, prop->mKey.data, prop->mSemantic, prop->mIndex);
+            if (UINT_MAX == idx.mSlots[slot]) {
+                idx.mSlots[slot] = i;
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::UpdateMaterialIndex(aiMaterial* pMat)
+{
+    ai_assert(NULL != pMat);
+
+    MaterialPropertyIndex* idx = static_cast<MaterialPropertyIndex*>( pMat->mPrivate );
+    if (!idx) {
+        pMat->mPrivate = idx = new MaterialPropertyIndex();
+    }
+    BuildIndex(*idx, pMat);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
@@ -65,10 +168,15 @@ aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
     ai_assert (pKey != NULL);
     ai_assert (pPropOut != NULL);
 
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+    // Use the lookup table unless there are wildcards or the table is stale
+    const MaterialPropertyIndex* idx = GetValidIndex(pMat);
+    if (idx && UINT_MAX != type && UINT_MAX != index) {
+        const unsigned int pos = idx->mSlots[FindSlot(*idx, pKey, type, index)];
+        *pPropOut = UINT_MAX == pos ? NULL : pMat->mProperties[pos];
+        return UINT_MAX == pos ? AI_FAILURE : AI_SUCCESS;
+    }
+
+    /*  Just search for a property with exactly this name .. */
     for ( unsigned int i = 0; i < pMat->mNumProperties; ++i ) {
         aiMaterialProperty* prop = pMat->mProperties[i];
 
@@ -388,7 +496,8 @@ static const unsigned int DefaultNumAllocated = 5;
 aiMaterial::aiMaterial() 
 : mProperties( NULL )
 , mNumProperties( 0 )
-, mNumAllocated( DefaultNumAllocated ) {
+, mNumAllocated( DefaultNumAllocated )
+, mPrivate( NULL ) {
     // Allocate 5 entries by default
     mProperties = new aiMaterialProperty*[ DefaultNumAllocated ];
 }
@@ -399,6 +508,7 @@ aiMaterial::~aiMaterial()
     Clear();
 
     delete[] mProperties;
+    delete static_cast<MaterialPropertyIndex*>( mPrivate );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -412,6 +522,8 @@ void aiMaterial::Clear()
     mNumProperties = 0;
 
     // The array remains allocated, we just invalidated its contents
+    delete static_cast<MaterialPropertyIndex*>( mPrivate );
+    mPrivate = NULL;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -435,6 +547,11 @@ aiReturn aiMaterial::RemoveProperty (const char* pKey,unsigned int type,
             for (unsigned int a = i; a < mNumProperties;++a)    {
                 mProperties[a] = mProperties[a+1];
             }
+
+            // the positions behind have changed
+            if (mPrivate) {
+                Assimp::UpdateMaterialIndex(this);
+            }
             return AI_SUCCESS;
         }
     }
@@ -455,17 +572,18 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     ai_assert (pKey != NULL);
     ai_assert (0 != pSizeInBytes);
 
-    // first search the list whether there is already an entry with this key
-    unsigned int iOutIndex = UINT_MAX;
-    for (unsigned int i = 0; i < mNumProperties;++i)    {
-        aiMaterialProperty* prop = mProperties[i];
-
-        if (prop /* just for safety */ && !strcmp( prop->mKey.data, pKey ) &&
-            prop->mSemantic == type && prop->mIndex == index){
+    // the lookup table is created with the first property
+    if (!GetValidIndex(this)) {
+        Assimp::UpdateMaterialIndex(this);
+    }
+    MaterialPropertyIndex* idx = static_cast<MaterialPropertyIndex*>( mPrivate );
 
-            delete mProperties[i];
-            iOutIndex = i;
-        }
+    // first search the table whether there is already an entry with this key
+    unsigned int iOutIndex = UINT_MAX;
+    const unsigned int slot = FindSlot(*idx, pKey, type, index);
+    if (UINT_MAX != idx->mSlots[slot]) {
+        iOutIndex = idx->mSlots[slot];
+        delete mProperties[iOutIndex];
     }
 
     // Allocate a new material property
@@ -507,9 +625,17 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
 
         delete[] mProperties;
         mProperties = ppTemp;
+        idx->mProperties = mProperties;
     }
     // push back ...
+    idx->mSlots[slot] = mNumProperties;
     mProperties[mNumProperties++] = pcNew;
+    idx->mNumProperties = mNumProperties;
+
+    // grow the table before it gets too crowded
+    if (2 * (size_t)mNumProperties > idx->mSlots.size()) {
+        BuildIndex(*idx, this);
+    }
     return AI_SUCCESS;
 }
 
@@ -620,4 +746,6 @@ void aiMaterial::CopyPropertyList(aiMaterial* pcDest,
         prop->mData = new char[propSrc->mDataLength];
         memcpy(prop->mData,propSrc->mData,prop->mDataLength);
     }
+
+    Assimp::UpdateMaterialIndex(pcDest);
 }
@@ -64,6 +64,15 @@ namespace Assimp    {
  */
 uint32_t ComputeMaterialHash(const aiMaterial* mat, bool includeMatName = false);
 
+// ------------------------------------------------------------------------------
+/** Rebuilds the internal lookup table of a material.
+ *  Needs to be called after the property array of the material has been
+ *  written directly, else property lookups fall back to a linear search.
+ *
+ *  @param  mat Material to update
+ */
+void UpdateMaterialIndex(aiMaterial* mat);
+
 
 } // ! namespace Assimp
 
@@ -135,6 +135,12 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // The whole buffer is in memory anyways
+    const void* GetMappedData() const {
+        return buffer;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
@@ -150,20 +150,20 @@ void OFFImporter::InternReadFile( const std::string& pFile,
 
     std::vector<aiVector3D> tempPositions(numVertices);
 
-    // now read all vertex lines
+    // now read all vertex lines, straight from the buffer
     for (unsigned int i = 0; i< numVertices;++i)
     {
-        if(!GetNextLine(buffer,line))
+        if('\0' == *buffer)
         {
             DefaultLogger::get()->error("OFF: The number of verts in the header is incorrect");
             break;
         }
-        aiVector3D& v = tempPositions[i];
-
-        sz = line; SkipSpaces(&sz);
-        sz = fast_atoreal_move<ai_real>(sz,(ai_real&)v.x); SkipSpaces(&sz);
-        sz = fast_atoreal_move<ai_real>(sz,(ai_real&)v.y); SkipSpaces(&sz);
-        fast_atoreal_move<ai_real>(sz,(ai_real&)v.z);
+        ai_real coords[3];
+        if (ReadRealArray(buffer, coords, 3, true) < 3) {
+            throw DeadlyImportError("OFF: Expected three coordinates per vertex");
+        }
+        tempPositions[i].Set(coords[0], coords[1], coords[2]);
+        SkipLine(&buffer);
     }
 
 
@@ -171,13 +171,14 @@ void OFFImporter::InternReadFile( const std::string& pFile,
     const char* old = buffer;
     for (unsigned int i = 0; i< mesh->mNumFaces;++i)
     {
-        if(!GetNextLine(buffer,line))
+        if('\0' == *buffer)
         {
             DefaultLogger::get()->error("OFF: The number of faces in the header is incorrect");
             break;
         }
-        sz = line;SkipSpaces(&sz);
-        faces->mNumIndices = strtoul10(sz,&sz);
+        SkipSpaces(&buffer);
+        faces->mNumIndices = strtoul10(buffer);
+        SkipLine(&buffer);
         if(!(faces->mNumIndices) || faces->mNumIndices > 9)
         {
             DefaultLogger::get()->error("OFF: Faces with zero indices aren't allowed");
@@ -198,21 +199,23 @@ void OFFImporter::InternReadFile( const std::string& pFile,
     // second: now parse all face indices
     buffer = old;
     faces = mesh->mFaces;
-    for (unsigned int i = 0, p = 0; i< mesh->mNumFaces;)
+    for (unsigned int i = 0, p = 0; i< mesh->mNumFaces; SkipLine(&buffer))
     {
-        if(!GetNextLine(buffer,line))break;
-
-        unsigned int idx;
-        sz = line;SkipSpaces(&sz);
-        idx = strtoul10(sz,&sz);
-        if(!(idx) || idx > 9)
+        if('\0' == *buffer)break;
+
+        // missing indices are read as zero
+        unsigned int indices[10] = {0};
+        const size_t numIndices = ReadNumberArray(buffer, indices, 10, [](const char* c, unsigned int& value) {
+            value = strtoul10(c, &c);
+            return c;
+        }, true);
+        if(!numIndices || !(indices[0]) || indices[0] > 9)
             continue;
 
         faces->mIndices = new unsigned int [faces->mNumIndices];
         for (unsigned int m = 0; m < faces->mNumIndices;++m)
         {
-            SkipSpaces(&sz);
-            idx = strtoul10(sz,&sz);
+            unsigned int idx = indices[m + 1];
             if ((idx) >= numVertices)
             {
                 DefaultLogger::get()->error("OFF: Vertex index is out of range");
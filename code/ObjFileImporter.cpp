@@ -76,7 +76,9 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
     m_Buffer(),
     m_pRootObject( NULL ),
-    m_strAbsPath( "" )
+    m_strAbsPath( "" ),
+    m_numThreads( 1 ),
+    m_poolFaceIndices( false )
 {
     DefaultIOSystem io;
     m_strAbsPath = io.getOsSeparator();
@@ -105,6 +107,15 @@ bool ObjFileImporter::CanRead( const std::string& pFile, IOSystem*  pIOHandler ,
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Setup configuration properties for the loader
+void ObjFileImporter::SetupProperties(const Importer* pImp)
+{
+    const int numThreads = pImp->GetPropertyInteger( AI_CONFIG_IMPORT_OBJ_NUM_THREADS, 1 );
+    m_numThreads = numThreads < 0 ? 1 : static_cast<unsigned int>( numThreads );
+    m_poolFaceIndices = pImp->GetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, false );
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc* ObjFileImporter::GetInfo () const
 {
@@ -179,7 +190,7 @@ void ObjFileImporter::InternReadFile( const std::string &file, aiScene* pScene,
     m_progress->UpdateFileRead(1, 3);
 
     // parse the file into a temporary representation
-    ObjFileParser parser( streamedBuffer, modelName, pIOHandler, m_progress, file);
+    ObjFileParser parser( streamedBuffer, modelName, pIOHandler, m_progress, file, m_numThreads, m_scheduler );
 
     // And create the proper return structures out of it
     CreateDataFromImport(parser.GetModel(), pScene);
@@ -357,7 +368,9 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
                 for(size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
                     aiFace& f = pMesh->mFaces[ outIndex++ ];
                     uiIdxCount += f.mNumIndices = 2;
-                    f.mIndices = new unsigned int[2];
+                    if (!m_poolFaceIndices) {
+                        f.mIndices = new unsigned int[2];
+                    }
                 }
                 continue;
             }
@@ -365,7 +378,9 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
                 for(size_t i = 0; i < inp->m_vertices.size(); ++i) {
                     aiFace& f = pMesh->mFaces[ outIndex++ ];
                     uiIdxCount += f.mNumIndices = 1;
-                    f.mIndices = new unsigned int[1];
+                    if (!m_poolFaceIndices) {
+                        f.mIndices = new unsigned int[1];
+                    }
                 }
                 continue;
             }
@@ -373,10 +388,14 @@ aiMesh *ObjFileImporter::createTopology( const ObjFile::Model* pModel, const Obj
             aiFace *pFace = &pMesh->mFaces[ outIndex++ ];
             const unsigned int uiNumIndices = (unsigned int) pObjMesh->m_Faces[ index ]->m_vertices.size();
             uiIdxCount += pFace->mNumIndices = (unsigned int) uiNumIndices;
-            if (pFace->mNumIndices > 0) {
+            if (pFace->mNumIndices > 0 && !m_poolFaceIndices) {
                 pFace->mIndices = new unsigned int[ uiNumIndices ];
             }
         }
+
+        if (m_poolFaceIndices) {
+            pMesh->PoolFaceIndices();
+        }
     }
 
     // Create mesh vertices
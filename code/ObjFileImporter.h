@@ -71,6 +71,10 @@ public:
     /// \remark See BaseImporter::CanRead() for details.
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /// \brief  Reads the importer configuration.
+    /// \remark See BaseImporter::SetupProperties() for details.
+    void SetupProperties(const Importer* pImp);
+
 private:
     //! \brief  Appends the supported extension.
     const aiImporterDesc* GetInfo () const;
@@ -112,6 +116,10 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Number of threads for parsing vertex data
+    unsigned int m_numThreads;
+    //! Keep all face indices of a mesh in one pool
+    bool m_poolFaceIndices;
 };
 
 // ------------------------------------------------------------------------------------------------
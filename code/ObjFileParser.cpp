@@ -47,27 +47,50 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "DefaultIOSystem.h"
 #include "BaseImporter.h"
+#include "TaskScheduler.h"
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/material.h>
 #include <assimp/Importer.hpp>
 #include <cstdlib>
+#include <algorithm>
 
 namespace Assimp {
 
 const std::string ObjFileParser::DEFAULT_MATERIAL = AI_DEFAULT_MATERIAL_NAME;
 
+// Kinds of deferred vertex records
+enum DeferredVertexType {
+    DeferredPosition,       // v x y z
+    DeferredHomogeneous,    // v x y z w
+    DeferredPositionColor,  // v x y z r g b
+    DeferredTexCoord,       // vt u v [w]
+    DeferredNormal          // vn x y z
+};
+
+// Size of the deferred vertex text which triggers parsing, keeps the memory bounded
+static const size_t DeferredTextLimit = 16 * 1024 * 1024;
+
+// Number of deferred vertex records parsed as a single task
+static const size_t DeferredRecordsPerTask = 4096;
+
 // -------------------------------------------------------------------
 //  Constructor with loaded data and directories.
 ObjFileParser::ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::string &modelName, 
                               IOSystem *io, ProgressHandler* progress,
-                              const std::string &originalObjFileName) :
+                              const std::string &originalObjFileName,
+                              unsigned int numThreads,
+                              TaskScheduler* scheduler ) :
     m_DataIt(),
     m_DataItEnd(),
     m_pModel(NULL),
     m_uiLine(0),
     m_pIO( io ),
     m_progress(progress),
-    m_originalObjFileName(originalObjFileName)
+    m_originalObjFileName(originalObjFileName),
+    m_numThreads(numThreads),
+    m_scheduler(scheduler),
+    m_deferredVertices(),
+    m_deferredText()
 {
     std::fill_n(m_buffer,Buffersize,0);
 
@@ -110,6 +133,9 @@ void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
     unsigned int processed = 0;
     size_t lastFilePos( 0 );
 
+    // vertex records are collected and parsed in parallel if requested
+    const bool deferred = 1 != m_numThreads;
+
     std::vector<char> buffer;
     while ( streamBuffer.getNextLine( buffer ) ) {
         m_DataIt = buffer.begin();
@@ -133,22 +159,46 @@ void ObjFileParser::parseFile( IOStreamBuffer<char> &streamBuffer ) {
                     size_t numComponents = getNumComponentsInLine();
                     if (numComponents == 3) {
                         // read in vertex definition
-                        getVector3(m_pModel->m_Vertices);
+                        if (deferred) {
+                            deferVertex(DeferredPosition, numComponents);
+                        } else {
+                            getVector3(m_pModel->m_Vertices);
+                        }
                     } else if (numComponents == 4) {
                         // read in vertex definition (homogeneous coords)
-                        getHomogeneousVector3(m_pModel->m_Vertices);
+                        if (deferred) {
+                            deferVertex(DeferredHomogeneous, numComponents);
+                        } else {
+                            getHomogeneousVector3(m_pModel->m_Vertices);
+                        }
                     } else if (numComponents == 6) {
                         // read vertex and vertex-color
-                        getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
+                        if (deferred) {
+                            deferVertex(DeferredPositionColor, numComponents);
+                        } else {
+                            getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
+                        }
                     }
                 } else if (*m_DataIt == 't') {
                     // read in texture coordinate ( 2D or 3D )
                     ++m_DataIt;
-                    getVector( m_pModel->m_TextureCoord );
+                    if (deferred) {
+                        const size_t numComponents = getNumComponentsInLine();
+                        if (2 != numComponents && 3 != numComponents) {
+                            throw DeadlyImportError( "OBJ: Invalid number of components" );
+                        }
+                        deferVertex(DeferredTexCoord, numComponents);
+                    } else {
+                        getVector( m_pModel->m_TextureCoord );
+                    }
                 } else if (*m_DataIt == 'n') {
                     // Read in normal vector definition
                     ++m_DataIt;
-                    getVector3( m_pModel->m_Normals );
+                    if (deferred) {
+                        deferVertex(DeferredNormal, 3);
+                    } else {
+                        getVector3( m_pModel->m_Normals );
+                    }
                 }
             }
             break;
@@ -220,6 +270,119 @@ pf_skip_line:
             break;
         }
     }
+
+    flushDeferredVertices();
+}
+
+// -------------------------------------------------------------------
+//  Reserve the slots of a vertex record and keep its text for later
+void ObjFileParser::deferVertex( int type, size_t numComponents ) {
+    // The slots are reserved right now, so face indices which are
+    // relative to the end of the arrays remain valid.
+    DeferredVertex record;
+    record.m_type = type;
+    record.m_numComponents = static_cast<unsigned int>( numComponents );
+    record.m_textOffset = m_deferredText.size();
+    record.m_colorIndex = 0;
+    switch ( type ) {
+    case DeferredTexCoord:
+        record.m_index = m_pModel->m_TextureCoord.size();
+        m_pModel->m_TextureCoord.push_back( aiVector3D() );
+        break;
+    case DeferredNormal:
+        record.m_index = m_pModel->m_Normals.size();
+        m_pModel->m_Normals.push_back( aiVector3D() );
+        break;
+    case DeferredPositionColor:
+        // the color array may be shorter than the vertex array
+        record.m_colorIndex = m_pModel->m_VertexColors.size();
+        m_pModel->m_VertexColors.push_back( aiVector3D() );
+        // fallthrough
+    default:
+        record.m_index = m_pModel->m_Vertices.size();
+        m_pModel->m_Vertices.push_back( aiVector3D() );
+        break;
+    }
+    m_deferredVertices.push_back( record );
+
+    // copy the rest of the line, parsing stops at the line end
+    DataArrayIt end = m_DataIt;
+    while ( end != m_DataItEnd && !IsLineEnd( *end ) ) {
+        ++end;
+    }
+    m_deferredText.insert( m_deferredText.end(), m_DataIt, end );
+    m_deferredText.push_back( '\n' );
+    m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+
+    if ( m_deferredText.size() >= DeferredTextLimit ) {
+        flushDeferredVertices();
+    }
+}
+
+// -------------------------------------------------------------------
+//  Parse the next number of a deferred vertex record
+static const char *parseNextReal( const char *it, ai_real &value ) {
+    while ( IsSpace( *it ) ) {
+        ++it;
+    }
+    it = fast_atoreal_move<ai_real>( it, value );
+
+    // skip the rest of the token just like copyNextWord() does
+    while ( !IsSpaceOrNewLine( *it ) ) {
+        ++it;
+    }
+    return it;
+}
+
+// -------------------------------------------------------------------
+//  Parse all deferred vertex records
+void ObjFileParser::flushDeferredVertices() {
+    const size_t numRecords = m_deferredVertices.size();
+    if ( 0 == numRecords ) {
+        return;
+    }
+
+    // The text and the target arrays don't change anymore, so every
+    // thread can work on a range of records of its own.
+    auto parseRecords = [ this ]( size_t begin, size_t end ) {
+        for ( size_t i = begin; i < end; ++i ) {
+            const DeferredVertex &record = m_deferredVertices[ i ];
+            const char *it = &m_deferredText[ record.m_textOffset ];
+            ai_real v[ 6 ] = { 0 };
+            for ( unsigned int c = 0; c < record.m_numComponents; ++c ) {
+                it = parseNextReal( it, v[ c ] );
+            }
+
+            switch ( record.m_type ) {
+            case DeferredPosition:
+                m_pModel->m_Vertices[ record.m_index ] = aiVector3D( v[ 0 ], v[ 1 ], v[ 2 ] );
+                break;
+            case DeferredHomogeneous:
+                ai_assert( v[ 3 ] != 0 );
+                m_pModel->m_Vertices[ record.m_index ] = aiVector3D( v[ 0 ] / v[ 3 ], v[ 1 ] / v[ 3 ], v[ 2 ] / v[ 3 ] );
+                break;
+            case DeferredPositionColor:
+                m_pModel->m_Vertices[ record.m_index ] = aiVector3D( v[ 0 ], v[ 1 ], v[ 2 ] );
+                m_pModel->m_VertexColors[ record.m_colorIndex ] = aiVector3D( v[ 3 ], v[ 4 ], v[ 5 ] );
+                break;
+            case DeferredTexCoord:
+                m_pModel->m_TextureCoord[ record.m_index ] = aiVector3D( v[ 0 ], v[ 1 ], v[ 2 ] );
+                break;
+            case DeferredNormal:
+                m_pModel->m_Normals[ record.m_index ] = aiVector3D( v[ 0 ], v[ 1 ], v[ 2 ] );
+                break;
+            }
+        }
+    };
+
+    const size_t numTasks = ( numRecords + DeferredRecordsPerTask - 1 ) / DeferredRecordsPerTask;
+    TaskScheduler::ParallelFor( m_scheduler, numTasks, [ &parseRecords, numRecords ]( size_t task ) {
+        const size_t begin = task * DeferredRecordsPerTask;
+        parseRecords( begin, std::min( numRecords, begin + DeferredRecordsPerTask ) );
+    }, m_numThreads );
+
+    m_deferredVertices.clear();
+    m_deferredText.clear();
 }
 
 // -------------------------------------------------------------------
@@ -255,27 +418,15 @@ size_t ObjFileParser::getNumComponentsInLine() {
 
 void ObjFileParser::getVector( std::vector<aiVector3D> &point3d_array ) {
     size_t numComponents = getNumComponentsInLine();
-    ai_real x, y, z;
-    if( 2 == numComponents ) {
-        copyNextWord( m_buffer, Buffersize );
-        x = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        y = ( ai_real ) fast_atof( m_buffer );
-        z = 0.0;
-    } else if( 3 == numComponents ) {
-        copyNextWord( m_buffer, Buffersize );
-        x = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        y = ( ai_real ) fast_atof( m_buffer );
-
-        copyNextWord( m_buffer, Buffersize );
-        z = ( ai_real ) fast_atof( m_buffer );
-    } else {
+    if( 2 != numComponents && 3 != numComponents ) {
         throw DeadlyImportError( "OBJ: Invalid number of components" );
     }
-    point3d_array.push_back( aiVector3D( x, y, z ) );
+
+    // parse straight from the buffer like the deferred records do
+    ai_real values[ 3 ] = { 0.0, 0.0, 0.0 };
+    const char *it = &m_DataIt[ 0 ];
+    ReadNumberArray( it, values, numComponents, parseNextReal, true );
+    point3d_array.push_back( aiVector3D( values[ 0 ], values[ 1 ], values[ 2 ] ) );
     m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
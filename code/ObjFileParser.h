@@ -61,6 +61,7 @@ namespace ObjFile {
 class ObjFileImporter;
 class IOSystem;
 class ProgressHandler;
+class TaskScheduler;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -73,7 +74,10 @@ public:
 
 public:
     /// \brief  Constructor with data array.
-    ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::string &strModelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName);
+    /// \param numThreads  Number of threads to parse vertex records with, 0 for all
+    ///                     threads of the scheduler. 1 parses everything in order.
+    /// \param scheduler   Task scheduler to run on, may be NULL.
+    ObjFileParser( IOStreamBuffer<char> &streamBuffer, const std::string &strModelName, IOSystem* io, ProgressHandler* progress, const std::string &originalObjFileName, unsigned int numThreads = 1, TaskScheduler* scheduler = NULL);
     /// \brief  Destructor
     ~ObjFileParser();
     /// \brief  Model getter.
@@ -126,6 +130,10 @@ private:
     void reportErrorTokenInFace();
     /// Get the number of components in a line.
     size_t getNumComponentsInLine();
+    /// Stores the vertex record of the current line for parallel parsing.
+    void deferVertex( int type, size_t numComponents );
+    /// Parses all deferred vertex records into their reserved slots.
+    void flushDeferredVertices();
 
 private:
     // Copy and assignment constructor should be private
@@ -152,6 +160,28 @@ private:
     /// Path to the current model
     // name of the obj file where the buffer comes from
     const std::string& m_originalObjFileName;
+
+    /// A vertex record whose numbers are parsed later on, see deferVertex()
+    struct DeferredVertex {
+        /// Kind of the record, decides the target array(s)
+        int m_type;
+        /// Number of components on the line
+        unsigned int m_numComponents;
+        /// Offset of the line in m_deferredText
+        size_t m_textOffset;
+        /// Index of the reserved slot in the target array
+        size_t m_index;
+        /// Index of the reserved vertex color slot, if any
+        size_t m_colorIndex;
+    };
+    //! Number of threads used for vertex records, 1 for in-order parsing
+    unsigned int m_numThreads;
+    //! Task scheduler of the importer, may be NULL
+    TaskScheduler* m_scheduler;
+    //! Deferred vertex records in file order
+    std::vector<DeferredVertex> m_deferredVertices;
+    //! Text of the deferred vertex records, one line each
+    std::vector<char> m_deferredText;
 };
 
 }   // Namespace Assimp
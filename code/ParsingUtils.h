@@ -47,7 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "StringComparison.h"
 #include "StringUtils.h"
+#include "fast_atof.h"
 #include <assimp/defs.h>
+#include <vector>
 
 namespace Assimp {
 
@@ -243,6 +245,75 @@ AI_FORCE_INLINE std::string GetNextToken(const char*& in)
     return std::string(cur,(size_t)(in-cur));
 }
 
+// ---------------------------------------------------------------------------------
+/** @brief Reads numbers separated by spaces, tabs and line breaks into an array
+ *  @param in Input, points behind the last number read afterwards
+ *  @param out Receives at most max values
+ *  @param max Maximum number of values to read
+ *  @param parse Reads a single number, same signature as fast_atoreal_move
+ *  @param stopAtLineEnd Stop at the end of the current line, not at the end of the text
+ *  @return Number of values read. Less than max if the text ended early or
+ *    parse() didn't consume anything.
+ */
+template <class T, class Parser>
+AI_FORCE_INLINE size_t ReadNumberArray(const char*& in, T* out, size_t max, Parser parse,
+    bool stopAtLineEnd = false)
+{
+    size_t count = 0;
+    while (count < max && (stopAtLineEnd ? SkipSpaces(&in) : SkipSpacesAndLineEnd(&in))) {
+        const char* next = parse(in, out[count]);
+        if (next == in) {
+            break;
+        }
+        in = next;
+        ++count;
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------------
+/** @brief Appends all numbers up to the end of the text to a list
+ *  @see ReadNumberArray
+ */
+template <class T, class Parser>
+AI_FORCE_INLINE void ReadNumberList(const char*& in, std::vector<T>& out, Parser parse)
+{
+    T value;
+    while (SkipSpacesAndLineEnd(&in)) {
+        const char* next = parse(in, value);
+        if (next == in) {
+            break;
+        }
+        in = next;
+        out.push_back(value);
+    }
+}
+
+// ---------------------------------------------------------------------------------
+/** @brief Reads real numbers into an array, throws if one of them is malformed
+ *  @see ReadNumberArray
+ */
+template <class Real>
+AI_FORCE_INLINE size_t ReadRealArray(const char*& in, Real* out, size_t max,
+    bool stopAtLineEnd = false, bool check_comma = true)
+{
+    return ReadNumberArray(in, out, max, [check_comma](const char* c, Real& value) {
+        return fast_atoreal_move<Real>(c, value, check_comma);
+    }, stopAtLineEnd);
+}
+
+// ---------------------------------------------------------------------------------
+/** @brief Appends all real numbers up to the end of the text to a list
+ *  @see ReadNumberArray
+ */
+template <class Real>
+AI_FORCE_INLINE void ReadRealList(const char*& in, std::vector<Real>& out, bool check_comma = true)
+{
+    ReadNumberList(in, out, [check_comma](const char* c, Real& value) {
+        return fast_atoreal_move<Real>(c, value, check_comma);
+    });
+}
+
 // ---------------------------------------------------------------------------------
 
 } // ! namespace Assimp
@@ -48,9 +48,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "PlyLoader.h"
 #include "Macros.h"
+#include "ScenePrivate.h"
+#include "ByteSwapper.h"
 #include <memory>
+#include <algorithm>
+#include <climits>
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
 
 
 using namespace Assimp;
@@ -84,6 +89,70 @@ namespace
 
         return props[idx];
     }
+
+    // ------------------------------------------------------------------------------------------------
+    // A scalar vertex property of a binary file and where to store its values
+    struct BinaryChannel
+    {
+        unsigned int iOffset;
+        PLY::EDataType eType;
+        ai_real (*pConvert)(PLY::PropertyInstance::ValueUnion, PLY::EDataType);
+        ai_real* pOut;
+        unsigned int iOutStride;
+    };
+
+    // ------------------------------------------------------------------------------------------------
+    // Decodes all channels of a list of binary vertex records. If all values of a record have the
+    // same size, big-endian records are swapped in batches before the channels are picked from them.
+    void ReadBinaryVertices(const char* pCur, unsigned int iNum, unsigned int iStride,
+        unsigned int iValueSize, bool p_bBE, const std::vector<BinaryChannel>& channels)
+    {
+        static const unsigned int BatchSize = 1024;
+
+        const bool bBulkSwap = p_bBE && iValueSize > 1;
+        std::vector<char> batch(bBulkSwap ? BatchSize * iStride : 0);
+
+        for (unsigned int first = 0; first < iNum; first += BatchSize) {
+            const unsigned int n = std::min(BatchSize, iNum - first);
+            const char* pcRecords = pCur + static_cast<size_t>(first) * iStride;
+            if (bBulkSwap) {
+                ::memcpy(&batch[0], pcRecords, n * iStride);
+                ByteSwap::SwapArray(&batch[0], iValueSize, n * iStride / iValueSize);
+                pcRecords = &batch[0];
+            }
+            const bool bSwap = p_bBE && !bBulkSwap;
+
+            for (std::vector<BinaryChannel>::const_iterator c = channels.begin(); c != channels.end(); ++c) {
+                const char* pcValue = pcRecords + (*c).iOffset;
+                ai_real* pOut = (*c).pOut + static_cast<size_t>(first) * (*c).iOutStride;
+
+                // both conversions pass floats through unchanged
+                if (EDT_Float == (*c).eType && !bSwap) {
+                    for (unsigned int i = 0; i < n; ++i, pcValue += iStride, pOut += (*c).iOutStride) {
+                        float f;
+                        ::memcpy(&f, pcValue, sizeof(float));
+                        *pOut = f;
+                    }
+                    continue;
+                }
+                for (unsigned int i = 0; i < n; ++i, pcValue += iStride, pOut += (*c).iOutStride) {
+                    PLY::PropertyInstance::ValueUnion v;
+                    const char* pcNext;
+                    PLY::PropertyInstance::ParseValueBinary(pcValue, &pcNext, (*c).eType, &v, bSwap);
+                    *pOut = (*c).pConvert(v, (*c).eType);
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Reads a single binary value and converts it to a vertex index
+    inline unsigned int ReadBinaryIndex(const char*& pCur, PLY::EDataType eType, bool p_bBE)
+    {
+        PLY::PropertyInstance::ValueUnion v;
+        PLY::PropertyInstance::ParseValueBinary(pCur, &pCur, eType, &v, p_bBE);
+        return PLY::PropertyInstance::ConvertTo<unsigned int>(v, eType);
+    }
 }
 
 
@@ -91,7 +160,8 @@ namespace
 // Constructor to be privately used by Importer
 PLYImporter::PLYImporter()
 : mBuffer()
-, pcDOM(){
+, pcDOM()
+, configPoolFaceIndices(false){
     // empty
 }
 
@@ -124,6 +194,13 @@ const aiImporterDesc* PLYImporter::GetInfo () const
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void PLYImporter::SetupProperties(const Importer* pImp)
+{
+    configPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_POOL_FACE_INDICES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 static bool isBigEndian( const char* szMe ) {
     ai_assert( NULL != szMe );
@@ -144,6 +221,45 @@ static bool isBigEndian( const char* szMe ) {
     return isBigEndian;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Matches a token followed by a space within [szIn,end) and skips it
+static bool matchHeaderToken( const char*& szIn, const char* end, const char* token ) {
+    const size_t len = ::strlen( token );
+    if ( static_cast<size_t>( end - szIn ) <= len || ::strncmp( szIn, token, len ) || !IsSpaceOrNewLine( szIn[ len ] ) ) {
+        return false;
+    }
+    szIn += len;
+    while ( szIn != end && IsSpace( *szIn ) ) {
+        ++szIn;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether a buffer which is not terminated by zero can be parsed in place: the
+// header of binary files is terminated by end_header, the parser won't read beyond.
+static bool isCompleteBinaryPLY( const char* buffer, size_t length ) {
+    static const char endHeader[] = "end_header";
+
+    const char* end = buffer + length;
+    const char* header = std::search( buffer, end, endHeader, endHeader + sizeof( endHeader ) - 1 );
+    if ( header == end ) {
+        return false;
+    }
+
+    // the format line directly follows the magic number
+    const char* szMe = buffer + 3;
+    while ( szMe != header && IsSpaceOrNewLine( *szMe ) ) {
+        ++szMe;
+    }
+    if ( !matchHeaderToken( szMe, header, "format" ) ) {
+        return false;
+    }
+    const char* format = szMe;
+    return matchHeaderToken( szMe, header, "binary_little_endian" ) ||
+        matchHeaderToken( format, header, "binary_big_endian" );
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure.
 void PLYImporter::InternReadFile( const std::string& pFile,
@@ -156,10 +272,19 @@ void PLYImporter::InternReadFile( const std::string& pFile,
         throw DeadlyImportError( "Failed to open PLY file " + pFile + ".");
     }
 
-    // allocate storage and copy the contents of the file to a memory buffer
+    // binary files are parsed in place if the file is mapped into memory,
+    // otherwise allocate storage and copy the contents of the file to a memory buffer
     std::vector<char> mBuffer2;
-    TextFileToBuffer(file.get(),mBuffer2);
-    mBuffer = (unsigned char*)&mBuffer2[0];
+    const char* mapped = static_cast<const char*>(file->GetMappedData());
+    const char* end = NULL;
+    if (mapped && isCompleteBinaryPLY(mapped, file->FileSize())) {
+        mBuffer = (const unsigned char*)mapped;
+        end = mapped + file->FileSize();
+    } else {
+        TextFileToBuffer(file.get(),mBuffer2);
+        mBuffer = (const unsigned char*)&mBuffer2[0];
+        end = &mBuffer2[0] + mBuffer2.size();
+    }
 
     // the beginning of the file must be PLY - magic, magic
     if ((mBuffer[0] != 'P' && mBuffer[0] != 'p') ||
@@ -168,26 +293,37 @@ void PLYImporter::InternReadFile( const std::string& pFile,
         throw DeadlyImportError( "Invalid .ply file: Magic number \'ply\' is no there");
     }
 
-    char* szMe = (char*)&this->mBuffer[3];
+    const char* szMe = (const char*)&this->mBuffer[3];
     SkipSpacesAndLineEnd(szMe,(const char**)&szMe);
 
     // determine the format of the file data
     PLY::DOM sPlyDom;
+    std::vector<aiMesh*> avMeshes;
+    std::vector<aiMaterial*> avMaterials;
+    this->pcDOM = &sPlyDom;
     if (TokenMatch(szMe,"format",6)) {
         if (TokenMatch(szMe,"ascii",5)) {
             SkipLine(szMe,(const char**)&szMe);
             if(!PLY::DOM::ParseInstance(szMe,&sPlyDom))
                 throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#1)");
+            ConvertDOM(pScene,&avMeshes,&avMaterials);
         } else if (!::strncmp(szMe,"binary_",7))
         {
             szMe += 7;
             const bool bIsBE( isBigEndian( szMe ) );
 
-            // skip the line, parse the rest of the header and build the DOM
+            // skip the line and parse the rest of the header. Files with a simple
+            // layout are read directly, all others need the DOM to be built.
             SkipLine(szMe,(const char**)&szMe);
-            if ( !PLY::DOM::ParseInstanceBinary( szMe, &sPlyDom, bIsBE ) ) {
+            if ( !PLY::DOM::ParseHeaderBinary( szMe, &szMe, &sPlyDom ) ) {
                 throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#2)" );
             }
+            if ( !LoadBinaryDirect( pScene, szMe, end, bIsBE, &avMeshes, &avMaterials ) ) {
+                if ( !PLY::DOM::ParseElementDataBinary( szMe, &sPlyDom, bIsBE ) ) {
+                    throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#2)" );
+                }
+                ConvertDOM(pScene,&avMeshes,&avMaterials);
+            }
         } else {
             throw DeadlyImportError( "Invalid .ply file: Unknown file format" );
         }
@@ -197,8 +333,333 @@ void PLYImporter::InternReadFile( const std::string& pFile,
         AI_DEBUG_INVALIDATE_PTR(this->mBuffer);
         throw DeadlyImportError( "Invalid .ply file: Missing format specification");
     }
-    this->pcDOM = &sPlyDom;
 
+    if ( avMeshes.empty() ) {
+        throw DeadlyImportError( "Invalid .ply file: Unable to extract mesh data " );
+    }
+
+    // now generate the output scene object. Fill the material list
+    pScene->mNumMaterials = (unsigned int)avMaterials.size();
+    pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials];
+    for ( unsigned int i = 0; i < pScene->mNumMaterials; ++i ) {
+        pScene->mMaterials[ i ] = avMaterials[ i ];
+    }
+
+    // fill the mesh list
+    pScene->mNumMeshes = (unsigned int)avMeshes.size();
+    pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
+    for ( unsigned int i = 0; i < pScene->mNumMeshes; ++i ) {
+        pScene->mMeshes[ i ] = avMeshes[ i ];
+    }
+
+    // generate a simple node structure
+    pScene->mRootNode = new aiNode();
+    pScene->mRootNode->mNumMeshes = pScene->mNumMeshes;
+    pScene->mRootNode->mMeshes = new unsigned int[pScene->mNumMeshes];
+
+    for ( unsigned int i = 0; i < pScene->mRootNode->mNumMeshes; ++i ) {
+        pScene->mRootNode->mMeshes[ i ] = i;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Read binary element data straight into a mesh
+bool PLYImporter::LoadBinaryDirect(aiScene* pScene,
+    const char* pCur, const char* pEnd, bool p_bBE,
+    std::vector<aiMesh*>* avMeshes,
+    std::vector<aiMaterial*>* avMaterials)
+{
+    ai_assert(NULL != pcDOM);
+
+    // vertex properties by semantic, EST_XCoord to EST_Alpha. Like the DOM
+    // path this takes the first three coordinates and the first four color
+    // channels, for normals and texture coordinates the last one wins.
+    static const unsigned int NumSemantics = PLY::EST_Alpha + 1;
+    unsigned int aiOffsets[NumSemantics];
+    PLY::EDataType aiTypes[NumSemantics];
+    std::fill(aiTypes, aiTypes + NumSemantics, EDT_INVALID);
+    unsigned int aiCount[4] = {0, 0, 0, 0};
+    static const unsigned int aiGroup[NumSemantics] = {0, 0, 0, 1, 1, 1, 2, 2, 3, 3, 3, 3};
+    static const unsigned int aiLimit[4] = {3, UINT_MAX, UINT_MAX, 4};
+
+    // only vertex records without lists have a fixed size and can be read in bulk,
+    // faces must consist of the vertex index list and scalar properties
+    const PLY::Element* pcVertices = NULL;
+    const PLY::Element* pcFaces = NULL;
+    unsigned int iVertexSize = 0, iValueSize = 0;
+    unsigned int iFacePre = 0, iFacePost = 0;
+    std::vector<unsigned int> aiRecordSizes;
+    for (std::vector<PLY::Element>::const_iterator i = pcDOM->alElements.begin();
+        i != pcDOM->alElements.end();++i)
+    {
+        if (PLY::EEST_Material == (*i).eSemantic || PLY::EEST_TriStrip == (*i).eSemantic) {
+            return false;
+        }
+        const bool bVertex = PLY::EEST_Vertex == (*i).eSemantic;
+        const bool bFace = PLY::EEST_Face == (*i).eSemantic;
+        if ((bVertex && pcVertices) || (bFace && pcFaces)) {
+            return false;
+        }
+
+        const PLY::Property* pcList = NULL;
+        unsigned int iSize = 0;
+        for (std::vector<PLY::Property>::const_iterator a = (*i).alProperties.begin();
+            a != (*i).alProperties.end();++a)
+        {
+            const unsigned int iPropSize = PLY::Property::GetDataTypeSize((*a).eType);
+            if (0 == iPropSize) {
+                return false;
+            }
+            if ((*a).bIsList) {
+                if (!bFace || pcList || PLY::EST_VertexIndex != (*a).Semantic ||
+                    0 == PLY::Property::GetDataTypeSize((*a).eFirstType)) {
+                    return false;
+                }
+                pcList = &(*a);
+                continue;
+            }
+            if (bFace && PLY::EST_MaterialIndex == (*a).Semantic) {
+                return false;
+            }
+            if (bVertex && (*a).Semantic < NumSemantics) {
+                const unsigned int iGroup = aiGroup[(*a).Semantic];
+                if (aiCount[iGroup] < aiLimit[iGroup]) {
+                    ++aiCount[iGroup];
+                    aiOffsets[(*a).Semantic] = iSize;
+                    aiTypes[(*a).Semantic] = (*a).eType;
+                }
+            }
+            if (bVertex && (0 == iSize || iValueSize != iPropSize)) {
+                iValueSize = 0 == iSize ? iPropSize : 0;
+            }
+            iSize += iPropSize;
+            if (bFace && !pcList) {
+                iFacePre += iPropSize;
+            }
+        }
+        if (bVertex) {
+            pcVertices = &(*i);
+            iVertexSize = iSize;
+        }
+        if (bFace) {
+            if (!pcList) {
+                return false;
+            }
+            pcFaces = &(*i);
+            iFacePost = iSize - iFacePre;
+        }
+        aiRecordSizes.push_back(iSize);
+    }
+    if (!pcVertices || 0 == aiCount[0]) {
+        return false;
+    }
+
+    const PLY::Property* pcIndices = NULL;
+    if (pcFaces) {
+        for (std::vector<PLY::Property>::const_iterator a = pcFaces->alProperties.begin();
+            a != pcFaces->alProperties.end();++a) {
+            if ((*a).bIsList) {
+                pcIndices = &(*a);
+            }
+        }
+    }
+    const unsigned int iIndexSize = pcIndices ? PLY::Property::GetDataTypeSize(pcIndices->eType) : 0;
+    const unsigned int iCountSize = pcIndices ? PLY::Property::GetDataTypeSize(pcIndices->eFirstType) : 0;
+
+    // find the data of the vertices and faces and check that all of it is there
+    const char* pcVertexData = NULL;
+    const char* pcFaceData = NULL;
+    uint64_t iNumIndices = 0;
+    for (unsigned int e = 0; e < pcDOM->alElements.size(); ++e)
+    {
+        const PLY::Element& element = pcDOM->alElements[e];
+        if (&element == pcFaces) {
+            pcFaceData = pCur;
+            for (unsigned int f = 0; f < element.NumOccur; ++f) {
+                if (static_cast<size_t>(pEnd - pCur) < iFacePre + iCountSize) {
+                    throw DeadlyImportError( "Invalid .ply file: Unexpected end of binary face data" );
+                }
+                pCur += iFacePre;
+                const unsigned int iNum = ReadBinaryIndex(pCur, pcIndices->eFirstType, p_bBE);
+                if (static_cast<uint64_t>(pEnd - pCur) < static_cast<uint64_t>(iNum) * iIndexSize + iFacePost) {
+                    throw DeadlyImportError( "Invalid .ply file: Unexpected end of binary face data" );
+                }
+                pCur += static_cast<size_t>(iNum) * iIndexSize + iFacePost;
+                iNumIndices += iNum;
+            }
+            continue;
+        }
+        const uint64_t iSize = static_cast<uint64_t>(element.NumOccur) * aiRecordSizes[e];
+        if (static_cast<uint64_t>(pEnd - pCur) < iSize) {
+            throw DeadlyImportError( "Invalid .ply file: Unexpected end of binary element data" );
+        }
+        if (&element == pcVertices) {
+            pcVertexData = pCur;
+        }
+        pCur += static_cast<size_t>(iSize);
+    }
+    if (0 == pcVertices->NumOccur) {
+        throw DeadlyImportError( "Invalid .ply file: No vertices found. "
+            "Unable to parse the data format of the PLY file." );
+    }
+
+    // without faces, the vertex list is a list of triangles which is read
+    // straight into the mesh. Otherwise the vertices are gathered per face.
+    const bool bTriangles = !pcFaces || 0 == pcFaces->NumOccur;
+    if (bTriangles && pcVertices->NumOccur < 3) {
+        throw DeadlyImportError( "Invalid .ply file: Not enough "
+            "vertices to build a proper face list. ");
+    }
+    if (iNumIndices > UINT_MAX) {
+        throw DeadlyImportError( "Invalid .ply file: Too many vertex indices" );
+    }
+    const unsigned int iNumVertices = bTriangles ? pcVertices->NumOccur / 3 * 3 : static_cast<unsigned int>(iNumIndices);
+    const unsigned int iNumFaces = bTriangles ? iNumVertices / 3 : pcFaces->NumOccur;
+
+    avMaterials->push_back(CreateDefaultMaterial());
+    if (0 == iNumVertices) {
+        return true;
+    }
+
+    aiMesh* pcMesh = new aiMesh();
+    pcMesh->mMaterialIndex = 0;
+    pcMesh->mNumVertices = iNumVertices;
+    pcMesh->mNumFaces = iNumFaces;
+    pcMesh->mFaces = NewSceneArray<aiFace>(pScene, iNumFaces);
+    pcMesh->mVertices = NewSceneArray<aiVector3D>(pScene, iNumVertices);
+    if (aiCount[1]) {
+        pcMesh->mNormals = NewSceneArray<aiVector3D>(pScene, iNumVertices);
+    }
+    if (aiCount[2]) {
+        pcMesh->mNumUVComponents[0] = 2;
+        pcMesh->mTextureCoords[0] = NewSceneArray<aiVector3D>(pScene, iNumVertices);
+    }
+    if (aiCount[3]) {
+        pcMesh->mColors[0] = NewSceneArray<aiColor4D>(pScene, iNumVertices);
+    }
+    avMeshes->push_back(pcMesh);
+
+    // decode the vertex records into the mesh or into temporary arrays
+    const unsigned int iNumRecords = bTriangles ? iNumVertices : pcVertices->NumOccur;
+    std::vector<aiVector3D> avPositions, avNormals, avTexCoords;
+    std::vector<aiColor4D> avColors;
+    ai_real* apOut[4] = {NULL, NULL, NULL, NULL};
+    static const unsigned int aiOutStride[4] = {3, 3, 3, 4};
+    if (bTriangles) {
+        apOut[0] = &pcMesh->mVertices[0].x;
+        apOut[1] = aiCount[1] ? &pcMesh->mNormals[0].x : NULL;
+        apOut[2] = aiCount[2] ? &pcMesh->mTextureCoords[0][0].x : NULL;
+        apOut[3] = aiCount[3] ? &pcMesh->mColors[0][0].r : NULL;
+    } else {
+        avPositions.resize(iNumRecords);
+        apOut[0] = &avPositions[0].x;
+        if (aiCount[1]) {
+            avNormals.resize(iNumRecords);
+            apOut[1] = &avNormals[0].x;
+        }
+        if (aiCount[2]) {
+            avTexCoords.resize(iNumRecords);
+            apOut[2] = &avTexCoords[0].x;
+        }
+        if (aiCount[3]) {
+            avColors.resize(iNumRecords);
+            apOut[3] = &avColors[0].r;
+        }
+    }
+
+    std::vector<BinaryChannel> channels;
+    for (unsigned int i = 0; i < NumSemantics; ++i) {
+        const unsigned int iGroup = aiGroup[i];
+        if (EDT_INVALID == aiTypes[i] || !apOut[iGroup]) {
+            continue;
+        }
+        const unsigned int iFirst = iGroup == 3 ? PLY::EST_Red : (iGroup == 2 ? PLY::EST_UTextureCoord : 3 * iGroup);
+        BinaryChannel channel;
+        channel.iOffset = aiOffsets[i];
+        channel.eType = aiTypes[i];
+        channel.pConvert = iGroup == 3 ? &NormalizeColorValue : &PLY::PropertyInstance::ConvertTo<ai_real>;
+        channel.pOut = apOut[iGroup] + (i - iFirst);
+        channel.iOutStride = aiOutStride[iGroup];
+        channels.push_back(channel);
+    }
+    ReadBinaryVertices(pcVertexData, iNumRecords, iVertexSize, iValueSize, p_bBE, channels);
+
+    // assume 1.0 for the alpha channel if it is not set
+    if (apOut[3] && EDT_INVALID == aiTypes[PLY::EST_Alpha]) {
+        for (unsigned int i = 0; i < iNumRecords; ++i) {
+            apOut[3][i * 4 + 3] = 1.0;
+        }
+    }
+
+    // with an arena or pooled indices, all indices go into one block
+    SceneArena* arena = ScenePriv(pScene)->mArena;
+    unsigned int* indices = NULL;
+    if (arena) {
+        indices = arena->AllocateArray<unsigned int>(iNumVertices);
+    }
+    else if (configPoolFaceIndices) {
+        indices = new unsigned int[iNumVertices];
+    }
+    if (configPoolFaceIndices) {
+        pcMesh->mFaceIndices = indices;
+        pcMesh->mNumFaceIndices = iNumVertices;
+    }
+
+    if (bTriangles) {
+        for (unsigned int f = 0; f < iNumFaces; ++f) {
+            aiFace& face = pcMesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = indices ? indices + f * 3 : new unsigned int[3];
+            face.mIndices[0] = f * 3;
+            face.mIndices[1] = f * 3 + 1;
+            face.mIndices[2] = f * 3 + 2;
+        }
+        return true;
+    }
+
+    // build an unique set of vertices for each face, out of range
+    // indices are skipped the same way the DOM path does it
+    unsigned int iVertex = 0;
+    pCur = pcFaceData;
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        aiFace& face = pcMesh->mFaces[f];
+        pCur += iFacePre;
+        face.mNumIndices = ReadBinaryIndex(pCur, pcIndices->eFirstType, p_bBE);
+        if (indices) {
+            face.mIndices = indices;
+            indices += face.mNumIndices;
+        }
+        else face.mIndices = new unsigned int[face.mNumIndices];
+
+        for (unsigned int q = 0; q < face.mNumIndices; ++q) {
+            face.mIndices[q] = iVertex;
+            const unsigned int idx = ReadBinaryIndex(pCur, pcIndices->eType, p_bBE);
+            if (idx >= iNumRecords) {
+                continue;
+            }
+            pcMesh->mVertices[iVertex] = avPositions[idx];
+            if (!avColors.empty()) {
+                pcMesh->mColors[0][iVertex] = avColors[idx];
+            }
+            if (!avTexCoords.empty()) {
+                pcMesh->mTextureCoords[0][iVertex] = avTexCoords[idx];
+            }
+            if (!avNormals.empty()) {
+                pcMesh->mNormals[iVertex] = avNormals[idx];
+            }
+            ++iVertex;
+        }
+        pCur += iFacePost;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Build meshes and materials from the DOM
+void PLYImporter::ConvertDOM(aiScene* pScene,
+    std::vector<aiMesh*>* avMeshes,
+    std::vector<aiMaterial*>* avMaterials)
+{
     // now load a list of vertices. This must be successfully in order to procedure
     std::vector<aiVector3D> avPositions;
     this->LoadVertices(&avPositions,false);
@@ -230,16 +691,15 @@ void PLYImporter::InternReadFile( const std::string& pFile,
         for (unsigned int i = 0; i< iNum;++i)
         {
             PLY::Face sFace;
-            sFace.mIndices.push_back((iNum*3));
-            sFace.mIndices.push_back((iNum*3)+1);
-            sFace.mIndices.push_back((iNum*3)+2);
+            sFace.mIndices[0] = (i*3);
+            sFace.mIndices[1] = (i*3)+1;
+            sFace.mIndices[2] = (i*3)+2;
             avFaces.push_back(sFace);
         }
     }
 
     // now load a list of all materials
-    std::vector<aiMaterial*> avMaterials;
-    LoadMaterial(&avMaterials);
+    LoadMaterial(avMaterials);
 
     // now load a list of all vertex color channels
     std::vector<aiColor4D> avColors;
@@ -252,45 +712,18 @@ void PLYImporter::InternReadFile( const std::string& pFile,
     LoadTextureCoordinates(&avTexCoords);
 
     // now replace the default material in all faces and validate all material indices
-    ReplaceDefaultMaterial(&avFaces,&avMaterials);
+    ReplaceDefaultMaterial(&avFaces,avMaterials);
 
     // now convert this to a list of aiMesh instances
-    std::vector<aiMesh*> avMeshes;
-    avMeshes.reserve(avMaterials.size()+1);
-    ConvertMeshes(&avFaces,&avPositions,&avNormals,
-        &avColors,&avTexCoords,&avMaterials,&avMeshes);
-
-    if ( avMeshes.empty() ) {
-        throw DeadlyImportError( "Invalid .ply file: Unable to extract mesh data " );
-    }
-
-    // now generate the output scene object. Fill the material list
-    pScene->mNumMaterials = (unsigned int)avMaterials.size();
-    pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials];
-    for ( unsigned int i = 0; i < pScene->mNumMaterials; ++i ) {
-        pScene->mMaterials[ i ] = avMaterials[ i ];
-    }
-
-    // fill the mesh list
-    pScene->mNumMeshes = (unsigned int)avMeshes.size();
-    pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
-    for ( unsigned int i = 0; i < pScene->mNumMeshes; ++i ) {
-        pScene->mMeshes[ i ] = avMeshes[ i ];
-    }
-
-    // generate a simple node structure
-    pScene->mRootNode = new aiNode();
-    pScene->mRootNode->mNumMeshes = pScene->mNumMeshes;
-    pScene->mRootNode->mMeshes = new unsigned int[pScene->mNumMeshes];
-
-    for ( unsigned int i = 0; i < pScene->mRootNode->mNumMeshes; ++i ) {
-        pScene->mRootNode->mMeshes[ i ] = i;
-    }
+    avMeshes->reserve(avMaterials->size()+1);
+    ConvertMeshes(pScene,&avFaces,&avPositions,&avNormals,
+        &avColors,&avTexCoords,avMaterials,avMeshes);
 }
 
 // ------------------------------------------------------------------------------------------------
 // Split meshes by material IDs
-void PLYImporter::ConvertMeshes(std::vector<PLY::Face>* avFaces,
+void PLYImporter::ConvertMeshes(aiScene* pScene,
+    std::vector<PLY::Face>* avFaces,
     const std::vector<aiVector3D>*          avPositions,
     const std::vector<aiVector3D>*          avNormals,
     const std::vector<aiColor4D>*           avColors,
@@ -319,7 +752,6 @@ void PLYImporter::ConvertMeshes(std::vector<PLY::Face>* avFaces,
             p_pcOut->mMaterialIndex = p;
 
             p_pcOut->mNumFaces = (unsigned int)aiSplit[p].size();
-            p_pcOut->mFaces = new aiFace[aiSplit[p].size()];
 
             // at first we need to determine the size of the output vector array
             unsigned int iNum = 0;
@@ -333,26 +765,53 @@ void PLYImporter::ConvertMeshes(std::vector<PLY::Face>* avFaces,
                 delete p_pcOut;
                 return;
             }
-            p_pcOut->mVertices = new aiVector3D[iNum];
+            p_pcOut->mFaces = NewSceneArray<aiFace>(pScene, p_pcOut->mNumFaces);
+            p_pcOut->mVertices = NewSceneArray<aiVector3D>(pScene, iNum);
 
             if (!avColors->empty())
-                p_pcOut->mColors[0] = new aiColor4D[iNum];
+                p_pcOut->mColors[0] = NewSceneArray<aiColor4D>(pScene, iNum);
             if (!avTexCoords->empty())
             {
                 p_pcOut->mNumUVComponents[0] = 2;
-                p_pcOut->mTextureCoords[0] = new aiVector3D[iNum];
+                p_pcOut->mTextureCoords[0] = NewSceneArray<aiVector3D>(pScene, iNum);
             }
             if (!avNormals->empty())
-                p_pcOut->mNormals = new aiVector3D[iNum];
+                p_pcOut->mNormals = NewSceneArray<aiVector3D>(pScene, iNum);
+
+            // with an arena, all indices go into one block of it in any case
+            SceneArena* arena = ScenePriv(pScene)->mArena;
+            unsigned int* indices = NULL;
+            if (arena) {
+                indices = arena->AllocateArray<unsigned int>(iNum);
+                if (configPoolFaceIndices) {
+                    p_pcOut->mFaceIndices = indices;
+                    p_pcOut->mNumFaceIndices = iNum;
+                }
+            }
 
             // add all faces
             iNum = 0;
+            if (configPoolFaceIndices && !arena) {
+                for (std::vector<unsigned int>::const_iterator i =  aiSplit[p].begin();
+                    i != aiSplit[p].end();++i,++iNum)
+                {
+                    p_pcOut->mFaces[iNum].mNumIndices = (unsigned int)(*avFaces)[*i].mIndices.size();
+                }
+                p_pcOut->PoolFaceIndices();
+                iNum = 0;
+            }
             unsigned int iVertex = 0;
             for (std::vector<unsigned int>::const_iterator i =  aiSplit[p].begin();
                 i != aiSplit[p].end();++i,++iNum)
             {
                 p_pcOut->mFaces[iNum].mNumIndices = (unsigned int)(*avFaces)[*i].mIndices.size();
-                p_pcOut->mFaces[iNum].mIndices = new unsigned int[p_pcOut->mFaces[iNum].mNumIndices];
+                if (indices) {
+                    p_pcOut->mFaces[iNum].mIndices = indices;
+                    indices += p_pcOut->mFaces[iNum].mNumIndices;
+                }
+                else if (!configPoolFaceIndices) {
+                    p_pcOut->mFaces[iNum].mIndices = new unsigned int[p_pcOut->mFaces[iNum].mNumIndices];
+                }
 
                 // build an unique set of vertices/colors for this face
                 for (unsigned int q = 0; q <  p_pcOut->mFaces[iNum].mNumIndices;++q)
@@ -407,28 +866,34 @@ void PLYImporter::ReplaceDefaultMaterial(std::vector<PLY::Face>* avFaces,
     }
 
     if (bNeedDefaultMat)    {
-        // generate a default material
-        aiMaterial* pcHelper = new aiMaterial();
+        avMaterials->push_back(CreateDefaultMaterial());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Generate the material for faces without material index
+aiMaterial* PLYImporter::CreateDefaultMaterial()
+{
+    aiMaterial* pcHelper = new aiMaterial();
 
-        // fill in a default material
-        int iMode = (int)aiShadingMode_Gouraud;
-        pcHelper->AddProperty<int>(&iMode, 1, AI_MATKEY_SHADING_MODEL);
+    // fill in a default material
+    int iMode = (int)aiShadingMode_Gouraud;
+    pcHelper->AddProperty<int>(&iMode, 1, AI_MATKEY_SHADING_MODEL);
 
-        aiColor3D clr;
-        clr.b = clr.g = clr.r = 0.6f;
-        pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_DIFFUSE);
-        pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_SPECULAR);
+    aiColor3D clr;
+    clr.b = clr.g = clr.r = 0.6f;
+    pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_DIFFUSE);
+    pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_SPECULAR);
 
-        clr.b = clr.g = clr.r = 0.05f;
-        pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_AMBIENT);
+    clr.b = clr.g = clr.r = 0.05f;
+    pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_AMBIENT);
 
-        // The face order is absolutely undefined for PLY, so we have to
-        // use two-sided rendering to be sure it's ok.
-        const int two_sided = 1;
-        pcHelper->AddProperty(&two_sided,1,AI_MATKEY_TWOSIDED);
+    // The face order is absolutely undefined for PLY, so we have to
+    // use two-sided rendering to be sure it's ok.
+    const int two_sided = 1;
+    pcHelper->AddProperty(&two_sided,1,AI_MATKEY_TWOSIDED);
 
-        avMaterials->push_back(pcHelper);
-    }
+    return pcHelper;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -85,6 +85,13 @@ protected:
      */
     const aiImporterDesc* GetInfo () const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+    * The function is a request to the importer to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -94,6 +101,22 @@ protected:
 
 protected:
 
+    // -------------------------------------------------------------------
+    /** Build meshes and materials from the DOM
+    */
+    void ConvertDOM(aiScene* pScene,
+        std::vector<aiMesh*>* avMeshes,
+        std::vector<aiMaterial*>* avMaterials);
+
+    // -------------------------------------------------------------------
+    /** Read the element data of a binary file straight into a mesh,
+     *  without building the DOM. Only the header of the DOM is needed.
+     *  Returns false if the file layout requires the DOM.
+     */
+    bool LoadBinaryDirect(aiScene* pScene,
+        const char* pCur, const char* pEnd, bool p_bBE,
+        std::vector<aiMesh*>* avMeshes,
+        std::vector<aiMaterial*>* avMaterials);
 
     // -------------------------------------------------------------------
     /** Extract vertices from the DOM
@@ -132,7 +155,8 @@ protected:
     // -------------------------------------------------------------------
     /** Convert all meshes into our ourer representation
     */
-    void ConvertMeshes(std::vector<PLY::Face>* avFaces,
+    void ConvertMeshes(aiScene* pScene,
+        std::vector<PLY::Face>* avFaces,
         const std::vector<aiVector3D>* avPositions,
         const std::vector<aiVector3D>* avNormals,
         const std::vector<aiColor4D>* avColors,
@@ -141,6 +165,11 @@ protected:
         std::vector<aiMesh*>* avOut);
 
 
+    // -------------------------------------------------------------------
+    /** Static helper to create the material used for faces without one
+    */
+    static aiMaterial* CreateDefaultMaterial();
+
     // -------------------------------------------------------------------
     /** Static helper to parse a color from four single channels in
     */
@@ -161,10 +190,13 @@ protected:
 
 
     /** Buffer to hold the loaded file */
-    unsigned char* mBuffer;
+    const unsigned char* mBuffer;
 
     /** Document object model representation extracted from the file */
     PLY::DOM* pcDOM;
+
+    /** Configuration option: keep all face indices in one pool */
+    bool configPoolFaceIndices;
 };
 
 } // end of namespace Assimp
@@ -105,6 +105,27 @@ PLY::EDataType PLY::Property::ParseDataType(const char* pCur,const char** pCurOu
     return eOut;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::Property::GetDataTypeSize(PLY::EDataType eType) {
+    switch (eType)
+    {
+    case EDT_Char:
+    case EDT_UChar:
+        return 1;
+    case EDT_Short:
+    case EDT_UShort:
+        return 2;
+    case EDT_Int:
+    case EDT_UInt:
+    case EDT_Float:
+        return 4;
+    case EDT_Double:
+        return 8;
+    default: ;
+    };
+    return 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 PLY::ESemantic PLY::Property::ParseSemantic(const char* pCur,const char** pCurOut) {
     ai_assert (NULL != pCur );
@@ -537,12 +558,7 @@ bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
 
     DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() begin");
 
-    if(!p_pcOut->ParseHeader(pCur,&pCur,true))
-    {
-        DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() failure");
-        return false;
-    }
-    if(!p_pcOut->ParseElementInstanceListsBinary(pCur,&pCur,p_bBE))
+    if(!ParseHeaderBinary(pCur,&pCur,p_pcOut) || !ParseElementDataBinary(pCur,p_pcOut,p_bBE))
     {
         DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() failure");
         return false;
@@ -551,6 +567,25 @@ bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool PLY::DOM::ParseHeaderBinary (const char* pCur,const char** pCurOut,DOM* p_pcOut)
+{
+    ai_assert( NULL != pCur );
+    ai_assert( NULL != pCurOut );
+    ai_assert( NULL != p_pcOut );
+
+    return p_pcOut->ParseHeader(pCur,pCurOut,true);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::DOM::ParseElementDataBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
+{
+    ai_assert( NULL != pCur );
+    ai_assert( NULL != p_pcOut );
+
+    return p_pcOut->ParseElementInstanceListsBinary(pCur,&pCur,p_bBE);
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::DOM::ParseInstance (const char* pCur,DOM* p_pcOut)
 {
@@ -247,6 +247,10 @@ public:
     // -------------------------------------------------------------------
     //! Parse a semantic from a string
     static ESemantic ParseSemantic(const char* pCur,const char** pCurOut);
+
+    // -------------------------------------------------------------------
+    //! Get the size of a binary value of a given type in bytes
+    static unsigned int GetDataTypeSize(EDataType eType);
 };
 
 // ---------------------------------------------------------------------------------
@@ -431,6 +435,16 @@ public:
     static bool ParseInstanceBinary (const char* pCur,
         DOM* p_pcOut,bool p_bBE);
 
+    //! Parse only the header of a binary PLY file. pCurOut receives
+    //! the beginning of the element data.
+    static bool ParseHeaderBinary (const char* pCur,const char** pCurOut,
+        DOM* p_pcOut);
+
+    //! Read the element data of a binary PLY file into a DOM whose
+    //! header has been parsed by ParseHeaderBinary() before
+    static bool ParseElementDataBinary (const char* pCur,
+        DOM* p_pcOut,bool p_bBE);
+
     //! Skip all comment lines after this
     static bool SkipComments (const char* pCur,const char** pCurOut);
 
@@ -244,7 +244,8 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
                 f_dst.mNumIndices = num_idx;
 
                 unsigned int* pi;
-                if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
+                // pooled indices stay with the source mesh and are always copied
+                if (!num_ref && !pcMesh->IsInFaceIndexPool(f_src.mIndices)) { /* if last time the mesh is referenced -> no reallocation */
                     pi = f_dst.mIndices = f_src.mIndices;
 
                     // offset all vertex indices
@@ -504,6 +505,12 @@ void PretransformVertices::Execute( aiScene* pScene)
         std::vector<unsigned int> s(pScene->mNumMeshes,0);
         BuildMeshRefCountArray(pScene->mRootNode,&s[0]);
 
+        // keep face indices pooled if the input meshes have them pooled
+        bool pooled = false;
+        for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+            pooled = pooled || pScene->mMeshes[i]->HasFaceIndexPool();
+        }
+
         for (unsigned int i = 0; i < pScene->mNumMaterials;++i)     {
             // get the list of all vertex formats for this material
             aiVFormats.clear();
@@ -544,6 +551,9 @@ void PretransformVertices::Execute( aiScene* pScene)
                     // fill the mesh ...
                     unsigned int aiTemp[2] = {0,0};
                     CollectData(pScene,pScene->mRootNode,i,*j,pcMesh,aiTemp,&s[0]);
+                    if (pooled) {
+                        pcMesh->PoolFaceIndices();
+                    }
                 }
             }
         }
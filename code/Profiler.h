@@ -49,6 +49,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TinyFormatter.h"
 
 #include <map>
+#include <string>
+#include <typeinfo>
+#ifdef __GNUC__
+#   include <cxxabi.h>
+#   include <cstdlib>
+#endif
 
 namespace Assimp {
     namespace Profiling {
@@ -57,8 +63,8 @@ namespace Assimp {
 
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Simple wrapper around std::chrono to simplify reporting. Timings are automatically
+ *  dumped to the log file and returned to the caller, which may collect them.
  */
 class Profiler
 {
@@ -71,28 +77,57 @@ public:
 
     /** Start a named timer */
     void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        regions[region] = std::chrono::steady_clock::now();
         DefaultLogger::get()->debug((format("START `"),region,"`"));
     }
 
 
-    /** End a specific named timer and write its end time to the log */
-    void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
+    /** End a specific named timer and write its end time to the log.
+     *  @return Elapsed time in seconds, 0 if the region was not started */
+    double EndRegion(const std::string& region) {
+        RegionMap::iterator it = regions.find(region);
         if (it == regions.end()) {
-            return;
+            return 0.0;
         }
 
-        auto elapsedSeconds = std::chrono::system_clock::now() - regions[region];
+        const std::chrono::duration<double> elapsedSeconds = std::chrono::steady_clock::now() - it->second;
+        regions.erase(it);
+
         DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ", elapsedSeconds.count()," s"));
+        return elapsedSeconds.count();
     }
 
 private:
 
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
+    typedef std::map<std::string,std::chrono::time_point<std::chrono::steady_clock>> RegionMap;
     RegionMap regions;
 };
 
+// ------------------------------------------------------------------------------------------------
+/** Get a readable name for a class, i.e. "JoinVerticesProcess" for the
+ *  type info of Assimp::JoinVerticesProcess. Used to label profiler regions.
+ */
+inline std::string GetTypeName(const std::type_info& info)
+{
+    std::string name = info.name();
+#ifdef __GNUC__
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.name(), NULL, NULL, &status);
+    if (demangled) {
+        if (0 == status) {
+            name = demangled;
+        }
+        ::free(demangled);
+    }
+#endif
+    // strip msvc's "class " prefix and any namespaces
+    const std::string::size_type s = name.find_last_of(": ");
+    if (s != std::string::npos) {
+        name = name.substr(s + 1);
+    }
+    return name;
+}
+
     }
 }
 
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <map>
 #include <set>
+#include <atomic>
 
 #include "FBXDocument.h" //ObjectMap::value_type
 #include <assimp/DefaultLogger.hpp>
@@ -80,6 +81,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class TaskScheduler;
+
 // ********************************************************************************
 // before things get complicated, this is the basic outline:
 
@@ -856,7 +859,7 @@ namespace STEP {
         DB(std::shared_ptr<StreamReaderLE> reader)
             : reader(reader)
             , splitter(*reader,true,true)
-            , evaluated_count()
+            , evaluated_count(0)
             , schema( NULL )
         {}
 
@@ -953,6 +956,12 @@ namespace STEP {
 
 #endif
 
+        // evaluate all entities for which the schema provides a converter,
+        // distributing the work over 'numThreads' threads of the scheduler
+        // (0 = all of them, the scheduler may be NULL). Conversion errors
+        // are deferred until the affected object is accessed by the caller.
+        void PreEvaluate(unsigned int numThreads, TaskScheduler* scheduler);
+
     private:
 
         // full access only offered to close friends - they should
@@ -1006,7 +1015,7 @@ namespace STEP {
         InverseWhitelist inv_whitelist;
         std::shared_ptr<StreamReaderLE> reader;
         LineSplitter splitter;
-        uint64_t evaluated_count;
+        std::atomic<uint64_t> evaluated_count;
         const EXPRESS::ConversionSchema* schema;
     };
 
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileEncoding.h"
 #include "TinyFormatter.h"
 #include "fast_atof.h"
+#include "TaskScheduler.h"
 #include <memory>
 
 
@@ -523,8 +524,6 @@ void STEP::LazyObject::LazyInit() const
 
     const char* acopy = args;
     std::shared_ptr<const EXPRESS::LIST> conv_args = EXPRESS::LIST::Parse(acopy,STEP::SyntaxError::LINE_NOT_SPECIFIED,&db.GetSchema());
-    delete[] args;
-    args = NULL;
 
     // if the converter fails, it should throw an exception, but it should never return NULL
     try {
@@ -534,6 +533,11 @@ void STEP::LazyObject::LazyInit() const
         // augment line and entity information
         throw TypeError(t.what(),id);
     }
+
+    // keep the arguments until the conversion succeeded so a failed
+    // DB::PreEvaluate() doesn't hide the error from later accesses
+    delete[] args;
+    args = NULL;
     ++db.evaluated_count;
     ai_assert(obj);
 
@@ -541,3 +545,31 @@ void STEP::LazyObject::LazyInit() const
     obj->SetID(id);
 }
 
+
+// ------------------------------------------------------------------------------------------------
+void STEP::DB::PreEvaluate(unsigned int numThreads, TaskScheduler* scheduler)
+{
+    // collect all pending objects the schema knows how to convert. Converters
+    // only parse their own arguments and look up (but never evaluate) the
+    // objects they reference, so distinct objects can be evaluated concurrently.
+    std::vector<const LazyObject*> pending;
+    pending.reserve(objects.size());
+    for(const ObjectMap::value_type& o : objects) {
+        const LazyObject* lz = o.second;
+        if (!lz->obj && schema->GetConverterProc(lz->type)) {
+            pending.push_back(lz);
+        }
+    }
+
+    auto evaluate = [&pending](size_t i) {
+        try {
+            **pending[i];
+        }
+        catch (const std::exception&) {
+            // the object keeps its arguments, so the error is raised
+            // again once the importer actually touches it
+        }
+    };
+
+    TaskScheduler::ParallelFor(scheduler, pending.size(), evaluate, numThreads);
+}
@@ -48,10 +48,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STLLoader.h"
 #include "ParsingUtils.h"
 #include "fast_atof.h"
+#include "ScenePrivate.h"
+#include "TaskScheduler.h"
+#include "TinyFormatter.h"
+#include "IOStreamBuffer.h"
+#include "MemoryIOWrapper.h"
+#include <algorithm>
+#include <ctype.h>
 #include <memory>
+#include <unordered_set>
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
 
 using namespace Assimp;
 
@@ -104,7 +113,7 @@ static bool IsAsciiSTL(const char* buffer, unsigned int fileSize) {
         // A lot of importers are write solid even if the file is binary. So we have to check for ASCII-characters.
         if( fileSize >= 500 ) {
             isASCII = true;
-            for( unsigned int i = 0; i < 500; i++ ) {
+            for( unsigned int i = 0; i < 500 && buffer + i < bufferEnd; i++ ) {
                 if( buffer[ i ] > 127 ) {
                     isASCII = false;
                     break;
@@ -114,6 +123,222 @@ static bool IsAsciiSTL(const char* buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+// Facets of binary files are decoded in blocks of this many facets
+static const unsigned int BinaryBlockSize = 16384;
+
+// Reads three floats from an unaligned position in a binary file
+inline void ReadVector(const char* p, aiVector3D& v) {
+    float f[3];
+    ::memcpy(f, p, sizeof(f));
+    v.Set(f[0], f[1], f[2]);
+}
+
+// Hash and equality of mesh vertices for welding: positions and colors, if any, must be equal.
+// Vertices are identified by their index, so vertices of a partly welded mesh can be compared.
+struct WeldHash {
+    explicit WeldHash(const aiMesh* m) : mesh(m) {}
+
+    size_t operator()(unsigned int i) const {
+        std::hash<ai_real> hasher;
+        const aiVector3D& v = mesh->mVertices[i];
+        size_t h = hasher(v.x);
+        h ^= hasher(v.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hasher(v.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    const aiMesh* mesh;
+};
+
+struct WeldEqual {
+    explicit WeldEqual(const aiMesh* m) : mesh(m) {}
+
+    bool operator()(unsigned int a, unsigned int b) const {
+        return mesh->mVertices[a] == mesh->mVertices[b] &&
+            (!mesh->mColors[0] || mesh->mColors[0][a] == mesh->mColors[0][b]);
+    }
+
+    const aiMesh* mesh;
+};
+
+// Only this many bytes are read up front to detect the file flavour
+static const size_t HeaderSize = 1024;
+
+// ASCII files are streamed in blocks of this size
+static const size_t ASCIICacheSize = 1024 * 1024;
+
+// Text files with a byte order mark are converted to UTF-8 in memory
+inline bool HasByteOrderMark(const char* buffer, size_t size) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(buffer);
+    return size >= 2 && ((b[0] == 0xFE && b[1] == 0xFF) || (b[0] == 0xFF && b[1] == 0xFE) ||
+        (size >= 3 && b[0] == 0xEF && b[1] == 0xBB && b[2] == 0xBF) ||
+        (size >= 4 && !b[0] && !b[1] && b[2] == 0xFE && b[3] == 0xFF));
+}
+
+// Checks for a keyword which is followed by a space or line end
+inline bool IsToken(const char* sz, const char* token, size_t len) {
+    return *sz == *token && !::strncmp(sz, token, len) && ::IsSpaceOrNewLine(sz[len]);
+}
+
+// Checks for a keyword which is the first word on its line. Both passes over
+// ASCII files use this rule, so they split the file into the same solids.
+inline bool IsKeyword(const char* begin, const char* sz, const char* token, size_t len) {
+    if (!IsToken(sz, token, len)) {
+        return false;
+    }
+    while (sz != begin && ::IsSpace(sz[-1])) {
+        --sz;
+    }
+    return sz == begin || ::IsLineEnd(sz[-1]);
+}
+
+// Splits a streamed text file into tokens. Tokens may be spread over
+// several lines, but never span two lines and thus two blocks.
+class ASCIIReader {
+public:
+    explicit ASCIIReader(IOStreamBuffer<char>& stream)
+        : mStream(stream), mCur(NULL), mEnd(NULL) {}
+
+    // Returns the start of the next token, NULL at the end of the file
+    const char* Peek() {
+        for ( ;; ) {
+            while (mCur < mEnd && ::IsSpaceOrNewLine(*mCur)) {
+                ++mCur;
+            }
+            if (mCur < mEnd) {
+                return mCur;
+            }
+            if (!mStream.getNextLineBlock(mBlock)) {
+                return NULL;
+            }
+            mCur = &mBlock[0];
+            mEnd = mCur + mBlock.size() - 1;
+        }
+    }
+
+    // Checks whether the token at sz, which has been returned by Peek(), is
+    // the given keyword
+    bool IsKeyword(const char* sz, const char* token, size_t len) const {
+        return ::IsKeyword(&mBlock[0], sz, token, len);
+    }
+
+    // Returns the start of the next token on the current line, if any
+    const char* PeekOnLine() {
+        return SkipSpaces(&mCur) ? mCur : NULL;
+    }
+
+    // Moves past the current token
+    void SkipToken() {
+        while (!::IsSpaceOrNewLine(*mCur)) {
+            ++mCur;
+        }
+    }
+
+    // Ignores the rest of the current line
+    void SkipLine() {
+        while (!::IsLineEnd(*mCur)) {
+            ++mCur;
+        }
+    }
+
+    ai_real ReadReal() {
+        if (!Peek()) {
+            throw DeadlyImportError("STL: unexpected EOF while parsing facet");
+        }
+        ai_real value;
+        mCur = fast_atoreal_move<ai_real>(mCur, value);
+        return value;
+    }
+
+    void ReadVector(aiVector3D& v) {
+        v.x = ReadReal();
+        v.y = ReadReal();
+        v.z = ReadReal();
+    }
+
+    // Position after the token last skipped
+    const char* Current() const {
+        return mCur;
+    }
+
+private:
+    IOStreamBuffer<char>& mStream;
+    std::vector<char> mBlock;
+    const char* mCur;
+    const char* mEnd;
+};
+
+// Upper bounds for the facets and vertices of a solid
+struct SolidSize {
+    SolidSize() : facets(), vertices() {}
+
+    unsigned int facets;
+    unsigned int vertices;
+};
+
+// Finds the next keyword in a block, see IsKeyword()
+const char* FindKeyword(const char* begin, const char* p, const char* end, const char* keyword) {
+    const size_t len = ::strlen(keyword);
+    while (p < end) {
+        const char* hit = ::strstr(p, keyword);
+        if (!hit) {
+            // skip a binary zero within the block
+            p += ::strlen(p) + 1;
+            continue;
+        }
+        if (IsKeyword(begin, hit, keyword, len)) {
+            return hit;
+        }
+        p = hit + 1;
+    }
+    return NULL;
+}
+
+// Counts the facets and vertices of each solid. Only the keywords are
+// searched for, so the numbers in between cost next to nothing.
+void CountASCIISolids(IOStreamBuffer<char>& stream, std::vector<SolidSize>& sizes) {
+    static const char* const keywords[] = { "facet", "vertex", "endsolid" };
+    static const size_t numKeywords = sizeof(keywords) / sizeof(keywords[0]);
+
+    std::vector<char> block;
+    bool inSolid = false;
+    while (stream.getNextLineBlock(block)) {
+        const char* const begin = &block[0];
+        const char* const end = begin + block.size() - 1;
+        const char* next[numKeywords];
+        for (size_t k = 0; k < numKeywords; ++k) {
+            next[k] = FindKeyword(begin, begin, end, keywords[k]);
+        }
+
+        // walk through the keywords in the order they appear
+        for ( ;; ) {
+            size_t k = numKeywords;
+            for (size_t i = 0; i < numKeywords; ++i) {
+                if (next[i] && (k == numKeywords || next[i] < next[k])) {
+                    k = i;
+                }
+            }
+            if (k == numKeywords) {
+                break;
+            }
+
+            if (!inSolid) {
+                sizes.push_back(SolidSize());
+                inSolid = true;
+            }
+            if (0 == k) {
+                ++sizes.back().facets;
+            }
+            else if (1 == k) {
+                ++sizes.back().vertices;
+            }
+            else {
+                inSolid = false;
+            }
+            next[k] = FindKeyword(begin, next[k] + 1, end, keywords[k]);
+        }
+    }
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -121,7 +346,10 @@ static bool IsAsciiSTL(const char* buffer, unsigned int fileSize) {
 STLImporter::STLImporter()
     : mBuffer(),
     fileSize(),
-    pScene()
+    pScene(),
+    configPoolFaceIndices(false),
+    configNumThreads(1),
+    configWeldVertices(false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -153,15 +381,51 @@ const aiImporterDesc* STLImporter::GetInfo () const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh* pMesh)
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void STLImporter::SetupProperties(const Importer* pImp)
 {
-    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    configPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_POOL_FACE_INDICES, false);
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STL_NUM_THREADS, 1);
+    configNumThreads = numThreads < 0 ? 1 : static_cast<unsigned int>(numThreads);
+    configWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the faces of a mesh with one vertex per face corner, optionally remapped
+void addFacesToMesh(aiScene* pScene, aiMesh* pMesh, bool pooled,
+    const std::vector<unsigned int>* remap = NULL)
+{
+    pMesh->mFaces = NewSceneArray<aiFace>(pScene, pMesh->mNumFaces);
+
+    // with an arena, all indices go into one block of it in any case
+    SceneArena* arena = ScenePriv(pScene)->mArena;
+    unsigned int* indices = NULL;
+    if (arena) {
+        indices = arena->AllocateArray<unsigned int>(pMesh->mNumFaces * 3);
+        if (pooled) {
+            pMesh->mFaceIndices = indices;
+            pMesh->mNumFaceIndices = pMesh->mNumFaces * 3;
+        }
+    }
+    else if (pooled) {
+        for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
+            pMesh->mFaces[i].mNumIndices = 3;
+        }
+        pMesh->PoolFaceIndices();
+    }
     for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces;++i)    {
 
         aiFace& face = pMesh->mFaces[i];
-        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        face.mNumIndices = 3;
+        if (indices) {
+            face.mIndices = indices + p;
+        }
+        else if (!pooled) {
+            face.mIndices = new unsigned int[3];
+        }
         for (unsigned int o = 0; o < 3;++o,++p) {
-            face.mIndices[o] = p;
+            face.mIndices[o] = remap ? (*remap)[p] : p;
         }
     }
 }
@@ -179,13 +443,32 @@ void STLImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
 
     fileSize = (unsigned int)file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
-    // (terminate it with zero)
+    // binary files are read in place if the file is mapped into memory,
+    // otherwise allocate storage and copy the contents of the file to a
+    // memory buffer. Only the header is read from ASCII files, their
+    // contents are streamed.
     std::vector<char> mBuffer2;
-    TextFileToBuffer(file.get(),mBuffer2);
+    this->mBuffer = static_cast<const char*>(file->GetMappedData());
+    size_t headerSize = std::min<size_t>(fileSize, HeaderSize);
+    if (!mBuffer) {
+        mBuffer2.resize(headerSize + 1, '\0');
+        if (headerSize != file->Read(&mBuffer2[0], 1, headerSize)) {
+            throw DeadlyImportError("STL: file read error");
+        }
+        this->mBuffer = &mBuffer2[0];
+    }
+
+    // text files with a byte order mark can't be streamed, convert them at once
+    std::unique_ptr<IOStream> text;
+    if (HasByteOrderMark(mBuffer, headerSize)) {
+        file->Seek(0, aiOrigin_SET);
+        TextFileToBuffer(file.get(), mBuffer2);
+        this->mBuffer = &mBuffer2[0];
+        headerSize = std::min<size_t>(mBuffer2.size() - 1, HeaderSize);
+        text.reset(new MemoryIOStream(reinterpret_cast<const uint8_t*>(mBuffer), mBuffer2.size() - 1));
+    }
 
     this->pScene = pScene;
-    this->mBuffer = &mBuffer2[0];
 
     // the default vertex color is light gray.
     clrColorDefault.r = clrColorDefault.g = clrColorDefault.b = clrColorDefault.a = (ai_real) 0.6;
@@ -195,10 +478,18 @@ void STLImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
 
     bool bMatClr = false;
 
-    if (IsBinarySTL(mBuffer, fileSize)) {
+    if (!text && IsBinarySTL(mBuffer, fileSize)) {
+        if (!file->GetMappedData()) {
+            mBuffer2.resize(fileSize);
+            file->Seek(0, aiOrigin_SET);
+            if (fileSize != file->Read(&mBuffer2[0], 1, fileSize)) {
+                throw DeadlyImportError("STL: file read error");
+            }
+            this->mBuffer = &mBuffer2[0];
+        }
         bMatClr = LoadBinaryFile();
-    } else if (IsAsciiSTL(mBuffer, fileSize)) {
-        LoadASCIIFile();
+    } else if (IsAsciiSTL(mBuffer, static_cast<unsigned int>(headerSize))) {
+        LoadASCIIFile(text ? text.get() : file.get());
     } else {
         throw DeadlyImportError( "Failed to determine STL storage representation for " + pFile + ".");
     }
@@ -231,39 +522,49 @@ void STLImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
 }
 // ------------------------------------------------------------------------------------------------
 // Read an ASCII STL file
-void STLImporter::LoadASCIIFile()
+void STLImporter::LoadASCIIFile(IOStream* pStream)
 {
-    std::vector<aiMesh*> meshes;
-    const char* sz = mBuffer;
-    const char* bufferEnd = mBuffer + fileSize;
-    std::vector<aiVector3D> positionBuffer;
-    std::vector<aiVector3D> normalBuffer;
-
-    // try to guess how many vertices we could have
-    // assume we'll need 160 bytes for each face
-    size_t sizeEstimate = std::max(1u, fileSize / 160u ) * 3;
-    positionBuffer.reserve(sizeEstimate);
-    normalBuffer.reserve(sizeEstimate);
-
-    while (IsAsciiSTL(sz, static_cast<unsigned int>(bufferEnd - sz)))
+    // a first pass over the file finds the size of each solid, only the stream
+    // cache and the output arrays are held in memory
+    std::vector<SolidSize> sizes;
     {
-        aiMesh* pMesh = new aiMesh();
-        pMesh->mMaterialIndex = 0;
-        meshes.push_back(pMesh);
+        IOStreamBuffer<char> counter(ASCIICacheSize);
+        counter.open(pStream);
+        CountASCIISolids(counter, sizes);
+    }
+    if (sizes.empty()) {
+        throw DeadlyImportError("STL: ASCII file is empty or invalid; no data loaded");
+    }
 
-        SkipSpaces(&sz);
-        ai_assert(!IsLineEnd(sz));
+    // the scene owns the meshes right away, so nothing leaks if parsing fails
+    pScene->mNumMeshes = static_cast<unsigned int>(sizes.size());
+    pScene->mMeshes = new aiMesh*[pScene->mNumMeshes]();
 
-        sz += 5; // skip the "solid"
-        SkipSpaces(&sz);
-        const char* szMe = sz;
-        while (!::IsSpaceOrNewLine(*sz)) {
-            sz++;
+    IOStreamBuffer<char> stream(ASCIICacheSize);
+    stream.open(pStream);
+    ASCIIReader reader(stream);
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        // the counts may include keywords after the last solid
+        const char* sz = reader.Peek();
+        if (!sz || ::strncmp(sz, "solid", 5)) {
+            if (!i) {
+                throw DeadlyImportError("STL: file changed while reading");
+            }
+            pScene->mNumMeshes = static_cast<unsigned int>(i);
+            break;
         }
+        reader.SkipToken(); // skip the "solid"
 
-        size_t temp;
         // setup the name of the node
-        if ((temp = (size_t)(sz-szMe)))    {
+        const char* szMe = reader.PeekOnLine();
+        size_t temp = 0;
+        if (szMe) {
+            reader.SkipToken();
+            temp = (size_t)(reader.Current() - szMe);
+        }
+        if (temp) {
             if (temp >= MAXLEN) {
                 throw DeadlyImportError( "STL: Node name too long" );
             }
@@ -274,117 +575,98 @@ void STLImporter::LoadASCIIFile()
         }
         else pScene->mRootNode->mName.Set("<STL_ASCII>");
 
+        aiMesh* pMesh = pScene->mMeshes[i] = new aiMesh();
+        pMesh->mMaterialIndex = 0;
+        if (!sizes[i].vertices) {
+            throw DeadlyImportError("STL: ASCII file is empty or invalid; no data loaded");
+        }
+        const unsigned int maxVertices = sizes[i].vertices;
+        const unsigned int maxNormals = sizes[i].facets * 3;
+        pMesh->mVertices = NewSceneArray<aiVector3D>(pScene, maxVertices);
+        pMesh->mNormals = NewSceneArray<aiVector3D>(pScene, std::max(1u, maxNormals));
+
+        unsigned int numVertices = 0, numNormals = 0;
         unsigned int faceVertexCounter = 3;
         for ( ;; )
         {
             // go to the next token
-            if(!SkipSpacesAndLineEnd(&sz))
+            if(!(sz = reader.Peek()))
             {
                 // seems we're finished although there was no end marker
                 DefaultLogger::get()->warn("STL: unexpected EOF. \'endsolid\' keyword was expected");
                 break;
             }
             // facet normal -0.13 -0.13 -0.98
-            if (!strncmp(sz,"facet",5) && IsSpaceOrNewLine(*(sz+5)) && *(sz + 5) != '\0')    {
+            if (reader.IsKeyword(sz, "facet", 5))    {
 
                 if (faceVertexCounter != 3) {
                     DefaultLogger::get()->warn("STL: A new facet begins but the old is not yet complete");
                 }
                 faceVertexCounter = 0;
-                normalBuffer.push_back(aiVector3D());
-                aiVector3D* vn = &normalBuffer.back();
+                if (numNormals + 3 > maxNormals) {
+                    throw DeadlyImportError("STL: file changed while reading");
+                }
+                aiVector3D* vn = pMesh->mNormals + numNormals++;
 
-                sz += 6;
-                SkipSpaces(&sz);
-                if (strncmp(sz,"normal",6))    {
+                reader.SkipToken();
+                sz = reader.Peek();
+                if (!sz || !IsToken(sz, "normal", 6))    {
                     DefaultLogger::get()->warn("STL: a facet normal vector was expected but not found");
                 }
                 else
                 {
-                    if (sz[6] == '\0') {
-                        throw DeadlyImportError("STL: unexpected EOF while parsing facet");
-                    }
-                    sz += 7;
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->x );
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->y );
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->z );
-                    normalBuffer.push_back(*vn);
-                    normalBuffer.push_back(*vn);
+                    reader.SkipToken();
+                    reader.ReadVector(*vn);
+                    *(vn+1) = *vn;
+                    *(vn+2) = *vn;
+                    numNormals += 2;
                 }
             }
             // vertex 1.50000 1.50000 0.00000
-            else if (!strncmp(sz,"vertex",6) && ::IsSpaceOrNewLine(*(sz+6)))
+            else if (reader.IsKeyword(sz, "vertex", 6))
             {
+                reader.SkipToken();
                 if (faceVertexCounter >= 3) {
                     DefaultLogger::get()->error("STL: a facet with more than 3 vertices has been found");
-                    ++sz;
                 }
                 else
                 {
-                    if (sz[6] == '\0') {
-                        throw DeadlyImportError("STL: unexpected EOF while parsing facet");
+                    if (numVertices >= maxVertices) {
+                        throw DeadlyImportError("STL: file changed while reading");
                     }
-                    sz += 7;
-                    SkipSpaces(&sz);
-                    positionBuffer.push_back(aiVector3D());
-                    aiVector3D* vn = &positionBuffer.back();
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->x );
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->y );
-                    SkipSpaces(&sz);
-                    sz = fast_atoreal_move<ai_real>(sz, (ai_real&)vn->z );
+                    reader.ReadVector(pMesh->mVertices[numVertices++]);
                     faceVertexCounter++;
                 }
             }
-            else if (!::strncmp(sz,"endsolid",8))    {
-                do {
-                    ++sz;
-                } while (!::IsLineEnd(*sz));
-                SkipSpacesAndLineEnd(&sz);
+            else if (reader.IsKeyword(sz, "endsolid", 8))    {
+                reader.SkipLine();
                 // finished!
                 break;
             }
             // else skip the whole identifier
             else {
-                do {
-                    ++sz;
-                } while (!::IsSpaceOrNewLine(*sz));
+                reader.SkipToken();
             }
         }
 
-        if (positionBuffer.empty())    {
-            pMesh->mNumFaces = 0;
+        if (!numVertices)    {
             throw DeadlyImportError("STL: ASCII file is empty or invalid; no data loaded");
         }
-        if (positionBuffer.size() % 3 != 0)    {
-            pMesh->mNumFaces = 0;
+        if (numVertices % 3 != 0)    {
             throw DeadlyImportError("STL: Invalid number of vertices");
         }
-        if (normalBuffer.size() != positionBuffer.size())    {
-            pMesh->mNumFaces = 0;
+        if (numNormals != numVertices)    {
             throw DeadlyImportError("Normal buffer size does not match position buffer size");
         }
-        pMesh->mNumFaces = static_cast<unsigned int>(positionBuffer.size() / 3);
-        pMesh->mNumVertices = static_cast<unsigned int>(positionBuffer.size());
-        pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-        memcpy(pMesh->mVertices, &positionBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
-        positionBuffer.clear();
-        pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-        memcpy(pMesh->mNormals, &normalBuffer[0].x, pMesh->mNumVertices * sizeof(aiVector3D));
-        normalBuffer.clear();
+        pMesh->mNumFaces = numVertices / 3;
+        pMesh->mNumVertices = numVertices;
 
         // now copy faces
-        addFacesToMesh(pMesh);
-    }
-    // now add the loaded meshes
-    pScene->mNumMeshes = (unsigned int)meshes.size();
-    pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
-    for (size_t i = 0; i < meshes.size(); i++)
-    {
-        pScene->mMeshes[i] = meshes[i];
+        std::vector<unsigned int> remap;
+        if (configWeldVertices) {
+            WeldVertices(pMesh, remap);
+        }
+        addFacesToMesh(pScene, pMesh, configPoolFaceIndices, remap.empty() ? NULL : &remap);
     }
 }
 
@@ -431,7 +713,7 @@ bool STLImporter::LoadBinaryFile()
     pMesh->mNumFaces = *((uint32_t*)sz);
     sz += 4;
 
-    if (fileSize < 84 + pMesh->mNumFaces*50) {
+    if (fileSize < 84 + static_cast<uint64_t>(pMesh->mNumFaces)*50) {
         throw DeadlyImportError("STL: file is too small to hold all facets");
     }
 
@@ -440,68 +722,85 @@ bool STLImporter::LoadBinaryFile()
     }
 
     pMesh->mNumVertices = pMesh->mNumFaces*3;
-
-    aiVector3D* vp,*vn;
-    vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-    vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-
-    for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
-
-        // NOTE: Blender sometimes writes empty normals ... this is not
-        // our fault ... the RemoveInvalidData helper step should fix that
-        *vn = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
-        *(vn+1) = *vn;
-        *(vn+2) = *vn;
-        vn += 3;
-
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
-
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
-
-        *vp++ = *((aiVector3D*)sz);
-        sz += sizeof(aiVector3D);
-
-        uint16_t color = *((uint16_t*)sz);
-        sz += 2;
-
-        if (color & (1 << 15))
-        {
-            // seems we need to take the color
-            if (!pMesh->mColors[0])
-            {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int i = 0; i <pMesh->mNumVertices;++i)
-                    *pMesh->mColors[0]++ = this->clrColorDefault;
-                pMesh->mColors[0] -= pMesh->mNumVertices;
-
-                DefaultLogger::get()->info("STL: Mesh has vertex colors");
-            }
-            aiColor4D* clr = &pMesh->mColors[0][i*3];
-            clr->a = 1.0;
-            const ai_real invVal( (ai_real)1.0 / ( ai_real )31.0 );
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) *invVal;
-                clr->g = ((color & (0x31u<<5))>>5u) *invVal;
-                clr->b = ((color & (0x31u<<10))>>10u) *invVal;
-            }
-            else
-            {
-                clr->b = (color & 0x31u) *invVal;
-                clr->g = ((color & (0x31u<<5))>>5u) *invVal;
-                clr->r = ((color & (0x31u<<10))>>10u) *invVal;
+    pMesh->mVertices = NewSceneArray<aiVector3D>(pScene, pMesh->mNumVertices);
+    pMesh->mNormals = NewSceneArray<aiVector3D>(pScene, pMesh->mNumVertices);
+
+    // facets have a fixed size, so blocks of them can be decoded independently
+    const char* const facets = reinterpret_cast<const char*>(sz);
+    const unsigned int numFaces = pMesh->mNumFaces;
+    const unsigned int numBlocks = (numFaces + BinaryBlockSize - 1) / BinaryBlockSize;
+    std::vector<char> hasColors(numBlocks, 0);
+    aiVector3D* const vertices = pMesh->mVertices;
+    aiVector3D* const normals = pMesh->mNormals;
+
+    TaskScheduler::ParallelFor(m_scheduler, numBlocks, [=, &hasColors](size_t block) {
+        const unsigned int end = std::min(numFaces, static_cast<unsigned int>(block + 1) * BinaryBlockSize);
+        for (unsigned int i = static_cast<unsigned int>(block) * BinaryBlockSize; i < end; ++i) {
+            const char* facet = facets + static_cast<size_t>(i) * 50;
+
+            // NOTE: Blender sometimes writes empty normals ... this is not
+            // our fault ... the RemoveInvalidData helper step should fix that
+            aiVector3D* vn = normals + i * 3;
+            ReadVector(facet, *vn);
+            *(vn+1) = *vn;
+            *(vn+2) = *vn;
+
+            aiVector3D* vp = vertices + i * 3;
+            ReadVector(facet + 12, vp[0]);
+            ReadVector(facet + 24, vp[1]);
+            ReadVector(facet + 36, vp[2]);
+
+            if (facet[49] & 0x80) {
+                hasColors[block] = 1;
             }
-            // assign the color to all vertices of the face
-            *(clr+1) = *clr;
-            *(clr+2) = *clr;
         }
+    }, configNumThreads);
+
+    if (std::find(hasColors.begin(), hasColors.end(), 1) != hasColors.end()) {
+        // seems we need to take the color
+        DefaultLogger::get()->info("STL: Mesh has vertex colors");
+        aiColor4D* const colors = pMesh->mColors[0] = NewSceneArray<aiColor4D>(pScene, pMesh->mNumVertices);
+        const aiColor4D clrDefault = clrColorDefault;
+
+        TaskScheduler::ParallelFor(m_scheduler, numBlocks, [=](size_t block) {
+            const unsigned int end = std::min(numFaces, static_cast<unsigned int>(block + 1) * BinaryBlockSize);
+            for (unsigned int i = static_cast<unsigned int>(block) * BinaryBlockSize; i < end; ++i) {
+                uint16_t color;
+                ::memcpy(&color, facets + static_cast<size_t>(i) * 50 + 48, 2);
+
+                aiColor4D* clr = colors + i * 3;
+                if (!(color & (1 << 15))) {
+                    *clr = clrDefault;
+                }
+                else {
+                    clr->a = 1.0;
+                    const ai_real invVal( (ai_real)1.0 / ( ai_real )31.0 );
+                    if (bIsMaterialise) // this is reversed
+                    {
+                        clr->r = (color & 0x31u) *invVal;
+                        clr->g = ((color & (0x31u<<5))>>5u) *invVal;
+                        clr->b = ((color & (0x31u<<10))>>10u) *invVal;
+                    }
+                    else
+                    {
+                        clr->b = (color & 0x31u) *invVal;
+                        clr->g = ((color & (0x31u<<5))>>5u) *invVal;
+                        clr->r = ((color & (0x31u<<10))>>10u) *invVal;
+                    }
+                }
+                // assign the color to all vertices of the face
+                *(clr+1) = *clr;
+                *(clr+2) = *clr;
+            }
+        }, configNumThreads);
     }
 
     // now copy faces
-    addFacesToMesh(pMesh);
+    std::vector<unsigned int> remap;
+    if (configWeldVertices) {
+        WeldVertices(pMesh, remap);
+    }
+    addFacesToMesh(pScene, pMesh, configPoolFaceIndices, remap.empty() ? NULL : &remap);
 
     if (bIsMaterialise && !pMesh->mColors[0])
     {
@@ -511,4 +810,55 @@ bool STLImporter::LoadBinaryFile()
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Merge vertices with equal positions
+void STLImporter::WeldVertices(aiMesh* pMesh, std::vector<unsigned int>& remap)
+{
+    // unique vertices are moved to the front of the arrays as they are found,
+    // later vertices are compared against these
+    std::unordered_set<unsigned int, WeldHash, WeldEqual> unique(pMesh->mNumVertices,
+        WeldHash(pMesh), WeldEqual(pMesh));
+    remap.resize(pMesh->mNumVertices);
+
+    unsigned int numUnique = 0;
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        std::unordered_set<unsigned int, WeldHash, WeldEqual>::const_iterator it = unique.find(i);
+        if (it != unique.end()) {
+            remap[i] = *it;
+            continue;
+        }
+        pMesh->mVertices[numUnique] = pMesh->mVertices[i];
+        if (pMesh->mColors[0]) {
+            pMesh->mColors[0][numUnique] = pMesh->mColors[0][i];
+        }
+        unique.insert(numUnique);
+        remap[i] = numUnique++;
+    }
+
+    // normals belong to the facets, let the application generate vertex normals.
+    // Arena arrays are released with the scene, heap arrays are cut to size.
+    const bool heap = !ScenePriv(pScene)->mArena;
+    if (heap) {
+        delete[] pMesh->mNormals;
+    }
+    pMesh->mNormals = NULL;
+
+    if (heap && numUnique != pMesh->mNumVertices) {
+        aiVector3D* vertices = new aiVector3D[numUnique];
+        std::copy(pMesh->mVertices, pMesh->mVertices + numUnique, vertices);
+        delete[] pMesh->mVertices;
+        pMesh->mVertices = vertices;
+
+        if (pMesh->mColors[0]) {
+            aiColor4D* colors = new aiColor4D[numUnique];
+            std::copy(pMesh->mColors[0], pMesh->mColors[0] + numUnique, colors);
+            delete[] pMesh->mColors[0];
+            pMesh->mColors[0] = colors;
+        }
+    }
+    DefaultLogger::get()->debug((Formatter::format(), "STL: Welded ",
+        pMesh->mNumVertices, " vertices into ", numUnique));
+    pMesh->mNumVertices = numUnique;
+}
+
 #endif // !! ASSIMP_BUILD_NO_STL_IMPORTER
@@ -46,6 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 #include <assimp/types.h>
+#include <vector>
+
+struct aiMesh;
 
 namespace Assimp    {
 
@@ -76,6 +79,13 @@ protected:
      */
     const aiImporterDesc* GetInfo () const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+    * The function is a request to the importer to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -91,13 +101,24 @@ protected:
     bool LoadBinaryFile();
 
     // -------------------------------------------------------------------
-    /** Loads a ASCII text .stl file
+    /** Loads a ASCII text .stl file. The file is streamed twice in
+     *  small blocks, first to count the vertices of each solid and then
+     *  to read them into arrays of the right size.
+     *  @param pStream Stream to read the file from
+    */
+    void LoadASCIIFile(IOStream* pStream);
+
+    // -------------------------------------------------------------------
+    /** Merges all vertices of a mesh with equal positions (and colors)
+     *  and drops the facet normals, which can't be shared.
+     *  @param pMesh Mesh with one vertex per face corner
+     *  @param remap Receives the new index of each of the old vertices
     */
-    void LoadASCIIFile();
+    void WeldVertices(aiMesh* pMesh, std::vector<unsigned int>& remap);
 
 protected:
 
-    /** Buffer to hold the loaded file */
+    /** Buffer to hold the loaded file, only the header for ASCII files */
     const char* mBuffer;
 
     /** Size of the file, in bytes */
@@ -108,6 +129,15 @@ protected:
 
     /** Default vertex color */
     aiColor4D clrColorDefault;
+
+    /** Configuration option: keep all face indices in one pool */
+    bool configPoolFaceIndices;
+
+    /** Configuration option: number of threads to decode binary facets with */
+    unsigned int configNumThreads;
+
+    /** Configuration option: merge vertices with equal positions */
+    bool configWeldVertices;
 };
 
 } // end of namespace Assimp
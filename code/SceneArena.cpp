@@ -0,0 +1,362 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  SceneArena.cpp
+ *  @brief Implementation of the scene memory arena
+ */
+#include "SceneArena.h"
+#include "ScenePrivate.h"
+#include <assimp/scene.h>
+#include <assimp/ai_assert.h>
+#include <algorithm>
+#include <stdint.h>
+
+using namespace Assimp;
+
+namespace {
+
+// upper bound for the size of a regular chunk, larger requests get their own
+const size_t MaxChunkSize = 64 * 1024 * 1024;
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void CopyToHeap(const SceneArena& arena, T*& p, size_t num)
+{
+    if (p && arena.Owns(p)) {
+        T* out = new T[num];
+        std::copy(p, p + num, out);
+        p = out;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void Forget(const SceneArena& arena, T*& p)
+{
+    if (p && arena.Owns(p)) {
+        p = NULL;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+struct HeapCopier
+{
+    explicit HeapCopier(const SceneArena& a) : arena(a) {}
+
+    template <typename T>
+    void operator()(T*& p, unsigned int num) const {
+        CopyToHeap(arena, p, num);
+    }
+
+    const SceneArena& arena;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct Forgetter
+{
+    explicit Forgetter(const SceneArena& a) : arena(a) {}
+
+    template <typename T>
+    void operator()(T*& p, unsigned int) const {
+        Forget(arena, p);
+    }
+
+    const SceneArena& arena;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Applies an operation to all arena-capable arrays of a node animation
+template <typename Op>
+void ForAllKeys(aiNodeAnim* anim, Op op)
+{
+    op(anim->mPositionKeys, anim->mNumPositionKeys);
+    op(anim->mRotationKeys, anim->mNumRotationKeys);
+    op(anim->mScalingKeys, anim->mNumScalingKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Applies an operation to all arena-capable arrays of a mesh except for the faces
+template <typename Op>
+void ForAllVertexArrays(aiMesh* mesh, Op op)
+{
+    op(mesh->mVertices, mesh->mNumVertices);
+    op(mesh->mNormals, mesh->mNumVertices);
+    op(mesh->mTangents, mesh->mNumVertices);
+    op(mesh->mBitangents, mesh->mNumVertices);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        op(mesh->mColors[i], mesh->mNumVertices);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        op(mesh->mTextureCoords[i], mesh->mNumVertices);
+    }
+    if (mesh->mBones) {
+        for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+            op(mesh->mBones[i]->mWeights, mesh->mBones[i]->mNumWeights);
+        }
+    }
+}
+
+} // ! namespace
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::SceneArena(size_t chunkSize)
+    : mCur()
+    , mEnd()
+    , mNextChunkSize(std::max(chunkSize, static_cast<size_t>(1024)))
+    , mReserved()
+{}
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::~SceneArena()
+{
+    for (std::vector<Chunk>::const_iterator it = mChunks.begin(); it != mChunks.end(); ++it) {
+        if (!(*it).external) {
+            delete[] (*it).begin;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void* SceneArena::Allocate(size_t size, size_t align)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif
+    ai_assert(align && !(align & (align - 1)));
+
+    const size_t pad = static_cast<size_t>(-reinterpret_cast<uintptr_t>(mCur)) & (align - 1);
+    if (mCur && size + pad <= static_cast<size_t>(mEnd - mCur)) {
+        char* out = mCur + pad;
+        mCur = out + size;
+        return out;
+    }
+
+    // allocations larger than a regular chunk get a chunk of their own
+    // and leave the current chunk as it is
+    const bool dedicated = size + align > mNextChunkSize;
+    const size_t chunkSize = dedicated ? size + align : mNextChunkSize;
+
+    Chunk chunk;
+    chunk.begin = new char[chunkSize];
+    chunk.end = chunk.begin + chunkSize;
+    chunk.external = false;
+    AddChunk(chunk);
+    mReserved += chunkSize;
+
+    char* out = chunk.begin + (static_cast<size_t>(-reinterpret_cast<uintptr_t>(chunk.begin)) & (align - 1));
+    if (!dedicated) {
+        mCur = out + size;
+        mEnd = chunk.end;
+        mNextChunkSize = std::min(mNextChunkSize * 2, MaxChunkSize);
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::AddExternalMemory(const void* data, size_t size, const std::shared_ptr<const void>& owner)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(mMutex);
+#endif
+    Chunk chunk;
+    chunk.begin = const_cast<char*>(static_cast<const char*>(data));
+    chunk.end = chunk.begin + size;
+    chunk.external = true;
+    AddChunk(chunk);
+    mExternalOwners.push_back(owner);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::AddChunk(const Chunk& chunk)
+{
+    mChunks.insert(std::upper_bound(mChunks.begin(), mChunks.end(), chunk, [](const Chunk& a, const Chunk& b) {
+        return a.begin < b.begin;
+    }), chunk);
+}
+
+// ------------------------------------------------------------------------------------------------
+const SceneArena::Chunk* SceneArena::FindChunk(const void* p) const
+{
+    const char* c = static_cast<const char*>(p);
+    std::vector<Chunk>::const_iterator it = std::upper_bound(mChunks.begin(), mChunks.end(), c,
+        [](const char* a, const Chunk& b) {
+            return a < b.begin;
+        });
+    return it != mChunks.begin() && (--it)->Contains(c) ? &*it : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneArena::Owns(const void* p) const
+{
+    return FindChunk(p) != NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneArena::Owns(const void* p, const Chunk*& hint) const
+{
+    if (hint && hint->Contains(p)) {
+        return true;
+    }
+    const Chunk* chunk = FindChunk(p);
+    if (chunk) {
+        hint = chunk;
+    }
+    return chunk != NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t SceneArena::GetReservedMemory() const
+{
+    return mReserved;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::MoveToHeap(aiMesh* mesh) const
+{
+    const SceneArena& arena = *this;
+    ForAllVertexArrays(mesh, HeapCopier(arena));
+
+    // faces keep their index arrays, these are handled below
+    if (mesh->mFaces && Owns(mesh->mFaces)) {
+        aiFace* faces = new aiFace[mesh->mNumFaces];
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            faces[i].mNumIndices = mesh->mFaces[i].mNumIndices;
+            faces[i].mIndices = mesh->mFaces[i].mIndices;
+        }
+        mesh->mFaces = faces;
+    }
+
+    // a pool in the arena becomes a pool on the heap
+    if (mesh->mFaceIndices && Owns(mesh->mFaceIndices)) {
+        unsigned int* pool = new unsigned int[mesh->mNumFaceIndices];
+        std::copy(mesh->mFaceIndices, mesh->mFaceIndices + mesh->mNumFaceIndices, pool);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            aiFace& face = mesh->mFaces[i];
+            if (mesh->IsInFaceIndexPool(face.mIndices)) {
+                face.mIndices = pool + (face.mIndices - mesh->mFaceIndices);
+            }
+        }
+        mesh->mFaceIndices = pool;
+    }
+
+    if (mesh->mFaces) {
+        const Chunk* hint = NULL;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            aiFace& face = mesh->mFaces[i];
+            if (face.mIndices && !mesh->IsInFaceIndexPool(face.mIndices) && Owns(face.mIndices, hint)) {
+                unsigned int* indices = new unsigned int[face.mNumIndices];
+                std::copy(face.mIndices, face.mIndices + face.mNumIndices, indices);
+                face.mIndices = indices;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::ReleaseMesh(aiMesh* mesh) const
+{
+    const SceneArena& arena = *this;
+    ForAllVertexArrays(mesh, Forgetter(arena));
+
+    // arena faces only reference indices in the arena and heap faces only
+    // indices on the heap, so no single face needs to be looked at
+    if (mesh->mFaces && Owns(mesh->mFaces)) {
+        mesh->mFaces = NULL;
+        mesh->mNumFaces = 0;
+    }
+    if (mesh->mFaceIndices && Owns(mesh->mFaceIndices)) {
+        mesh->mFaceIndices = NULL;
+        mesh->mNumFaceIndices = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::MoveToHeap(aiScene* scene)
+{
+    ScenePrivateData* priv = ScenePriv(scene);
+    if (!priv || !priv->mArena) {
+        return;
+    }
+
+    const SceneArena& arena = *priv->mArena;
+    if (scene->mMeshes) {
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            arena.MoveToHeap(scene->mMeshes[i]);
+        }
+    }
+    if (scene->mAnimations) {
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+            aiAnimation* anim = scene->mAnimations[i];
+            for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+                ForAllKeys(anim->mChannels[c], HeapCopier(arena));
+            }
+        }
+    }
+
+    delete priv->mArena;
+    priv->mArena = NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::ReleaseScene(aiScene* scene)
+{
+    ScenePrivateData* priv = ScenePriv(scene);
+    if (!priv || !priv->mArena) {
+        return;
+    }
+
+    const SceneArena& arena = *priv->mArena;
+    if (scene->mMeshes) {
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            if (scene->mMeshes[i]) {
+                arena.ReleaseMesh(scene->mMeshes[i]);
+            }
+        }
+    }
+    if (scene->mAnimations) {
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+            aiAnimation* anim = scene->mAnimations[i];
+            for (unsigned int c = 0; anim && anim->mChannels && c < anim->mNumChannels; ++c) {
+                ForAllKeys(anim->mChannels[c], Forgetter(arena));
+            }
+        }
+    }
+}
@@ -0,0 +1,185 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  SceneArena.h
+ *  @brief Declares the memory arena backing the data of an imported
+ *    scene, see #AI_CONFIG_GLOB_SCENE_ARENA.
+ */
+#ifndef AI_SCENE_ARENA_H_INC
+#define AI_SCENE_ARENA_H_INC
+
+#include <assimp/defs.h>
+#include <memory>
+#include <new>
+#include <vector>
+#include <stddef.h>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <mutex>
+#endif
+
+struct aiScene;
+struct aiMesh;
+
+namespace Assimp    {
+
+// ----------------------------------------------------------------------------------
+/** SceneArena: Chunked bump allocator for the arrays of a scene.
+ *
+ *  The arena is owned by the ScenePrivateData of a scene and lives as long
+ *  as the scene. Importers allocate large arrays (vertex data, faces, face
+ *  indices, bone weights, animation keys) from it instead of the heap, and
+ *  the whole arena is released in one go with the scene.
+ *
+ *  Arena memory must never be passed to delete[]. The scene destructor
+ *  drops all references to arena memory before destroying the scene
+ *  (ReleaseScene()), and code which replaces or frees scene arrays, i.e.
+ *  the post-processing steps, runs only after MoveToHeap() gave the scene
+ *  heap copies of its arrays. Arrays referenced by the scene may freely
+ *  mix heap and arena memory, except for faces: faces allocated from the
+ *  arena take their index arrays from it as well, and faces on the heap
+ *  never reference indices in it. Releasing a scene therefore costs a few
+ *  lookups per array, no matter how many faces, vertices or keys it has.
+*/
+// ----------------------------------------------------------------------------------
+class ASSIMP_API SceneArena
+{
+public:
+    /** Default size of the first chunk, later chunks grow geometrically */
+    static const size_t DefaultChunkSize = 256 * 1024;
+
+    explicit SceneArena(size_t chunkSize = DefaultChunkSize);
+    ~SceneArena();
+
+    // ----------------------------------------------------------------
+    /** Allocates uninitialized memory with the given power-of-two
+     *  alignment. Thread-safe with respect to other allocations. */
+    void* Allocate(size_t size, size_t align);
+
+    // ----------------------------------------------------------------
+    /** Allocates and default-constructs an array of num elements.
+     *  No destructors are ever run for arena arrays. */
+    template <typename T>
+    T* AllocateArray(size_t num) {
+        T* out = static_cast<T*>(Allocate(num * sizeof(T), alignof(T)));
+        for (size_t i = 0; i < num; ++i) {
+            new (out + i) T();
+        }
+        return out;
+    }
+
+    // ----------------------------------------------------------------
+    /** Checks whether p points into memory owned by the arena.
+     *  Must not run concurrently with Allocate(). */
+    bool Owns(const void* p) const;
+
+    // ----------------------------------------------------------------
+    /** Adds memory the arena did not allocate, i.e. a memory mapped
+     *  file whose contents the scene references in place. Owns() is
+     *  true for it, so it is treated like arena memory, and the arena
+     *  keeps owner alive until it is destroyed. */
+    void AddExternalMemory(const void* data, size_t size, const std::shared_ptr<const void>& owner);
+
+    // ----------------------------------------------------------------
+    /** Returns the number of bytes reserved by the arena, not counting
+     *  external memory */
+    size_t GetReservedMemory() const;
+
+    // ----------------------------------------------------------------
+    /** Replaces all arena arrays referenced by a mesh with heap copies */
+    void MoveToHeap(aiMesh* mesh) const;
+
+    // ----------------------------------------------------------------
+    /** Drops all references to arena memory from a mesh, so that its
+     *  destructor only releases heap memory. Doesn't look at the single
+     *  faces, see the class docs. */
+    void ReleaseMesh(aiMesh* mesh) const;
+
+    // ----------------------------------------------------------------
+    /** Replaces all arena arrays referenced by the scene with heap
+     *  copies and destroys the arena of the scene, if any. Called
+     *  before any code that may free or replace scene arrays. */
+    static void MoveToHeap(aiScene* scene);
+
+    // ----------------------------------------------------------------
+    /** Drops all references to arena memory from the scene, called by
+     *  the scene destructor before it releases the heap memory. */
+    static void ReleaseScene(aiScene* scene);
+
+private:
+    SceneArena(const SceneArena&);
+    SceneArena& operator=(const SceneArena&);
+
+    struct Chunk {
+        char* begin;
+        char* end;
+        bool external;
+
+        bool Contains(const void* p) const {
+            return p >= begin && p < end;
+        }
+    };
+
+    // Returns the chunk containing p or NULL
+    const Chunk* FindChunk(const void* p) const;
+
+    // Owns() for long runs of pointers into mostly the same chunk
+    bool Owns(const void* p, const Chunk*& hint) const;
+
+    // Inserts a chunk, keeping mChunks sorted
+    void AddChunk(const Chunk& chunk);
+
+    // chunks sorted by address for Owns()
+    std::vector<Chunk> mChunks;
+    std::vector<std::shared_ptr<const void> > mExternalOwners;
+    char* mCur;
+    char* mEnd;
+    size_t mNextChunkSize;
+    size_t mReserved;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::mutex mMutex;
+#endif
+};
+
+} // ! namespace Assimp
+
+#endif // AI_SCENE_ARENA_H_INC
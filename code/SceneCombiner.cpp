@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StringUtils.h"
 #include "fast_atof.h"
 #include "Hash.h"
+#include "MaterialSystem.h"
 #include "time.h"
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
@@ -267,6 +268,14 @@ void SceneCombiner::MergeScenes(aiScene** _dest, aiScene* master,
 
     aiScene* dest = *_dest;
 
+    // arrays are moved between the scenes, so they must not be part of an arena
+    LoadDeferredMeshes(master);
+    SceneArena::MoveToHeap(master);
+    for (unsigned int i = 0; i < srcList.size();++i)    {
+        LoadDeferredMeshes(srcList[i].scene);
+        SceneArena::MoveToHeap(srcList[i].scene);
+    }
+
     std::vector<SceneHelper> src (srcList.size()+1);
     src[0].scene = master;
     for (unsigned int i = 0; i < srcList.size();++i)    {
@@ -862,11 +871,33 @@ void SceneCombiner::MergeMeshes(aiMesh** _out,unsigned int /*flags*/,
         out->mFaces = new aiFace[out->mNumFaces];
         aiFace* pf2 = out->mFaces;
 
+        // if any of the source meshes keeps its indices in a pool, the
+        // merged mesh gets a pool holding copies of all indices
+        unsigned int* pool = NULL;
+        for (std::vector<aiMesh*>::const_iterator it = begin; it != end;++it)   {
+            if ((*it)->HasFaceIndexPool())  {
+                for (std::vector<aiMesh*>::const_iterator it2 = begin; it2 != end;++it2)   {
+                    for (unsigned int m = 0; m < (*it2)->mNumFaces;++m)    {
+                        out->mNumFaceIndices += (*it2)->mFaces[m].mNumIndices;
+                    }
+                }
+                pool = out->mFaceIndices = new unsigned int[out->mNumFaceIndices];
+                break;
+            }
+        }
+
         unsigned int ofs = 0;
         for (std::vector<aiMesh*>::const_iterator it = begin; it != end;++it)   {
             for (unsigned int m = 0; m < (*it)->mNumFaces;++m,++pf2)    {
                 aiFace& face = (*it)->mFaces[m];
                 pf2->mNumIndices = face.mNumIndices;
+                if (pool)   {
+                    pf2->mIndices = pool;
+                    pool += face.mNumIndices;
+                    for (unsigned int q = 0; q < face.mNumIndices; ++q)
+                        pf2->mIndices[q] = face.mIndices[q] + ofs;
+                    continue;
+                }
                 pf2->mIndices = face.mIndices;
 
                 if (ofs)    {
@@ -940,6 +971,7 @@ void SceneCombiner::MergeMaterials(aiMaterial** dest,
             }
         }
     }
+    UpdateMaterialIndex(out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -992,6 +1024,9 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
     aiScene* dest = *_dest;
     ai_assert(dest);
 
+    // loading deferred meshes leaves the contents of the source unchanged
+    LoadDeferredMeshes(const_cast<aiScene*>(src));
+
     // copy animations
     dest->mNumAnimations = src->mNumAnimations;
     CopyPtrArray(dest->mAnimations,src->mAnimations,
@@ -1063,10 +1098,15 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 
     // make a deep copy of all faces
     GetArrayCopy(dest->mFaces,dest->mNumFaces);
+    GetArrayCopy(dest->mFaceIndices,dest->mNumFaceIndices);
     for (unsigned int i = 0; i < dest->mNumFaces;++i)
     {
         aiFace& f = dest->mFaces[i];
-        GetArrayCopy(f.mIndices,f.mNumIndices);
+        if (src->IsInFaceIndexPool(f.mIndices)) {
+            // keep pooled indices pooled
+            f.mIndices = dest->mFaceIndices + (f.mIndices - src->mFaceIndices);
+        }
+        else GetArrayCopy(f.mIndices,f.mNumIndices);
     }
 }
 
@@ -1098,6 +1138,7 @@ void SceneCombiner::Copy (aiMaterial** _dest, const aiMaterial* src)
         prop->mKey      = sprop->mKey;
         prop->mType     = sprop->mType;
     }
+    UpdateMaterialIndex(dest);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -44,19 +44,39 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_SCENEPRIVATE_H_INCLUDED
 
 #include <assimp/scene.h>
+#include "SceneArena.h"
 
 namespace Assimp    {
 
 class Importer;
 
+// Provides the arrays of meshes an importer deferred loading of, see
+// #AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES. Until loaded, such meshes have their
+// counts, material index and primitive types set but no arrays.
+class SceneSource {
+public:
+    virtual ~SceneSource() {}
+
+    // Loads the arrays of scene->mMeshes[index] unless they are loaded already.
+    // Thread-safe with respect to loading other meshes of the scene.
+    virtual void LoadMesh(aiScene* scene, unsigned int index) = 0;
+};
+
 struct ScenePrivateData {
 
     ScenePrivateData()
         : mOrigImporter()
         , mPPStepsApplied()
         , mIsCopy()
+        , mArena()
+        , mSource()
     {}
 
+    ~ScenePrivateData() {
+        delete mSource;
+        delete mArena;
+    }
+
     // Importer that originally loaded the scene though the C-API
     // If set, this object is owned by this private data instance.
     Assimp::Importer* mOrigImporter;
@@ -70,6 +90,14 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Optional arena holding arrays of the scene, released with the
+    // scene. See #AI_CONFIG_GLOB_SCENE_ARENA.
+    SceneArena* mArena;
+
+    // Optional source of meshes which are not loaded yet, released with
+    // the scene or once all meshes are loaded.
+    SceneSource* mSource;
 };
 
 // Access private data stored in the scene
@@ -81,6 +109,26 @@ inline const ScenePrivateData* ScenePriv(const aiScene* in) {
     return static_cast<const ScenePrivateData*>(in->mPrivate);
 }
 
+// Allocate an array of scene data, from the arena of the scene if it has one
+template <typename T>
+inline T* NewSceneArray(aiScene* in, size_t num) {
+    SceneArena* arena = ScenePriv(in) ? ScenePriv(in)->mArena : NULL;
+    return arena ? arena->AllocateArray<T>(num) : new T[num];
+}
+
+// Load all meshes whose loading has been deferred, called before any code
+// that reads or modifies all meshes of the scene
+inline void LoadDeferredMeshes(aiScene* in) {
+    ScenePrivateData* priv = ScenePriv(in);
+    if (priv && priv->mSource) {
+        for (unsigned int i = 0; i < in->mNumMeshes; ++i) {
+            priv->mSource->LoadMesh(in, i);
+        }
+        delete priv->mSource;
+        priv->mSource = NULL;
+    }
+}
+
 }
 
 #endif
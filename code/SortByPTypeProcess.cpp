@@ -235,6 +235,13 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
 
             out->mNumVertices = (3 == real ? numPolyVerts : out->mNumFaces * (real+1));
 
+            // keep the face indices of the output mesh pooled, too
+            unsigned int* outPool = NULL;
+            if (mesh->HasFaceIndexPool()) {
+                outPool = out->mFaceIndices = new unsigned int[out->mNumVertices];
+                out->mNumFaceIndices = out->mNumVertices;
+            }
+
             aiVector3D *vert(NULL), *nor(NULL), *tan(NULL), *bit(NULL);
             aiVector3D *uv   [AI_MAX_NUMBER_OF_TEXTURECOORDS];
             aiColor4D  *cols [AI_MAX_NUMBER_OF_COLOR_SETS];
@@ -286,7 +293,13 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
                 }
 
                 outFaces->mNumIndices = in.mNumIndices;
-                outFaces->mIndices    = in.mIndices;
+                if (outPool) {
+                    outFaces->mIndices = outPool;
+                    outPool += in.mNumIndices;
+                }
+                else {
+                    outFaces->mIndices = in.mIndices;
+                }
 
                 for (unsigned int q = 0; q < in.mNumIndices; ++q)
                 {
@@ -327,10 +340,13 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
                         *cols[pp]++ = mesh->mColors[pp][idx];
                     }
 
-                    in.mIndices[q] = outIdx++;
+                    outFaces->mIndices[q] = outIdx++;
                 }
 
-                in.mIndices = NULL;
+                // the index array was handed over unless it has been copied
+                if (!mesh->HasFaceIndexPool()) {
+                    in.mIndices = NULL;
+                }
                 ++outFaces;
             }
             ai_assert(outFaces == out->mFaces + out->mNumFaces);
@@ -0,0 +1,307 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the uniform grid to quickly find vertices close to a given position */
+
+#include "SpatialGrid.h"
+#include <assimp/ai_assert.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <limits.h>
+
+using namespace Assimp;
+
+namespace {
+
+    // Number of cells along each axis, a Morton code has 21 bits per axis
+    const unsigned int MaxCell = (1u << 21) - 1;
+
+    // --------------------------------------------------------------------------------------------
+    // Inserts two zero bits between the lower 21 bits of a cell coordinate
+    uint64_t SpreadBits( uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffffull;
+        v = (v | v << 16) & 0x1f0000ff0000ffull;
+        v = (v | v << 8)  & 0x100f00f00f00f00full;
+        v = (v | v << 4)  & 0x10c30c30c30c30c3ull;
+        v = (v | v << 2)  & 0x1249249249249249ull;
+        return v;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Interleaves the cell coordinates to the Morton code of the cell
+    uint64_t MortonCode( unsigned int x, unsigned int y, unsigned int z) {
+        return SpreadBits( x) | (SpreadBits( y) << 1) | (SpreadBits( z) << 2);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    // Orders entries by their cell only, for the range lookup of a cell
+    struct CellLess {
+        template <typename Entry>
+        bool operator () ( const Entry& e, uint64_t cell) const { return e.mCell < cell; }
+        template <typename Entry>
+        bool operator () ( uint64_t cell, const Entry& e) const { return cell < e.mCell; }
+    };
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructs the grid from the given position array.
+SpatialGrid::SpatialGrid( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset)
+: mMin()
+, mInvCellSize( 1)
+{
+    Fill(pPositions,pNumPositions,pElementOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialGrid::SpatialGrid()
+: mMin()
+, mInvCellSize( 1)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor
+SpatialGrid::~SpatialGrid()
+{
+    // nothing to do here, everything destructs automatically
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::Fill( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset,
+    bool pFinalize /*= true */)
+{
+    mPositions.clear();
+    Append(pPositions,pNumPositions,pElementOffset,pFinalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::Append( const aiVector3D* pPositions, unsigned int pNumPositions,
+    unsigned int pElementOffset,
+    bool pFinalize /*= true */)
+{
+    const size_t initial = mPositions.size();
+    mPositions.reserve(initial + pNumPositions);
+    for( unsigned int a = 0; a < pNumPositions; a++)
+    {
+        const char* tempPointer = reinterpret_cast<const char*> (pPositions);
+        const aiVector3D* vec   = reinterpret_cast<const aiVector3D*> (tempPointer + a * pElementOffset);
+        mPositions.push_back( Entry( static_cast<unsigned int>(a+initial), *vec));
+    }
+
+    if (pFinalize) {
+        Finalize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::Finalize()
+{
+    // bounding box of all valid positions
+    aiVector3D vMin( std::numeric_limits<ai_real>::max());
+    aiVector3D vMax( -std::numeric_limits<ai_real>::max());
+    for (std::vector<Entry>::const_iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const ai_real v = it->mPosition[i];
+            if (std::isfinite(v)) {
+                vMin[i] = std::min(vMin[i], v);
+                vMax[i] = std::max(vMax[i], v);
+            }
+        }
+    }
+    for (unsigned int i = 0; i < 3; ++i) {
+        if (vMin[i] > vMax[i]) {
+            vMin[i] = vMax[i] = 0;
+        }
+    }
+    mMin = vMin;
+
+    // Choose the cell size so that a cell contains about one vertex if the vertices were
+    // spread evenly. Flat axes are left out, a plane of vertices is divided in 2D only.
+    const aiVector3D vExtent = vMax - vMin;
+    const ai_real maxExtent = std::max(vExtent.x, std::max(vExtent.y, vExtent.z));
+    ai_real cellSize = 1;
+    if (maxExtent > 0) {
+        double measure = 1.0;
+        unsigned int dimensions = 0;
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (vExtent[i] > maxExtent * ai_real( 1e-4 )) {
+                measure *= vExtent[i];
+                ++dimensions;
+            }
+        }
+        cellSize = static_cast<ai_real>( std::pow(measure / std::max<size_t>(1, mPositions.size()), 1.0 / dimensions));
+        cellSize = std::max(cellSize, maxExtent / MaxCell);
+    }
+    mInvCellSize = 1 / cellSize;
+
+    for (std::vector<Entry>::iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+        it->mCell = MortonCode(GetCell(it->mPosition.x, 0), GetCell(it->mPosition.y, 1),
+            GetCell(it->mPosition.z, 2));
+    }
+    std::sort( mPositions.begin(), mPositions.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the cell coordinate of a value on one axis, clamped to the grid
+unsigned int SpatialGrid::GetCell( ai_real pValue, unsigned int pAxis) const
+{
+    const ai_real cell = (pValue - mMin[pAxis]) * mInvCellSize;
+
+    // also catches NaNs
+    if (!(cell > 0)) {
+        return 0;
+    }
+    if (cell >= MaxCell) {
+        return MaxCell;
+    }
+    return static_cast<unsigned int>( cell);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collects the positions in all cells overlapping the given box which pass the check.
+template <typename Check>
+void SpatialGrid::FindInBox( const aiVector3D& pMin, const aiVector3D& pMax, Check check,
+    std::vector<unsigned int>& poResults) const
+{
+    // clear the array in this strange fashion because a simple clear() would also deallocate
+    // the array which we want to avoid
+    poResults.erase( poResults.begin(), poResults.end());
+
+    // All positions lay inside the grid, so clamping the box to the grid never misses one.
+    const unsigned int minX = GetCell(pMin.x, 0), maxX = GetCell(pMax.x, 0);
+    const unsigned int minY = GetCell(pMin.y, 1), maxY = GetCell(pMax.y, 1);
+    const unsigned int minZ = GetCell(pMin.z, 2), maxZ = GetCell(pMax.z, 2);
+
+    // a huge radius touches more cells than there are positions, so just test all of them
+    const uint64_t numCells = uint64_t(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+    if (numCells > mPositions.size()) {
+        for (std::vector<Entry>::const_iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+            if (check(it->mPosition)) {
+                poResults.push_back(it->mIndex);
+            }
+        }
+        return;
+    }
+
+    for (unsigned int z = minZ; z <= maxZ; ++z) {
+        for (unsigned int y = minY; y <= maxY; ++y) {
+            for (unsigned int x = minX; x <= maxX; ++x) {
+                const uint64_t cell = MortonCode(x, y, z);
+                std::vector<Entry>::const_iterator it = std::lower_bound(mPositions.begin(),
+                    mPositions.end(), cell, CellLess());
+                for (; it != mPositions.end() && it->mCell == cell; ++it) {
+                    if (check(it->mPosition)) {
+                        poResults.push_back(it->mIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns all positions closer than the given radius.
+void SpatialGrid::FindPositions( const aiVector3D& pPosition,
+    ai_real pRadius, std::vector<unsigned int>& poResults) const
+{
+    const aiVector3D vRadius( pRadius);
+    const ai_real pSquared = pRadius*pRadius;
+    FindInBox(pPosition - vRadius, pPosition + vRadius, [&pPosition, pSquared]( const aiVector3D& v) {
+        return (v - pPosition).SquareLength() < pSquared;
+    }, poResults);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns all positions identical to the given position.
+void SpatialGrid::FindIdenticalPositions( const aiVector3D& pPosition,
+    std::vector<unsigned int>& poResults) const
+{
+    // SpatialSort accepts a squared distance of up to six units in the last place, which only
+    // denormalized numbers can reach - i.e. the positions must be (almost) bitwise identical.
+    static const ai_real maxSquared = 6 * std::numeric_limits<ai_real>::denorm_min();
+
+    // the box is just large enough to reach the neighbouring cells if the position
+    // lays on a cell boundary
+    const ai_real maxComponent = std::max(std::fabs(pPosition.x), std::max(std::fabs(pPosition.y), std::fabs(pPosition.z)));
+    const aiVector3D vTolerance( (maxComponent + 1) * std::numeric_limits<ai_real>::epsilon());
+    FindInBox(pPosition - vTolerance, pPosition + vTolerance, [&pPosition]( const aiVector3D& v) {
+        return (v - pPosition).SquareLength() <= maxSquared;
+    }, poResults);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialGrid::GenerateMappingTable(std::vector<unsigned int>& fill, ai_real pRadius) const
+{
+    fill.assign(mPositions.size(),UINT_MAX);
+
+    // every position which isn't mapped yet becomes a new output ID, together with all
+    // positions in its neighbourhood which aren't mapped yet
+    std::vector<unsigned int> found;
+    unsigned int t=0;
+    for (std::vector<Entry>::const_iterator it = mPositions.begin(); it != mPositions.end(); ++it) {
+        if (fill[it->mIndex] != UINT_MAX) {
+            continue;
+        }
+
+        fill[it->mIndex] = t;
+        FindPositions(it->mPosition, pRadius, found);
+        for (std::vector<unsigned int>::const_iterator f = found.begin(); f != found.end(); ++f) {
+            if (fill[*f] == UINT_MAX) {
+                fill[*f] = t;
+            }
+        }
+        ++t;
+    }
+
+#ifdef ASSIMP_BUILD_DEBUG
+
+    // debug invariant: mPositions[i].mIndex values must range from 0 to mPositions.size()-1
+    for (size_t i = 0; i < fill.size(); ++i) {
+        ai_assert(fill[i]<mPositions.size());
+    }
+
+#endif
+    return t;
+}
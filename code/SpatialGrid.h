@@ -0,0 +1,168 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SpatialGrid.h
+ *  Uniform grid to quickly find vertices close to a given location
+ */
+#ifndef AI_SPATIALGRID_H_INC
+#define AI_SPATIALGRID_H_INC
+
+#include <vector>
+#include <stdint.h>
+#include <assimp/types.h>
+
+namespace Assimp
+{
+
+// ------------------------------------------------------------------------------------------------
+/** Alternative to SpatialSort with the same interface. The bounding box of the positions is
+ * divided into uniform cells, the positions are stored sorted by the Morton code of their cell.
+ * A query only visits the cells which overlap the search radius, so unlike SpatialSort it does
+ * not degrade if many vertices have the same distance to a reference plane, as it happens
+ * for planar or axis-aligned CAD data. Queries with a radius much larger than a cell are
+ * slower than with SpatialSort, though. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SpatialGrid
+{
+public:
+
+    SpatialGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Constructs the grid from the given position array.
+     * @param pPositions Pointer to the first position vector of the array.
+     * @param pNumPositions Number of vectors to expect in that array.
+     * @param pElementOffset Offset in bytes from the beginning of one vector in memory
+     *   to the beginning of the next vector. */
+    SpatialGrid( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset);
+
+    /** Destructor */
+    ~SpatialGrid();
+
+public:
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the input data for the grid, see SpatialSort::Fill(). */
+    void Fill( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #Fill(), except the method appends to existing data in the grid. */
+    void Append( const aiVector3D* pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Computes the cell size and sorts all positions into their cells. Required before
+     *  the grid can be queried. */
+    void Finalize();
+
+    // ------------------------------------------------------------------------------------
+    /** Returns all positions closer than the given radius, see SpatialSort::FindPositions().
+     * @param pPosition The position to look for vertices.
+     * @param pRadius Maximal distance from the position a vertex may have to be counted in.
+     * @param poResults The container to store the indices of the found positions.
+     *   Will be emptied by the call so it may contain anything. */
+    void FindPositions( const aiVector3D& pPosition, ai_real pRadius,
+        std::vector<unsigned int>& poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Returns all positions identical to the given position, using the same tolerance
+     *  as SpatialSort::FindIdenticalPositions().
+     * @param pPosition The position to look for vertices.
+     * @param poResults The container to store the indices of the found positions.
+     *   Will be emptied by the call so it may contain anything.*/
+    void FindIdenticalPositions( const aiVector3D& pPosition,
+        std::vector<unsigned int>& poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Compute a table that maps each vertex ID referring to a spatially close
+     *  enough position to the same output ID. Output IDs are assigned in ascending order
+     *  from 0...n.
+     * @param fill Will be filled with numPositions entries.
+     * @param pRadius Maximal distance from the position a vertex may have to
+     *   be counted in.
+     *  @return Number of unique vertices (n).  */
+    unsigned int GenerateMappingTable(std::vector<unsigned int>& fill,
+        ai_real pRadius) const;
+
+protected:
+
+    /** Collects the positions in all cells overlapping the given box */
+    template <typename Check>
+    void FindInBox( const aiVector3D& pMin, const aiVector3D& pMax, Check check,
+        std::vector<unsigned int>& poResults) const;
+
+    /** Returns the cell coordinate of a value on one axis */
+    unsigned int GetCell( ai_real pValue, unsigned int pAxis) const;
+
+    /** An entry in the grid. Consists of a vertex index, its position and the
+     *  Morton code of its cell */
+    struct Entry
+    {
+        unsigned int mIndex; ///< The vertex referred by this entry
+        aiVector3D mPosition; ///< Position
+        uint64_t mCell; ///< Morton code of the cell
+
+        Entry() { /** intentionally not initialized.*/ }
+        Entry( unsigned int pIndex, const aiVector3D& pPosition)
+            : mIndex( pIndex), mPosition( pPosition), mCell( 0)
+        {   }
+
+        bool operator < (const Entry& e) const {
+            return mCell < e.mCell || (mCell == e.mCell && mIndex < e.mIndex);
+        }
+    };
+
+    // all positions, sorted by the Morton code of their cell
+    std::vector<Entry> mPositions;
+
+    // lower corner of the grid
+    aiVector3D mMin;
+
+    // reciprocal of the edge length of a cell
+    ai_real mInvCellSize;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SPATIALGRID_H_INC
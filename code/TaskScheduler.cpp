@@ -0,0 +1,333 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  TaskScheduler.cpp
+ *  @brief Implementation of the task scheduler
+ */
+#include "TaskScheduler.h"
+#include <algorithm>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#   include <atomic>
+#   include <condition_variable>
+#   include <deque>
+#   include <exception>
+#   include <memory>
+#   include <mutex>
+#   include <thread>
+#   include <vector>
+#endif
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Plain FIFO pool of worker threads, started on the first submitted task
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int numThreads)
+        : mNumThreads(numThreads)
+        , mStop(false)
+    {}
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        for (size_t i = 0; i < mThreads.size(); ++i) {
+            mThreads[i].join();
+        }
+    }
+
+    void Submit(Task* task)
+    {
+        if (!mNumThreads) {
+            task->Run();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mThreads.empty()) {
+                mThreads.reserve(mNumThreads);
+                for (unsigned int i = 0; i < mNumThreads; ++i) {
+                    mThreads.push_back(std::thread(&ThreadPool::Work, this));
+                }
+            }
+            mQueue.push_back(task);
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    void Work()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (;;) {
+            mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+            // on shutdown, drain the queue first so no task is lost
+            if (mQueue.empty()) {
+                return;
+            }
+            Task* task = mQueue.front();
+            mQueue.pop_front();
+
+            lock.unlock();
+            task->Run();
+            lock.lock();
+        }
+    }
+
+    const unsigned int mNumThreads;
+    bool mStop;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Task*> mQueue;
+    std::vector<std::thread> mThreads;
+};
+
+} // ! namespace Assimp
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// State of a single ParallelFor() call, shared by the caller and its helper tasks
+class ParallelForJob
+{
+public:
+    ParallelForJob(size_t count, const std::function<void (size_t)>& fn)
+        : mCount(count)
+        , mFn(fn)
+        , mNext(0)
+        , mActive(0)
+        , mFinished(false)
+    {}
+
+    // claim and run iterations until there are no more left
+    void Work()
+    {
+        for (size_t i = mNext++; i < mCount; i = mNext++) {
+            try {
+                mFn(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!mError) {
+                    mError = std::current_exception();
+                }
+                mNext = mCount;
+            }
+        }
+    }
+
+    // called by helpers, false if the caller is already done
+    bool Join()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFinished) {
+            return false;
+        }
+        ++mActive;
+        return true;
+    }
+
+    void Leave()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!--mActive) {
+            mCondition.notify_all();
+        }
+    }
+
+    // called by the caller, waits for the helpers which joined
+    void Finish()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mFinished = true;
+        mCondition.wait(lock, [this]() { return 0 == mActive; });
+        if (mError) {
+            std::rethrow_exception(mError);
+        }
+    }
+
+private:
+    const size_t mCount;
+    const std::function<void (size_t)>& mFn;
+    std::atomic<size_t> mNext;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    unsigned int mActive;
+    bool mFinished;
+    std::exception_ptr mError;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Helper task which lends its thread to a ParallelForJob
+class ParallelForTask : public Task
+{
+public:
+    explicit ParallelForTask(const std::shared_ptr<ParallelForJob>& job)
+        : mJob(job)
+    {}
+
+    void Run()
+    {
+        if (mJob->Join()) {
+            mJob->Work();
+            mJob->Leave();
+        }
+        delete this;
+    }
+
+private:
+    std::shared_ptr<ParallelForJob> mJob;
+};
+
+} // ! namespace
+
+#endif // !! ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+TaskScheduler::TaskScheduler(unsigned int numThreads, TaskExecutor* executor)
+    : mNumThreads(numThreads)
+    , mExecutor(executor)
+    , mPool()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    if (!mExecutor) {
+        // the thread calling ParallelFor() is one of the participants
+        mPool = new ThreadPool(GetConcurrency() - 1);
+    }
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+TaskScheduler::~TaskScheduler()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    delete mPool;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int TaskScheduler::GetConcurrency() const
+{
+#ifdef ASSIMP_BUILD_SINGLETHREADED
+    return 1;
+#else
+    unsigned int concurrency = mNumThreads;
+    if (mExecutor) {
+        const unsigned int available = std::max(1u, mExecutor->GetConcurrency());
+        concurrency = concurrency ? std::min(concurrency, available) : available;
+    }
+    else if (!concurrency) {
+        concurrency = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return concurrency;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::Submit(Task* task)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    if (mExecutor) {
+        mExecutor->Submit(task);
+        return;
+    }
+    if (mPool) {
+        mPool->Submit(task);
+        return;
+    }
+#endif
+    task->Run();
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::ParallelFor(size_t count, const std::function<void (size_t)>& fn,
+    unsigned int maxConcurrency)
+{
+    size_t participants = GetConcurrency();
+    if (maxConcurrency) {
+        participants = std::min(participants, static_cast<size_t>(maxConcurrency));
+    }
+    participants = std::min(participants, count);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    if (participants > 1) {
+        std::shared_ptr<ParallelForJob> job = std::make_shared<ParallelForJob>(count, fn);
+        for (size_t i = 1; i < participants; ++i) {
+            Submit(new ParallelForTask(job));
+        }
+        job->Work();
+        job->Finish();
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; ++i) {
+        fn(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::ParallelFor(TaskScheduler* scheduler, size_t count,
+    const std::function<void (size_t)>& fn, unsigned int maxConcurrency)
+{
+    if (scheduler) {
+        scheduler->ParallelFor(count, fn, maxConcurrency);
+        return;
+    }
+    if (1 == maxConcurrency || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    TaskScheduler temporary(maxConcurrency);
+    temporary.ParallelFor(count, fn);
+}
@@ -0,0 +1,130 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  TaskScheduler.h
+ *  @brief Declares the task scheduler shared by all parallel code paths
+ *    of an importer, see #AI_CONFIG_GLOB_MULTITHREADING.
+ */
+#ifndef AI_TASK_SCHEDULER_H_INC
+#define AI_TASK_SCHEDULER_H_INC
+
+#include <assimp/TaskExecutor.hpp>
+#include <functional>
+#include <stddef.h>
+
+namespace Assimp    {
+
+class ThreadPool;
+
+// ----------------------------------------------------------------------------------
+/** TaskScheduler: Runs parallel loops on a pool of worker threads.
+ *
+ *  The pool is either owned by the scheduler and started on first use, or
+ *  provided by the application as a #TaskExecutor. The scheduler is an
+ *  executor itself, so nested importers (see #BatchLoader) can share the
+ *  pool of their parent.
+ *
+ *  Loops are not pre-partitioned: every participating thread claims the
+ *  next pending iteration, so idle workers take over the work of busy ones.
+ *  The calling thread always takes part and never waits for workers that
+ *  haven't picked up the loop yet, which makes nested loops deadlock-free.
+*/
+// ----------------------------------------------------------------------------------
+class ASSIMP_API TaskScheduler : public TaskExecutor
+{
+public:
+    // ----------------------------------------------------------------
+    /** Constructs a scheduler.
+     *  @param numThreads Maximum number of threads to run parallel work
+     *    on, including the calling thread. 0 for the number of hardware
+     *    threads, 1 to run everything on the calling thread.
+     *  @param executor Optional executor to run the work on, not owned.
+     *    If NULL, the scheduler starts its own threads when needed. */
+    explicit TaskScheduler(unsigned int numThreads, TaskExecutor* executor = NULL);
+
+    ~TaskScheduler();
+
+    // ----------------------------------------------------------------
+    /** Returns the thread count the scheduler was constructed with */
+    unsigned int GetNumThreads() const {
+        return mNumThreads;
+    }
+
+    // ----------------------------------------------------------------
+    /** Returns the executor the scheduler was constructed with */
+    TaskExecutor* GetExecutor() const {
+        return mExecutor;
+    }
+
+    // ----------------------------------------------------------------
+    unsigned int GetConcurrency() const;
+
+    // ----------------------------------------------------------------
+    void Submit(Task* task);
+
+    // ----------------------------------------------------------------
+    /** Calls fn(i) for all i in [0,count) and waits for the calls to
+     *  complete. The first exception thrown by fn is rethrown after all
+     *  running calls have returned, pending iterations are skipped then.
+     *  @param maxConcurrency Maximum number of threads to use for this
+     *    loop, 0 for no limit beyond GetConcurrency(). */
+    void ParallelFor(size_t count, const std::function<void (size_t)>& fn,
+        unsigned int maxConcurrency = 0);
+
+    // ----------------------------------------------------------------
+    /** Same as above, for code which may not have a scheduler at hand.
+     *  If scheduler is NULL, a temporary one with maxConcurrency
+     *  threads is used. */
+    static void ParallelFor(TaskScheduler* scheduler, size_t count,
+        const std::function<void (size_t)>& fn, unsigned int maxConcurrency);
+
+private:
+    TaskScheduler(const TaskScheduler&);
+    TaskScheduler& operator=(const TaskScheduler&);
+
+    unsigned int mNumThreads;
+    TaskExecutor* mExecutor;
+    ThreadPool* mPool;
+};
+
+} // ! namespace Assimp
+
+#endif // AI_TASK_SCHEDULER_H_INC
@@ -62,6 +62,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "PolyTools.h"
 #include <memory>
+#include <algorithm>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -100,13 +101,13 @@ void TriangulateProcess::Execute( aiScene* pScene)
 {
     DefaultLogger::get()->debug("TriangulateProcess begin");
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-    {
-        if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
-            bHas = true;
-        }
-    }
+    // not std::vector<bool>, the meshes may be processed concurrently
+    std::vector<unsigned char> abHas( pScene->mNumMeshes, 0 );
+    ExecutePerMesh( pScene->mNumMeshes, [ this, pScene, &abHas ]( unsigned int a ) {
+        abHas[ a ] = TriangulateMesh( pScene->mMeshes[ a ] );
+    } );
+
+    const bool bHas = std::find( abHas.begin(), abHas.end(), 1 ) != abHas.end();
     if ( bHas ) {
         DefaultLogger::get()->info( "TriangulateProcess finished. All polygons have been triangulated." );
     } else {
@@ -489,7 +490,9 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
                 DefaultLogger::get()->debug("Dropping triangle with area 0");
                 --curOut;
 
-                delete[] f->mIndices;
+                if (!pMesh->IsInFaceIndexPool(f->mIndices)) {
+                    delete[] f->mIndices;
+                }
                 f->mIndices = NULL;
 
                 for(aiFace* ff = f; ff != curOut; ++ff) {
@@ -506,7 +509,10 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             ++f;
         }
 
-        delete[] face.mIndices;
+        // indices kept in the mesh's face index pool are released with the mesh
+        if (!pMesh->IsInFaceIndexPool(face.mIndices)) {
+            delete[] face.mIndices;
+        }
         face.mIndices = NULL;
     }
 
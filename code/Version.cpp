@@ -135,6 +135,9 @@ ASSIMP_API aiScene::aiScene()
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiScene::~aiScene()
 {
+    // arena memory is released at once with the private data
+    Assimp::SceneArena::ReleaseScene(this);
+
     // delete all sub-objects recursively
     delete mRootNode;
 
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "X3DImporter.hpp"
 #include "X3DImporter_Macro.hpp"
 #include "StringUtils.h"
+#include "ParsingUtils.h"
 
 // Header files, Assimp.
 #include "DefaultIOSystem.h"
@@ -79,10 +80,13 @@ void X3DImporter::Clear()
 	// Delete all elements
 	if(NodeElement_List.size())
 	{
-		for(std::list<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++) delete *it;
+		for(std::vector<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++) delete *it;
 
 		NodeElement_List.clear();
 	}
+
+	NodeElement_IdMap.clear();
+	NodeElement_IdMapSize = 0;
 }
 
 X3DImporter::~X3DImporter()
@@ -98,7 +102,32 @@ X3DImporter::~X3DImporter()
 
 bool X3DImporter::FindNodeElement_FromRoot(const std::string& pID, const CX3DImporter_NodeElement::EType pType, CX3DImporter_NodeElement** pElement)
 {
-	for(std::list<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++)
+	// Add elements created since previous search to index. Multimap keeps insertion order for equal keys, so the first suitable
+	// element in index is also the first one in NodeElement_List.
+	for(; NodeElement_IdMapSize < NodeElement_List.size(); NodeElement_IdMapSize++)
+	{
+		CX3DImporter_NodeElement* ne = NodeElement_List[NodeElement_IdMapSize];
+
+		if(!ne->ID.empty()) NodeElement_IdMap.insert(std::make_pair(ne->ID, ne));
+	}
+
+	typedef std::multimap<std::string, CX3DImporter_NodeElement*>::const_iterator IdMapIt;
+
+	const std::pair<IdMapIt, IdMapIt> range = NodeElement_IdMap.equal_range(pID);
+
+	for(IdMapIt it = range.first; it != range.second; it++)
+	{
+		// ID of element can be changed after indexing, so check it again.
+		if((it->second->Type == pType) && (it->second->ID == pID))
+		{
+			if(pElement != nullptr) *pElement = it->second;
+
+			return true;
+		}
+	}
+
+	// Element can be absent in index only if its ID was changed after indexing. Missing element is an error, so do full search.
+	for(std::vector<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++)
 	{
 		if(((*it)->Type == pType) && ((*it)->ID == pID))
 		{
@@ -106,7 +135,7 @@ bool X3DImporter::FindNodeElement_FromRoot(const std::string& pID, const CX3DImp
 
 			return true;
 		}
-	}// for(std::list<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++)
+	}// for(std::vector<CX3DImporter_NodeElement*>::iterator it = NodeElement_List.begin(); it != NodeElement_List.end(); it++)
 
 	return false;
 }
@@ -390,43 +419,37 @@ int32_t X3DImporter::XML_ReadNode_GetAttrVal_AsI32(const int pAttrIdx)
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsCol3f(const int pAttrIdx, aiColor3D& pValue)
 {
-    std::list<float> tlist;
-    std::list<float>::iterator it;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);
 	if(tlist.size() != 3) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
 
-	it = tlist.begin();
-	pValue.r = *it++;
-	pValue.g = *it++;
-	pValue.b = *it;
+	pValue.r = tlist[0];
+	pValue.g = tlist[1];
+	pValue.b = tlist[2];
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsVec2f(const int pAttrIdx, aiVector2D& pValue)
 {
-    std::list<float> tlist;
-    std::list<float>::iterator it;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);
 	if(tlist.size() != 2) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
 
-	it = tlist.begin();
-	pValue.x = *it++;
-	pValue.y = *it;
+	pValue.x = tlist[0];
+	pValue.y = tlist[1];
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsVec3f(const int pAttrIdx, aiVector3D& pValue)
 {
-    std::list<float> tlist;
-    std::list<float>::iterator it;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);
 	if(tlist.size() != 3) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
 
-	it = tlist.begin();
-	pValue.x = *it++;
-	pValue.y = *it++;
-	pValue.z = *it;
+	pValue.x = tlist[0];
+	pValue.y = tlist[1];
+	pValue.z = tlist[2];
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListB(const int pAttrIdx, std::list<bool>& pValue)
@@ -483,11 +506,30 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsArrB(const int pAttrIdx, std::vector
 	}
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListI32(const int pAttrIdx, std::list<int32_t>& pValue)
+/// Count values in a space separated attribute string, so the output arrays can be allocated once.
+static size_t CountListValues(const char* pStr, const char* pStrEnd)
+{
+    size_t count = 0;
+    bool in_value = false;
+
+	for(; pStr < pStrEnd; pStr++)
+	{
+		const bool space = (*pStr == ' ');
+
+		if(!space && !in_value) count++;
+
+		in_value = !space;
+	}
+
+	return count;
+}
+
+void X3DImporter::XML_ReadNode_GetAttrVal_AsArrI32(const int pAttrIdx, std::vector<int32_t>& pValue)
 {
     const char* tstr = mReader->getAttributeValue(pAttrIdx);
     const char* tstr_end = tstr + strlen(tstr);
 
+	pValue.reserve(pValue.size() + CountListValues(tstr, tstr_end));
 	do
 	{
 		const char* ostr;
@@ -504,238 +546,76 @@ void X3DImporter::XML_ReadNode_GetAttrVal_AsListI32(const int pAttrIdx, std::lis
 	} while(tstr < tstr_end);
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsArrI32(const int pAttrIdx, std::vector<int32_t>& pValue)
-{
-    std::list<int32_t> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListI32(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-		for(std::list<int32_t>::iterator it = tlist.begin(); it != tlist.end(); it++) pValue.push_back(*it);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListF(const int pAttrIdx, std::list<float>& pValue)
-{
-    std::string str_fixed;
-
-	// at first check string values like '.xxx'.
-	ParseHelper_FixTruncatedFloatString(mReader->getAttributeValue(pAttrIdx), str_fixed);
-	if(!str_fixed.size()) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
-
-	// and convert all values and place it in list.
-	const char* pstr = str_fixed.c_str();
-	const char* pstr_end = pstr + str_fixed.size();
-
-	do
-	{
-		float tvalf;
-
-		while((*pstr == ' ') && (pstr < pstr_end)) pstr++;// skip spaces between values.
-
-		if(pstr < pstr_end)// additional check, because attribute value can be ended with spaces.
-		{
-			pstr = fast_atoreal_move(pstr, tvalf, false);
-			pValue.push_back(tvalf);
-		}
-	} while(pstr < pstr_end);
-}
-
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrF(const int pAttrIdx, std::vector<float>& pValue)
 {
-    std::list<float> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-		for(std::list<float>::iterator it = tlist.begin(); it != tlist.end(); it++) pValue.push_back(*it);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListD(const int pAttrIdx, std::list<double>& pValue)
-{
-    std::string str_fixed;
-
-	// at first check string values like '.xxx'.
-	ParseHelper_FixTruncatedFloatString(mReader->getAttributeValue(pAttrIdx), str_fixed);
-	if(!str_fixed.size()) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
-
-	// and convert all values and place it in list.
-	const char* pstr = str_fixed.c_str();
-	const char* pstr_end = pstr + str_fixed.size();
-
-	do
-	{
-		double tvald;
+    const char* pstr = mReader->getAttributeValue(pAttrIdx);
+	if(!*pstr) Throw_ConvertFail_Str2ArrF(pstr);
 
-		while((*pstr == ' ') && (pstr < pstr_end)) pstr++;// skip spaces between values.
-
-		if(pstr < pstr_end)// additional check, because attribute value can be ended with spaces.
-		{
-			pstr = fast_atoreal_move(pstr, tvald, false);
-			pValue.push_back(tvald);
-		}
-	} while(pstr < pstr_end);
+	// values like '.xxx' are fine for fast_atoreal_move, no need to fix them first.
+	ReadRealList(pstr, pValue, false);
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsArrD(const int pAttrIdx, std::vector<double>& pValue)
 {
-    std::list<double> tlist;
+    const char* pstr = mReader->getAttributeValue(pAttrIdx);
+	if(!*pstr) Throw_ConvertFail_Str2ArrF(pstr);
 
-	XML_ReadNode_GetAttrVal_AsListD(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-		for(std::list<double>::iterator it = tlist.begin(); it != tlist.end(); it++) pValue.push_back(*it);
-	}
+	// values like '.xxx' are fine for fast_atoreal_move, no need to fix them first.
+	ReadRealList(pstr, pValue, false);
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListCol3f(const int pAttrIdx, std::list<aiColor3D>& pValue)
+void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol3f(const int pAttrIdx, std::vector<aiColor3D>& pValue)
 {
-    std::list<float> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);// read as list
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read as plain array
 	if(tlist.size() % 3) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
 
 	// copy data to array
-	for(std::list<float>::iterator it = tlist.begin(); it != tlist.end();)
-	{
-		aiColor3D tcol;
-
-		tcol.r = *it++;
-		tcol.g = *it++;
-		tcol.b = *it++;
-		pValue.push_back(tcol);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol3f(const int pAttrIdx, std::vector<aiColor3D>& pValue)
-{
-    std::list<aiColor3D> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListCol3f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-		for(std::list<aiColor3D>::iterator it = tlist.begin(); it != tlist.end(); it++) pValue.push_back(*it);
-	}
+	pValue.reserve(pValue.size() + tlist.size() / 3);
+	for(size_t i = 0, i_e = tlist.size(); i < i_e; i += 3) pValue.push_back(aiColor3D(tlist[i], tlist[i + 1], tlist[i + 2]));
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListCol4f(const int pAttrIdx, std::list<aiColor4D>& pValue)
+void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol4f(const int pAttrIdx, std::vector<aiColor4D>& pValue)
 {
-    std::list<float> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);// read as list
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read as plain array
 	if(tlist.size() % 4) Throw_ConvertFail_Str2ArrF(mReader->getAttributeValue(pAttrIdx));
 
 	// copy data to array
-	for(std::list<float>::iterator it = tlist.begin(); it != tlist.end();)
-	{
-		aiColor4D tcol;
-
-		tcol.r = *it++;
-		tcol.g = *it++;
-		tcol.b = *it++;
-		tcol.a = *it++;
-		pValue.push_back(tcol);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsArrCol4f(const int pAttrIdx, std::vector<aiColor4D>& pValue)
-{
-    std::list<aiColor4D> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListCol4f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiColor4D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	pValue.reserve(pValue.size() + tlist.size() / 4);
+	for(size_t i = 0, i_e = tlist.size(); i < i_e; i += 4) pValue.push_back(aiColor4D(tlist[i], tlist[i + 1], tlist[i + 2], tlist[i + 3]));
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec2f(const int pAttrIdx, std::list<aiVector2D>& pValue)
+void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec2f(const int pAttrIdx, std::vector<aiVector2D>& pValue)
 {
-    std::list<float> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);// read as list
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read as plain array
     if ( tlist.size() % 2 )
     {
         Throw_ConvertFail_Str2ArrF( mReader->getAttributeValue( pAttrIdx ) );
     }
 
 	// copy data to array
-	for(std::list<float>::iterator it = tlist.begin(); it != tlist.end();)
-	{
-		aiVector2D tvec;
-
-		tvec.x = *it++;
-		tvec.y = *it++;
-		pValue.push_back(tvec);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec2f(const int pAttrIdx, std::vector<aiVector2D>& pValue)
-{
-    std::list<aiVector2D> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListVec2f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiVector2D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	pValue.reserve(pValue.size() + tlist.size() / 2);
+	for(size_t i = 0, i_e = tlist.size(); i < i_e; i += 2) pValue.push_back(aiVector2D(tlist[i], tlist[i + 1]));
 }
 
-void X3DImporter::XML_ReadNode_GetAttrVal_AsListVec3f(const int pAttrIdx, std::list<aiVector3D>& pValue)
+void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec3f(const int pAttrIdx, std::vector<aiVector3D>& pValue)
 {
-    std::list<float> tlist;
+    std::vector<float> tlist;
 
-	XML_ReadNode_GetAttrVal_AsListF(pAttrIdx, tlist);// read as list
+	XML_ReadNode_GetAttrVal_AsArrF(pAttrIdx, tlist);// read as plain array
     if ( tlist.size() % 3 )
     {
         Throw_ConvertFail_Str2ArrF( mReader->getAttributeValue( pAttrIdx ) );
     }
 
 	// copy data to array
-	for(std::list<float>::iterator it = tlist.begin(); it != tlist.end();)
-	{
-		aiVector3D tvec;
-
-		tvec.x = *it++;
-		tvec.y = *it++;
-		tvec.z = *it++;
-		pValue.push_back(tvec);
-	}
-}
-
-void X3DImporter::XML_ReadNode_GetAttrVal_AsArrVec3f(const int pAttrIdx, std::vector<aiVector3D>& pValue)
-{
-    std::list<aiVector3D> tlist;
-
-	XML_ReadNode_GetAttrVal_AsListVec3f(pAttrIdx, tlist);// read as list
-	// and copy to array
-	if(tlist.size() > 0)
-	{
-		pValue.reserve(tlist.size());
-        for ( std::list<aiVector3D>::iterator it = tlist.begin(); it != tlist.end(); it++ )
-        {
-            pValue.push_back( *it );
-        }
-	}
+	pValue.reserve(pValue.size() + tlist.size() / 3);
+	for(size_t i = 0, i_e = tlist.size(); i < i_e; i += 3) pValue.push_back(aiVector3D(tlist[i], tlist[i + 1], tlist[i + 2]));
 }
 
 void X3DImporter::XML_ReadNode_GetAttrVal_AsListS(const int pAttrIdx, std::list<std::string>& pValue)
@@ -788,7 +668,7 @@ aiVector3D X3DImporter::GeometryHelper_Make_Point2D(const float pAngle, const fl
 }
 
 void X3DImporter::GeometryHelper_Make_Arc2D(const float pStartAngle, const float pEndAngle, const float pRadius, size_t pNumSegments,
-												std::list<aiVector3D>& pVertices)
+												std::vector<aiVector3D>& pVertices)
 {
 	// check argument values ranges.
     if ( ( pStartAngle < -AI_MATH_TWO_PI_F ) || ( pStartAngle > AI_MATH_TWO_PI_F ) )
@@ -824,18 +704,18 @@ void X3DImporter::GeometryHelper_Make_Arc2D(const float pStartAngle, const float
 	if(angle_full == AI_MATH_TWO_PI_F) pVertices.push_back(*pVertices.begin());
 }
 
-void X3DImporter::GeometryHelper_Extend_PointToLine(const std::list<aiVector3D>& pPoint, std::list<aiVector3D>& pLine)
+void X3DImporter::GeometryHelper_Extend_PointToLine(const std::vector<aiVector3D>& pPoint, std::vector<aiVector3D>& pLine)
 {
-    std::list<aiVector3D>::const_iterator pit = pPoint.begin();
-    std::list<aiVector3D>::const_iterator pit_last = pPoint.end();
-
-	pit_last--;
-
     if ( pPoint.size() < 2 )
     {
         Throw_ArgOutOfRange( "GeometryHelper_Extend_PointToLine.pPoint.size() can not be less than 2." );
     }
 
+    std::vector<aiVector3D>::const_iterator pit = pPoint.begin();
+    std::vector<aiVector3D>::const_iterator pit_last = pPoint.end() - 1;
+
+	pLine.reserve(pLine.size() + (pPoint.size() - 1) * 2);
+
 	// add first point of first line.
 	pLine.push_back(*pit++);
 	// add internal points
@@ -849,27 +729,23 @@ void X3DImporter::GeometryHelper_Extend_PointToLine(const std::list<aiVector3D>&
 	pLine.push_back(*pit);
 }
 
-void X3DImporter::GeometryHelper_Extend_PolylineIdxToLineIdx(const std::list<int32_t>& pPolylineCoordIdx, std::list<int32_t>& pLineCoordIdx)
+void X3DImporter::GeometryHelper_Extend_PolylineIdxToLineIdx(const std::vector<int32_t>& pPolylineCoordIdx, std::vector<int32_t>& pLineCoordIdx)
 {
-    std::list<int32_t>::const_iterator plit = pPolylineCoordIdx.begin();
+    const size_t idx_cnt = pPolylineCoordIdx.size();
 
-	while(plit != pPolylineCoordIdx.end())
+	// every segment of polyline become a line: "first point", "second point", delimiter.
+	pLineCoordIdx.reserve(pLineCoordIdx.size() + idx_cnt * 3);
+	for(size_t i = 0; i < idx_cnt; i++)
 	{
-		// add first point of polyline
-		pLineCoordIdx.push_back(*plit++);
-		while((*plit != (-1)) && (plit != pPolylineCoordIdx.end()))
-		{
-			std::list<int32_t>::const_iterator plit_next;
+		const size_t i_next = i + 1;
 
-			plit_next = plit, plit_next++;
-			pLineCoordIdx.push_back(*plit);// second point of previous line.
-			pLineCoordIdx.push_back(-1);// delimiter
-			if((*plit_next == (-1)) || (plit_next == pPolylineCoordIdx.end())) break;// current polyline is finished
+		if(pPolylineCoordIdx[i] == (-1)) continue;// skip polylines delimiter
+		if((i_next == idx_cnt) || (pPolylineCoordIdx[i_next] == (-1))) continue;// last point of current polyline
 
-			pLineCoordIdx.push_back(*plit);// first point of next line.
-			plit = plit_next;
-		}// while((*plit != (-1)) && (plit != pPolylineCoordIdx.end()))
-	}// while(plit != pPolylineCoordIdx.end())
+		pLineCoordIdx.push_back(pPolylineCoordIdx[i]);// first point of line.
+		pLineCoordIdx.push_back(pPolylineCoordIdx[i_next]);// second point of line.
+		pLineCoordIdx.push_back(-1);// delimiter
+	}// for(size_t i = 0; i < idx_cnt; i++)
 }
 
 #define MESH_RectParallelepiped_CREATE_VERT \
@@ -888,7 +764,7 @@ float x1, x2, y1, y2, z1, z2, hs; \
 	vert_set[6].Set(x1, y2, z1); \
 	vert_set[7].Set(x1, y1, z1)
 
-void X3DImporter::GeometryHelper_MakeQL_RectParallelepiped(const aiVector3D& pSize, std::list<aiVector3D>& pVertices)
+void X3DImporter::GeometryHelper_MakeQL_RectParallelepiped(const aiVector3D& pSize, std::vector<aiVector3D>& pVertices)
 {
 	MESH_RectParallelepiped_CREATE_VERT;
 	MACRO_FACE_ADD_QUAD_FA(true, pVertices, vert_set, 3, 2, 1, 0);// front
@@ -901,27 +777,22 @@ void X3DImporter::GeometryHelper_MakeQL_RectParallelepiped(const aiVector3D& pSi
 
 #undef MESH_RectParallelepiped_CREATE_VERT
 
-void X3DImporter::GeometryHelper_CoordIdxStr2FacesArr(const std::list<int32_t>& pCoordIdx, std::vector<aiFace>& pFaces, unsigned int& pPrimitiveTypes) const
+void X3DImporter::GeometryHelper_CoordIdxStr2FacesArr(const std::vector<int32_t>& pCoordIdx, std::vector<aiFace>& pFaces, unsigned int& pPrimitiveTypes) const
 {
-    std::list<int32_t> f_data(pCoordIdx);
     std::vector<unsigned int> inds;
     unsigned int prim_type = 0;
 
-    if ( f_data.back() != ( -1 ) )
-    {
-        f_data.push_back( -1 );
-    }
-
 	// reserve average size.
-	pFaces.reserve(f_data.size() / 3);
+	pFaces.reserve(pCoordIdx.size() / 3);
 	inds.reserve(4);
     //PrintVectorSet("build. ci", pCoordIdx);
-	for(std::list<int32_t>::iterator it = f_data.begin(); it != f_data.end(); it++)
+	for(std::vector<int32_t>::const_iterator it = pCoordIdx.begin(); it != pCoordIdx.end(); it++)
 	{
-		// when face is got count how many indices in it.
-		if(*it == (-1))
+		// when face is got count how many indices in it. Last face can be closed by end of array instead of delimiter.
+		if(*it != (-1)) inds.push_back(*it);
+
+		if((*it == (-1)) || ((it + 1 == pCoordIdx.end()) && !inds.empty()))
 		{
-			aiFace tface;
 			size_t ts;
 
 			ts = inds.size();
@@ -934,17 +805,17 @@ void X3DImporter::GeometryHelper_CoordIdxStr2FacesArr(const std::list<int32_t>&
 				default: prim_type |= aiPrimitiveType_POLYGON; break;
 			}
 
+			// construct face in place, copying of aiFace also copies indices array.
+			pFaces.push_back(aiFace());
+
+			aiFace& tface = pFaces.back();
+
 			tface.mNumIndices = static_cast<unsigned int>(ts);
 			tface.mIndices = new unsigned int[ts];
 			memcpy(tface.mIndices, inds.data(), ts * sizeof(unsigned int));
-			pFaces.push_back(tface);
 			inds.clear();
-		}// if(*it == (-1))
-		else
-		{
-			inds.push_back(*it);
-		}// if(*it == (-1)) else
-	}// for(std::list<int32_t>::iterator it = f_data.begin(); it != f_data.end(); it++)
+		}// if((*it == (-1)) || ((it + 1 == pCoordIdx.end()) && !inds.empty()))
+	}// for(std::vector<int32_t>::const_iterator it = pCoordIdx.begin(); it != pCoordIdx.end(); it++)
 //PrintVectorSet("build. faces", pCoordIdx);
 
 	pPrimitiveTypes = prim_type;
@@ -953,25 +824,25 @@ void X3DImporter::GeometryHelper_CoordIdxStr2FacesArr(const std::list<int32_t>&
 
 mg_m_err:
 
-	for(size_t i = 0, i_e = pFaces.size(); i < i_e; i++) delete [] pFaces.at(i).mIndices;
-
+	// indices arrays are freed by aiFace destructor.
 	pFaces.clear();
 }
 
-void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<aiColor3D>& pColors, const bool pColorPerVertex) const
+void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::vector<aiColor3D>& pColors, const bool pColorPerVertex) const
 {
-std::list<aiColor4D> tcol;
+std::vector<aiColor4D> tcol;
 
 	// create RGBA array from RGB.
-	for(std::list<aiColor3D>::const_iterator it = pColors.begin(); it != pColors.end(); it++) tcol.push_back(aiColor4D((*it).r, (*it).g, (*it).b, 1));
+	tcol.reserve(pColors.size());
+	for(std::vector<aiColor3D>::const_iterator it = pColors.begin(); it != pColors.end(); it++) tcol.push_back(aiColor4D((*it).r, (*it).g, (*it).b, 1));
 
 	// call existing function for adding RGBA colors
 	MeshGeometry_AddColor(pMesh, tcol, pColorPerVertex);
 }
 
-void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<aiColor4D>& pColors, const bool pColorPerVertex) const
+void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::vector<aiColor4D>& pColors, const bool pColorPerVertex) const
 {
-    std::list<aiColor4D>::const_iterator col_it = pColors.begin();
+    std::vector<aiColor4D>::const_iterator col_it = pColors.begin();
 
 	if(pColorPerVertex)
 	{
@@ -1008,13 +879,14 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<aiColor4D
 	}// if(pColorPerVertex) else
 }
 
-void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>& pCoordIdx, const std::list<int32_t>& pColorIdx,
-										const std::list<aiColor3D>& pColors, const bool pColorPerVertex) const
+void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::vector<int32_t>& pCoordIdx, const std::vector<int32_t>& pColorIdx,
+										const std::vector<aiColor3D>& pColors, const bool pColorPerVertex) const
 {
-    std::list<aiColor4D> tcol;
+    std::vector<aiColor4D> tcol;
 
 	// create RGBA array from RGB.
-    for ( std::list<aiColor3D>::const_iterator it = pColors.begin(); it != pColors.end(); it++ )
+	tcol.reserve(pColors.size());
+    for ( std::vector<aiColor3D>::const_iterator it = pColors.begin(); it != pColors.end(); it++ )
     {
         tcol.push_back( aiColor4D( ( *it ).r, ( *it ).g, ( *it ).b, 1 ) );
     }
@@ -1023,25 +895,16 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
 	MeshGeometry_AddColor(pMesh, pCoordIdx, pColorIdx, tcol, pColorPerVertex);
 }
 
-void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>& pCoordIdx, const std::list<int32_t>& pColorIdx,
-										const std::list<aiColor4D>& pColors, const bool pColorPerVertex) const
+void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::vector<int32_t>& pCoordIdx, const std::vector<int32_t>& pColorIdx,
+										const std::vector<aiColor4D>& pColors, const bool pColorPerVertex) const
 {
     std::vector<aiColor4D> col_tgt_arr;
-    std::list<aiColor4D> col_tgt_list;
-    std::vector<aiColor4D> col_arr_copy;
 
     if ( pCoordIdx.size() == 0 )
     {
         throw DeadlyImportError( "MeshGeometry_AddColor2. pCoordIdx can not be empty." );
     }
 
-	// copy list to array because we are need indexed access to colors.
-	col_arr_copy.reserve(pColors.size());
-    for ( std::list<aiColor4D>::const_iterator it = pColors.begin(); it != pColors.end(); it++ )
-    {
-        col_arr_copy.push_back( *it );
-    }
-
 	if(pColorPerVertex)
 	{
 		if(pColorIdx.size() > 0)
@@ -1054,7 +917,7 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
 			}
 			// create list with colors for every vertex.
 			col_tgt_arr.resize(pMesh.mNumVertices);
-			for(std::list<int32_t>::const_iterator colidx_it = pColorIdx.begin(), coordidx_it = pCoordIdx.begin(); colidx_it != pColorIdx.end(); colidx_it++, coordidx_it++)
+			for(std::vector<int32_t>::const_iterator colidx_it = pColorIdx.begin(), coordidx_it = pCoordIdx.begin(); colidx_it != pColorIdx.end(); colidx_it++, coordidx_it++)
 			{
                 if ( *colidx_it == ( -1 ) )
                 {
@@ -1069,7 +932,7 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
                     throw DeadlyImportError( "MeshGeometry_AddColor2. Color idx is out of range." );
                 }
 
-				col_tgt_arr[*coordidx_it] = col_arr_copy[*colidx_it];
+				col_tgt_arr[*coordidx_it] = pColors[*colidx_it];
 			}
 		}// if(pColorIdx.size() > 0)
 		else
@@ -1085,7 +948,7 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
 			col_tgt_arr.resize(pMesh.mNumVertices);
             for ( size_t i = 0; i < pMesh.mNumVertices; i++ )
             {
-                col_tgt_arr[ i ] = col_arr_copy[ i ];
+                col_tgt_arr[ i ] = pColors[ i ];
             }
 		}// if(pColorIdx.size() > 0) else
 	}// if(pColorPerVertex)
@@ -1102,12 +965,12 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
 			// create list with colors for every vertex using faces indices.
 			col_tgt_arr.resize(pMesh.mNumFaces);
 
-			std::list<int32_t>::const_iterator colidx_it = pColorIdx.begin();
+			std::vector<int32_t>::const_iterator colidx_it = pColorIdx.begin();
 			for(size_t fi = 0; fi < pMesh.mNumFaces; fi++)
 			{
 				if((unsigned int)*colidx_it > pMesh.mNumFaces) throw DeadlyImportError("MeshGeometry_AddColor2. Face idx is out of range.");
 
-				col_tgt_arr[fi] = col_arr_copy[*colidx_it++];
+				col_tgt_arr[fi] = pColors[*colidx_it++];
 			}
 		}// if(pColorIdx.size() > 0)
 		else
@@ -1121,33 +984,23 @@ void X3DImporter::MeshGeometry_AddColor(aiMesh& pMesh, const std::list<int32_t>&
 			}
 			// create list with colors for every vertex using faces indices.
 			col_tgt_arr.resize(pMesh.mNumFaces);
-			for(size_t fi = 0; fi < pMesh.mNumFaces; fi++) col_tgt_arr[fi] = col_arr_copy[fi];
+			for(size_t fi = 0; fi < pMesh.mNumFaces; fi++) col_tgt_arr[fi] = pColors[fi];
 
 		}// if(pColorIdx.size() > 0) else
 	}// if(pColorPerVertex) else
 
-	// copy array to list for calling function that add colors.
-	for(std::vector<aiColor4D>::const_iterator it = col_tgt_arr.begin(); it != col_tgt_arr.end(); it++) col_tgt_list.push_back(*it);
-	// add prepared colors list to mesh.
-	MeshGeometry_AddColor(pMesh, col_tgt_list, pColorPerVertex);
+	// add prepared colors array to mesh.
+	MeshGeometry_AddColor(pMesh, col_tgt_arr, pColorPerVertex);
 }
 
-void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<int32_t>& pCoordIdx, const std::list<int32_t>& pNormalIdx,
-								const std::list<aiVector3D>& pNormals, const bool pNormalPerVertex) const
+void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::vector<int32_t>& pCoordIdx, const std::vector<int32_t>& pNormalIdx,
+								const std::vector<aiVector3D>& pNormals, const bool pNormalPerVertex) const
 {
     std::vector<size_t> tind;
-    std::vector<aiVector3D> norm_arr_copy;
-
-	// copy list to array because we are need indexed access to normals.
-	norm_arr_copy.reserve(pNormals.size());
-    for ( std::list<aiVector3D>::const_iterator it = pNormals.begin(); it != pNormals.end(); it++ )
-    {
-        norm_arr_copy.push_back( *it );
-    }
 
 	if(pNormalPerVertex)
 	{
-		const std::list<int32_t>* srcidx;
+		const std::vector<int32_t>* srcidx;
 
 		if(pNormalIdx.size() > 0)
 		{
@@ -1162,7 +1015,7 @@ void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<int32_t>
 		}
 
 		tind.reserve(srcidx->size());
-		for(std::list<int32_t>::const_iterator it = srcidx->begin(); it != srcidx->end(); it++)
+		for(std::vector<int32_t>::const_iterator it = srcidx->begin(); it != srcidx->end(); it++)
 		{
 			if(*it != (-1)) tind.push_back(*it);
 		}
@@ -1171,11 +1024,11 @@ void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<int32_t>
 		pMesh.mNormals = new aiVector3D[pMesh.mNumVertices];
 		for(size_t i = 0; (i < pMesh.mNumVertices) && (i < tind.size()); i++)
 		{
-			if(tind[i] >= norm_arr_copy.size())
+			if(tind[i] >= pNormals.size())
 				throw DeadlyImportError("MeshGeometry_AddNormal. Normal index(" + to_string(tind[i]) +
-										") is out of range. Normals count: " + to_string(norm_arr_copy.size()) + ".");
+										") is out of range. Normals count: " + to_string(pNormals.size()) + ".");
 
-			pMesh.mNormals[i] = norm_arr_copy[tind[i]];
+			pMesh.mNormals[i] = pNormals[tind[i]];
 		}
 	}// if(pNormalPerVertex)
 	else
@@ -1184,10 +1037,7 @@ void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<int32_t>
 		{
 			if(pMesh.mNumFaces != pNormalIdx.size()) throw DeadlyImportError("Normals faces count must be equal to mesh faces count.");
 
-			std::list<int32_t>::const_iterator normidx_it = pNormalIdx.begin();
-
-			tind.reserve(pNormalIdx.size());
-			for(size_t i = 0, i_e = pNormalIdx.size(); i < i_e; i++) tind.push_back(*normidx_it++);
+			tind.assign(pNormalIdx.begin(), pNormalIdx.end());
 
 		}
 		else
@@ -1203,15 +1053,15 @@ void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<int32_t>
 		{
 			aiVector3D tnorm;
 
-			tnorm = norm_arr_copy[tind[fi]];
+			tnorm = pNormals[tind[fi]];
 			for(size_t vi = 0, vi_e = pMesh.mFaces[fi].mNumIndices; vi < vi_e; vi++) pMesh.mNormals[pMesh.mFaces[fi].mIndices[vi]] = tnorm;
 		}
 	}// if(pNormalPerVertex) else
 }
 
-void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<aiVector3D>& pNormals, const bool pNormalPerVertex) const
+void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::vector<aiVector3D>& pNormals, const bool pNormalPerVertex) const
 {
-    std::list<aiVector3D>::const_iterator norm_it = pNormals.begin();
+    std::vector<aiVector3D>::const_iterator norm_it = pNormals.begin();
 
 	if(pNormalPerVertex)
 	{
@@ -1237,16 +1087,16 @@ void X3DImporter::MeshGeometry_AddNormal(aiMesh& pMesh, const std::list<aiVector
 	}// if(pNormalPerVertex) else
 }
 
-void X3DImporter::MeshGeometry_AddTexCoord(aiMesh& pMesh, const std::list<int32_t>& pCoordIdx, const std::list<int32_t>& pTexCoordIdx,
-								const std::list<aiVector2D>& pTexCoords) const
+void X3DImporter::MeshGeometry_AddTexCoord(aiMesh& pMesh, const std::vector<int32_t>& pCoordIdx, const std::vector<int32_t>& pTexCoordIdx,
+								const std::vector<aiVector2D>& pTexCoords) const
 {
     std::vector<aiVector3D> texcoord_arr_copy;
     std::vector<aiFace> faces;
     unsigned int prim_type;
 
-	// copy list to array because we are need indexed access to normals.
+	// convert aiVector2D to aiVector3D.
 	texcoord_arr_copy.reserve(pTexCoords.size());
-	for(std::list<aiVector2D>::const_iterator it = pTexCoords.begin(); it != pTexCoords.end(); it++)
+	for(std::vector<aiVector2D>::const_iterator it = pTexCoords.begin(); it != pTexCoords.end(); it++)
 	{
 		texcoord_arr_copy.push_back(aiVector3D((*it).x, (*it).y, 0));
 	}
@@ -1285,32 +1135,23 @@ void X3DImporter::MeshGeometry_AddTexCoord(aiMesh& pMesh, const std::list<int32_
 	}// for(size_t fi = 0, fi_e = faces.size(); fi < fi_e; fi++)
 }
 
-void X3DImporter::MeshGeometry_AddTexCoord(aiMesh& pMesh, const std::list<aiVector2D>& pTexCoords) const
+void X3DImporter::MeshGeometry_AddTexCoord(aiMesh& pMesh, const std::vector<aiVector2D>& pTexCoords) const
 {
-    std::vector<aiVector3D> tc_arr_copy;
-
     if ( pTexCoords.size() != pMesh.mNumVertices )
     {
         throw DeadlyImportError( "MeshGeometry_AddTexCoord. Texture coordinates and vertices count must be equal." );
     }
 
-	// copy list to array because we are need convert aiVector2D to aiVector3D and also get indexed access as a bonus.
-	tc_arr_copy.reserve(pTexCoords.size());
-    for ( std::list<aiVector2D>::const_iterator it = pTexCoords.begin(); it != pTexCoords.end(); it++ )
-    {
-        tc_arr_copy.push_back( aiVector3D( ( *it ).x, ( *it ).y, 0 ) );
-    }
-
-	// copy texture coordinates to mesh
+	// copy texture coordinates to mesh, aiVector2D is converted to aiVector3D.
 	pMesh.mTextureCoords[0] = new aiVector3D[pMesh.mNumVertices];
 	pMesh.mNumUVComponents[0] = 2;
     for ( size_t i = 0; i < pMesh.mNumVertices; i++ )
     {
-        pMesh.mTextureCoords[ 0 ][ i ] = tc_arr_copy[ i ];
+        pMesh.mTextureCoords[ 0 ][ i ] = aiVector3D( pTexCoords[ i ].x, pTexCoords[ i ].y, 0 );
     }
 }
 
-aiMesh* X3DImporter::GeometryHelper_MakeMesh(const std::list<int32_t>& pCoordIdx, const std::list<aiVector3D>& pVertices) const
+aiMesh* X3DImporter::GeometryHelper_MakeMesh(const std::vector<int32_t>& pCoordIdx, const std::vector<aiVector3D>& pVertices) const
 {
     std::vector<aiFace> faces;
     unsigned int prim_type = 0;
@@ -1330,18 +1171,19 @@ aiMesh* X3DImporter::GeometryHelper_MakeMesh(const std::list<int32_t>& pCoordIdx
 	// faces
 	tmesh->mFaces = new aiFace[ts];
 	tmesh->mNumFaces = static_cast<unsigned int>(ts);
-	for(size_t i = 0; i < ts; i++) tmesh->mFaces[i] = faces.at(i);
+	for(size_t i = 0; i < ts; i++)
+	{
+		// take ownership of indices array, there is no need to copy it.
+		tmesh->mFaces[i].mNumIndices = faces[i].mNumIndices;
+		tmesh->mFaces[i].mIndices = faces[i].mIndices;
+		faces[i].mIndices = nullptr;
+	}
 
 	// vertices
-	std::list<aiVector3D>::const_iterator vit = pVertices.begin();
-
 	ts = pVertices.size();
 	tmesh->mVertices = new aiVector3D[ts];
 	tmesh->mNumVertices = static_cast<unsigned int>(ts);
-    for ( size_t i = 0; i < ts; i++ )
-    {
-        tmesh->mVertices[ i ] = *vit++;
-    }
+	if(ts > 0) memcpy(tmesh->mVertices, pVertices.data(), ts * sizeof(aiVector3D));
 
 	// set primitives type and return result.
 	tmesh->mPrimitiveTypes = prim_type;
@@ -89,7 +89,7 @@ void X3DImporter::ParseNode_Geometry2D_Arc2D()
 		if(!def.empty()) ne->ID = def;
 
 		// create point list of geometry object and convert it to line set.
-		std::list<aiVector3D> tlist;
+		std::vector<aiVector3D> tlist;
 
 		GeometryHelper_Make_Arc2D(startAngle, endAngle, radius, 10, tlist);///TODO: IME - AI_CONFIG for NumSeg
 		GeometryHelper_Extend_PointToLine(tlist, ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices);
@@ -159,7 +159,7 @@ void X3DImporter::ParseNode_Geometry2D_ArcClose2D()
 		// add chord or two radiuses only if not a circle was defined
 		if(!((std::fabs(endAngle - startAngle) >= AI_MATH_TWO_PI_F) || (endAngle == startAngle)))
 		{
-			std::list<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
+			std::vector<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
 
 			if((closureType == "PIE") || (closureType == "\"PIE\""))
 				vlist.push_back(aiVector3D(0, 0, 0));// center point - first radial line
@@ -208,7 +208,7 @@ void X3DImporter::ParseNode_Geometry2D_Circle2D()
 		if(!def.empty()) ne->ID = def;
 
 		// create point list of geometry object and convert it to line set.
-		std::list<aiVector3D> tlist;
+		std::vector<aiVector3D> tlist;
 
 		GeometryHelper_Make_Arc2D(0, 0, radius, 10, tlist);///TODO: IME - AI_CONFIG for NumSeg
 		GeometryHelper_Extend_PointToLine(tlist, ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices);
@@ -258,7 +258,7 @@ void X3DImporter::ParseNode_Geometry2D_Disk2D()
 	}
 	else
 	{
-		std::list<aiVector3D> tlist_o, tlist_i;
+		std::vector<aiVector3D> tlist_o, tlist_i;
 
 		if(innerRadius > outerRadius) Throw_IncorrectAttrValue("innerRadius");
 
@@ -283,7 +283,7 @@ void X3DImporter::ParseNode_Geometry2D_Disk2D()
 		}
 		else
 		{// make disk
-			std::list<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
+			std::vector<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
 
 			GeometryHelper_Make_Arc2D(0, 0, innerRadius, 10, tlist_i);// inner circle
 			//
@@ -292,7 +292,7 @@ void X3DImporter::ParseNode_Geometry2D_Disk2D()
 			if(tlist_i.size() < 2) throw DeadlyImportError("Disk2D. Not enough points for creating quad list.");// tlist_i and tlist_o has equal size.
 
 			// add all quads except last
-			for(std::list<aiVector3D>::iterator it_i = tlist_i.begin(), it_o = tlist_o.begin(); it_i != tlist_i.end();)
+			for(std::vector<aiVector3D>::iterator it_i = tlist_i.begin(), it_o = tlist_o.begin(); it_i != tlist_i.end();)
 			{
 				// do not forget - CCW direction
 				vlist.push_back(*it_i++);// 1st point
@@ -329,12 +329,12 @@ void X3DImporter::ParseNode_Geometry2D_Disk2D()
 void X3DImporter::ParseNode_Geometry2D_Polyline2D()
 {
     std::string def, use;
-    std::list<aiVector2D> lineSegments;
+    std::vector<aiVector2D> lineSegments;
     CX3DImporter_NodeElement* ne( nullptr );
 
 	MACRO_ATTRREAD_LOOPBEG;
 		MACRO_ATTRREAD_CHECKUSEDEF_RET(def, use);
-		MACRO_ATTRREAD_CHECK_REF("lineSegments", lineSegments, XML_ReadNode_GetAttrVal_AsListVec2f);
+		MACRO_ATTRREAD_CHECK_REF("lineSegments", lineSegments, XML_ReadNode_GetAttrVal_AsArrVec2f);
 	MACRO_ATTRREAD_LOOPEND;
 
 	// if "USE" defined then find already defined element.
@@ -351,10 +351,10 @@ void X3DImporter::ParseNode_Geometry2D_Polyline2D()
 		//
 		// convert read point list of geometry object to line set.
 		//
-		std::list<aiVector3D> tlist;
+		std::vector<aiVector3D> tlist;
 
 		// convert vec2 to vec3
-		for(std::list<aiVector2D>::iterator it2 = lineSegments.begin(); it2 != lineSegments.end(); it2++) tlist.push_back(aiVector3D(it2->x, it2->y, 0));
+		for(std::vector<aiVector2D>::iterator it2 = lineSegments.begin(); it2 != lineSegments.end(); it2++) tlist.push_back(aiVector3D(it2->x, it2->y, 0));
 
 		// convert point set to line set
 		GeometryHelper_Extend_PointToLine(tlist, ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices);
@@ -377,12 +377,12 @@ void X3DImporter::ParseNode_Geometry2D_Polyline2D()
 void X3DImporter::ParseNode_Geometry2D_Polypoint2D()
 {
     std::string def, use;
-    std::list<aiVector2D> point;
+    std::vector<aiVector2D> point;
     CX3DImporter_NodeElement* ne( nullptr );
 
 	MACRO_ATTRREAD_LOOPBEG;
 		MACRO_ATTRREAD_CHECKUSEDEF_RET(def, use);
-		MACRO_ATTRREAD_CHECK_REF("point", point, XML_ReadNode_GetAttrVal_AsListVec2f);
+		MACRO_ATTRREAD_CHECK_REF("point", point, XML_ReadNode_GetAttrVal_AsArrVec2f);
 	MACRO_ATTRREAD_LOOPEND;
 
 	// if "USE" defined then find already defined element.
@@ -397,7 +397,7 @@ void X3DImporter::ParseNode_Geometry2D_Polypoint2D()
 		if(!def.empty()) ne->ID = def;
 
 		// convert vec2 to vec3
-		for(std::list<aiVector2D>::iterator it2 = point.begin(); it2 != point.end(); it2++)
+		for(std::vector<aiVector2D>::iterator it2 = point.begin(); it2 != point.end(); it2++)
 		{
 			((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices.push_back(aiVector3D(it2->x, it2->y, 0));
 		}
@@ -447,7 +447,7 @@ void X3DImporter::ParseNode_Geometry2D_Rectangle2D()
 		float x2 = size.x / 2.0f;
 		float y1 = -size.y / 2.0f;
 		float y2 = size.y / 2.0f;
-		std::list<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
+		std::vector<aiVector3D>& vlist = ((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices;// just short alias.
 
 		vlist.push_back(aiVector3D(x2, y1, 0));// 1st point
 		vlist.push_back(aiVector3D(x2, y2, 0));// 2nd point
@@ -475,12 +475,12 @@ void X3DImporter::ParseNode_Geometry2D_TriangleSet2D()
 {
     std::string def, use;
     bool solid = false;
-    std::list<aiVector2D> vertices;
+    std::vector<aiVector2D> vertices;
     CX3DImporter_NodeElement* ne( nullptr );
 
 	MACRO_ATTRREAD_LOOPBEG;
 		MACRO_ATTRREAD_CHECKUSEDEF_RET(def, use);
-		MACRO_ATTRREAD_CHECK_REF("vertices", vertices, XML_ReadNode_GetAttrVal_AsListVec2f);
+		MACRO_ATTRREAD_CHECK_REF("vertices", vertices, XML_ReadNode_GetAttrVal_AsArrVec2f);
 		MACRO_ATTRREAD_CHECK_RET("solid", solid, XML_ReadNode_GetAttrVal_AsBool);
 	MACRO_ATTRREAD_LOOPEND;
 
@@ -498,7 +498,7 @@ void X3DImporter::ParseNode_Geometry2D_TriangleSet2D()
 		if(!def.empty()) ne->ID = def;
 
 		// convert vec2 to vec3
-		for(std::list<aiVector2D>::iterator it2 = vertices.begin(); it2 != vertices.end(); it2++)
+		for(std::vector<aiVector2D>::iterator it2 = vertices.begin(); it2 != vertices.end(); it2++)
 		{
 			((CX3DImporter_NodeElement_Geometry2D*)ne)->Vertices.push_back(aiVector3D(it2->x, it2->y, 0));
 		}
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Header files, stdlib.
 #include <list>
 #include <string>
+#include <vector>
 
 /// \class CX3DImporter_NodeElement
 /// Base class for elements of nodes.
@@ -278,7 +279,7 @@ struct CX3DImporter_NodeElement_MetaBoolean : public CX3DImporter_NodeElement_Me
 /// This struct describe metavalue of type double.
 struct CX3DImporter_NodeElement_MetaDouble : public CX3DImporter_NodeElement_Meta
 {
-	std::list<double> Value;///< Stored value.
+	std::vector<double> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_MetaDouble(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -293,7 +294,7 @@ struct CX3DImporter_NodeElement_MetaDouble : public CX3DImporter_NodeElement_Met
 /// This struct describe metavalue of type float.
 struct CX3DImporter_NodeElement_MetaFloat : public CX3DImporter_NodeElement_Meta
 {
-	std::list<float> Value;///< Stored value.
+	std::vector<float> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_MetaFloat(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -308,7 +309,7 @@ struct CX3DImporter_NodeElement_MetaFloat : public CX3DImporter_NodeElement_Meta
 /// This struct describe metavalue of type integer.
 struct CX3DImporter_NodeElement_MetaInteger : public CX3DImporter_NodeElement_Meta
 {
-	std::list<int32_t> Value;///< Stored value.
+	std::vector<int32_t> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_MetaInteger(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -353,7 +354,7 @@ struct CX3DImporter_NodeElement_MetaString : public CX3DImporter_NodeElement_Met
 /// This struct hold <Color> value.
 struct CX3DImporter_NodeElement_Color : public CX3DImporter_NodeElement
 {
-	std::list<aiColor3D> Value;///< Stored value.
+	std::vector<aiColor3D> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_Color(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -368,7 +369,7 @@ struct CX3DImporter_NodeElement_Color : public CX3DImporter_NodeElement
 /// This struct hold <ColorRGBA> value.
 struct CX3DImporter_NodeElement_ColorRGBA : public CX3DImporter_NodeElement
 {
-	std::list<aiColor4D> Value;///< Stored value.
+	std::vector<aiColor4D> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_ColorRGBA(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -383,7 +384,7 @@ struct CX3DImporter_NodeElement_ColorRGBA : public CX3DImporter_NodeElement
 /// This struct hold <Coordinate> value.
 struct CX3DImporter_NodeElement_Coordinate : public CX3DImporter_NodeElement
 {
-	std::list<aiVector3D> Value;///< Stored value.
+	std::vector<aiVector3D> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_Coordinate(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -398,7 +399,7 @@ struct CX3DImporter_NodeElement_Coordinate : public CX3DImporter_NodeElement
 /// This struct hold <Normal> value.
 struct CX3DImporter_NodeElement_Normal : public CX3DImporter_NodeElement
 {
-	std::list<aiVector3D> Value;///< Stored value.
+	std::vector<aiVector3D> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_Normal(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -413,7 +414,7 @@ struct CX3DImporter_NodeElement_Normal : public CX3DImporter_NodeElement
 /// This struct hold <TextureCoordinate> value.
 struct CX3DImporter_NodeElement_TextureCoordinate : public CX3DImporter_NodeElement
 {
-	std::list<aiVector2D> Value;///< Stored value.
+	std::vector<aiVector2D> Value;///< Stored value.
 
 	/// \fn CX3DImporter_NodeElement_TextureCoordinate(CX3DImporter_NodeElement* pParent)
 	/// Constructor
@@ -434,7 +435,7 @@ class CX3DImporter_NodeElement_Geometry2D : public CX3DImporter_NodeElement
 
 public:
 
-	std::list<aiVector3D> Vertices;///< Vertices list.
+	std::vector<aiVector3D> Vertices;///< Vertices list.
 	size_t NumIndices;///< Number of indices in one face.
 	bool Solid;///< Flag: if true then render must use back-face culling, else render must draw both sides of object.
 
@@ -474,7 +475,7 @@ class CX3DImporter_NodeElement_Geometry3D : public CX3DImporter_NodeElement
 
 public:
 
-	std::list<aiVector3D> Vertices;///< Vertices list.
+	std::vector<aiVector3D> Vertices;///< Vertices list.
 	size_t NumIndices;///< Number of indices in one face.
 	bool Solid;///< Flag: if true then render must use back-face culling, else render must draw both sides of object.
 
@@ -520,7 +521,7 @@ public:
 	/// If the angle between the geometric normals of two adjacent faces is less than the crease angle, normals shall be calculated so that the faces are
 	/// shaded smoothly across the edge; otherwise, normals shall be calculated so that a lighting discontinuity across the edge is produced.
 	float CreaseAngle;
-	std::list<int32_t> CoordIdx;///< Coordinates list by faces. In X3D format: "-1" - delimiter for faces.
+	std::vector<int32_t> CoordIdx;///< Coordinates list by faces. In X3D format: "-1" - delimiter for faces.
 
 	/***********************************************/
 	/****************** Functions ******************/
@@ -566,21 +567,21 @@ public:
 	/// direction. If normals are not generated but are supplied using a Normal node, and the orientation of the normals does not match the setting of the
 	/// ccw field, results are undefined.
 	bool CCW;
-	std::list<int32_t> ColorIndex;///< Field to specify the polygonal faces by indexing into the <Color> or <ColorRGBA>.
+	std::vector<int32_t> ColorIndex;///< Field to specify the polygonal faces by indexing into the <Color> or <ColorRGBA>.
 	bool ColorPerVertex;///< If true then colors are defined for every vertex, else for every face(line).
 	/// \var Convex
 	/// The convex field indicates whether all polygons in the shape are convex (TRUE). A polygon is convex if it is planar, does not intersect itself,
 	/// and all of the interior angles at its vertices are less than 180 degrees. Non planar and self intersecting polygons may produce undefined results
 	/// even if the convex field is FALSE.
 	bool Convex;
-	std::list<int32_t> CoordIndex;///< Field to specify the polygonal faces by indexing into the <Coordinate>.
+	std::vector<int32_t> CoordIndex;///< Field to specify the polygonal faces by indexing into the <Coordinate>.
 	/// \var CreaseAngle
 	/// If the angle between the geometric normals of two adjacent faces is less than the crease angle, normals shall be calculated so that the faces are
 	/// shaded smoothly across the edge; otherwise, normals shall be calculated so that a lighting discontinuity across the edge is produced.
 	float CreaseAngle;
-	std::list<int32_t> NormalIndex;///< Field to specify the polygonal faces by indexing into the <Normal>.
+	std::vector<int32_t> NormalIndex;///< Field to specify the polygonal faces by indexing into the <Normal>.
 	bool NormalPerVertex;///< If true then normals are defined for every vertex, else for every face(line).
-	std::list<int32_t> TexCoordIndex;///< Field to specify the polygonal faces by indexing into the <TextureCoordinate>.
+	std::vector<int32_t> TexCoordIndex;///< Field to specify the polygonal faces by indexing into the <TextureCoordinate>.
 
 	/***********************************************/
 	/****************** Functions ******************/
@@ -628,10 +629,10 @@ public:
 	bool CCW;
 	bool ColorPerVertex;///< If true then colors are defined for every vertex, else for every face(line).
 	bool NormalPerVertex;///< If true then normals are defined for every vertex, else for every face(line).
-	std::list<int32_t> CoordIndex;///< Field to specify the polygonal faces by indexing into the <Coordinate>.
-	std::list<int32_t> NormalIndex;///< Field to specify the polygonal faces by indexing into the <Normal>.
-	std::list<int32_t> TexCoordIndex;///< Field to specify the polygonal faces by indexing into the <TextureCoordinate>.
-	std::list<int32_t> VertexCount;///< Field describes how many vertices are to be used in each polyline(polygon) from the <Coordinate> field.
+	std::vector<int32_t> CoordIndex;///< Field to specify the polygonal faces by indexing into the <Coordinate>.
+	std::vector<int32_t> NormalIndex;///< Field to specify the polygonal faces by indexing into the <Normal>.
+	std::vector<int32_t> TexCoordIndex;///< Field to specify the polygonal faces by indexing into the <TextureCoordinate>.
+	std::vector<int32_t> VertexCount;///< Field describes how many vertices are to be used in each polyline(polygon) from the <Coordinate> field.
 
 	/***********************************************/
 	/****************** Functions ******************/
@@ -110,12 +110,12 @@ void X3DImporter::ParseNode_Texturing_ImageTexture()
 void X3DImporter::ParseNode_Texturing_TextureCoordinate()
 {
     std::string use, def;
-    std::list<aiVector2D> point;
+    std::vector<aiVector2D> point;
     CX3DImporter_NodeElement* ne( nullptr );
 
 	MACRO_ATTRREAD_LOOPBEG;
 		MACRO_ATTRREAD_CHECKUSEDEF_RET(def, use);
-		MACRO_ATTRREAD_CHECK_REF("point", point, XML_ReadNode_GetAttrVal_AsListVec2f);
+		MACRO_ATTRREAD_CHECK_REF("point", point, XML_ReadNode_GetAttrVal_AsArrVec2f);
 	MACRO_ATTRREAD_LOOPEND;
 
 	// if "USE" defined then find already defined element.
@@ -129,7 +129,7 @@ void X3DImporter::ParseNode_Texturing_TextureCoordinate()
 		ne = new CX3DImporter_NodeElement_TextureCoordinate(NodeElement_Cur);
 		if(!def.empty()) ne->ID = def;
 
-		((CX3DImporter_NodeElement_TextureCoordinate*)ne)->Value = point;
+		((CX3DImporter_NodeElement_TextureCoordinate*)ne)->Value.swap(point);
 		// check for X3DMetadataObject childs.
 		if(!mReader->isEmptyElement())
 			ParseNode_Metadata(ne, "TextureCoordinate");
@@ -1,9 +1,13 @@
 #ifndef INCLUDED_ASSBIN_CHUNKS_H
 #define INCLUDED_ASSBIN_CHUNKS_H
 
-#define ASSBIN_VERSION_MAJOR 1
+#define ASSBIN_VERSION_MAJOR 2
 #define ASSBIN_VERSION_MINOR 0
 
+// major version of files which store the meshes inline in the scene chunk,
+// as the dumps written by assimp_cmd still do
+#define ASSBIN_VERSION_MAJOR_INLINE 1
+
 /**
 @page assfile .ASS File formats
 
@@ -83,8 +87,7 @@ short       0 for normal files, 1 for shortened dumps for regression tests
 
 short       1 if the data after the header is compressed with the DEFLATE algorithm,
             0 for uncompressed files.
-                   For compressed files, the first integer after the header is
-                   always the uncompressed data size
+                   see 5. for the layout of compressed files
 
 byte[256]   Zero-terminated source file name, UTF-8
 byte[128]   Zero-terminated command line parameters passed to assimp_cmd, UTF-8
@@ -164,12 +167,93 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 
    - mNumAllocated is omitted, for obvious reasons :-)
 
+-------------------------------------------------------------------------------
+4. Mesh blocks (major version 2):
+-------------------------------------------------------------------------------
+
+Files with major version 2 store each mesh in a block of its own instead of
+an ASSBIN_CHUNK_AIMESH subchunk of the scene chunk, so readers can load meshes
+on demand and use their arrays in place from a memory mapped file. The data
+following the header (the uncompressed data for compressed files) is laid out
+as follows. All offsets are relative to the start of this data, 'aligned'
+means padded with zeros up to the next offset divisible by ASSBIN_ALIGNMENT.
+
+----------------------
+| Mesh blocks        |  each one aligned and padded
+----------------------
+| Scene chunk        |
+----------------------
+| uint64 offset of the scene chunk
+----------------------
+
+The scene chunk holds an ASSBIN_CHUNK_AIMESHTABLE subchunk in place of the
+ASSBIN_CHUNK_AIMESH subchunks:
+
+integer     Number of meshes
+[number of meshes times]
+    uint64      Offset of the mesh block
+    integer     aiMesh::mPrimitiveTypes
+    integer     aiMesh::mNumVertices
+    integer     aiMesh::mNumFaces
+    integer     aiMesh::mNumBones
+    integer     aiMesh::mMaterialIndex
+
+A mesh block is an ASSBIN_CHUNK_AIMESHBLOCK chunk:
+
+integer     Vertex components present, ASSBIN_MESH_HAS_xxx
+integer     Total number of face indices
+integer[n]  mNumUVComponents of the n uv channels present
+[each array aligned, in this order if present]
+    float[3][mNumVertices]  mVertices, mNormals, mTangents, mBitangents
+    float[4][mNumVertices]  mColors[n]
+    float[3][mNumVertices]  mTextureCoords[n]
+    short[mNumFaces]        aiFace::mNumIndices
+    integer[]               aiFace::mIndices of all faces
+[aiMesh::mNumBones times]
+    string      aiBone::mName
+    integer     aiBone::mNumWeights
+    float[16]   aiBone::mOffsetMatrix
+    [aligned]
+    (integer, float)[mNumWeights] aiBone::mWeights
+
+-------------------------------------------------------------------------------
+5. Compression (major version 2):
+-------------------------------------------------------------------------------
+
+Compressed files with major version 2 cut the data described in 4. into
+frames, which are deflated independently of each other so they can be
+compressed and inflated on several threads. Frames never exceed
+ASSBIN_FRAME_SIZE bytes, and each mesh block, animation chunk and texture
+chunk starts a new frame. The data following the header is laid out as
+follows, offsets are relative to its start:
+
+----------------------
+| Deflated frames    |  zlib streams, back to back
+----------------------
+| Frame table        |
+----------------------
+| uint64 offset of the frame table
+----------------------
+
+integer     Number of frames
+[number of frames times]
+    integer     Size of the frame
+    integer     Size of the deflated frame
+
+Files with major version 1 have the uncompressed data size in front of a
+single zlib stream instead.
 
  @endverbatim*/
 
 
 #define ASSBIN_HEADER_LENGTH 512
 
+// alignment of mesh blocks and their arrays in major version 2 files
+#define ASSBIN_ALIGNMENT 16
+
+// maximum size of the frames of compressed major version 2 files
+#define ASSBIN_FRAME_SIZE 0x100000
+
 // these are the magic chunk identifiers for the binary ASS file format
 #define ASSBIN_CHUNK_AICAMERA                   0x1234
 #define ASSBIN_CHUNK_AILIGHT                    0x1235
@@ -182,6 +266,8 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_CHUNK_AINODE                     0x123c
 #define ASSBIN_CHUNK_AIMATERIAL                 0x123d
 #define ASSBIN_CHUNK_AIMATERIALPROPERTY         0x123e
+#define ASSBIN_CHUNK_AIMESHTABLE                0x123f
+#define ASSBIN_CHUNK_AIMESHBLOCK                0x1240
 
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
@@ -15,10 +15,14 @@
 #ifndef __FAST_A_TO_F_H_INCLUDED__
 #define __FAST_A_TO_F_H_INCLUDED__
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <stdint.h>
 #include <stdexcept>
+#include <string>
 #include <assimp/defs.h>
 
 #include "StringComparison.h"
@@ -248,18 +252,93 @@ inline int64_t strtol10_64(const char* in, const char** out = 0, unsigned int* m
 
 
 // Number of relevant decimals for floating-point parsing.
+// Kept for compatibility, fast_atoreal_move no longer drops decimals.
 #define AI_FAST_ATOF_RELAVANT_DECIMALS 15
 
+// Powers of ten which are exactly representable as double.
+const double fast_atof_pow10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// ------------------------------------------------------------------------------------
+// Helpers for fast_atoreal_move. The slow path hands the digits to the C library,
+// which is required to round correctly. The string never contains a decimal point,
+// so the result does not depend on the current locale.
+// ------------------------------------------------------------------------------------
+inline void fast_atof_strtoreal(const char* in, double& out) {
+    out = ::strtod(in, NULL);
+}
+
+inline void fast_atof_strtoreal(const char* in, float& out) {
+    out = ::strtof(in, NULL);
+}
+
+// Narrows an exactly rounded double to the target type. Fails if double rounding
+// could give a different result than rounding the decimal value directly.
+inline bool fast_atof_narrow(double d, double& out) {
+    out = d;
+    return true;
+}
+
+inline bool fast_atof_narrow(double d, float& out) {
+    const double a = std::fabs(d);
+    if (a < std::numeric_limits<float>::min() || a > std::numeric_limits<float>::max()) {
+        return false;
+    }
+    uint64_t bits;
+    ::memcpy(&bits, &d, sizeof(bits));
+    // a tie between two floats, the direction depends on the dropped digits
+    if ((bits & 0x1fffffff) == 0x10000000) {
+        return false;
+    }
+    out = static_cast<float>(d);
+    return true;
+}
+
+// Computes mantissa * 10^exp10 with a single rounding if both factors are exact
+// in double precision. Fails if that's not the case.
+inline bool fast_atof_exact(uint64_t mantissa, int exp10, double& out) {
+    if (mantissa > (static_cast<uint64_t>(1) << 53) || exp10 < -22 || exp10 > 22) {
+        return false;
+    }
+    out = static_cast<double>(mantissa);
+    if (exp10 < 0) {
+        out /= fast_atof_pow10[-exp10];
+    } else {
+        out *= fast_atof_pow10[exp10];
+    }
+    return true;
+}
+
+inline bool fast_atof_exact(uint64_t mantissa, int exp10, float& out) {
+    // 10^10 is the largest power of ten a float holds exactly
+    if (mantissa <= (1u << 24) && exp10 >= -10 && exp10 <= 10) {
+        out = static_cast<float>(mantissa);
+        if (exp10 < 0) {
+            out /= static_cast<float>(fast_atof_pow10[-exp10]);
+        } else {
+            out *= static_cast<float>(fast_atof_pow10[exp10]);
+        }
+        return true;
+    }
+    double d;
+    return fast_atof_exact(mantissa, exp10, d) && fast_atof_narrow(d, out);
+}
+
 // ------------------------------------------------------------------------------------
 //! Provides a fast function for converting a string into a float,
 //! about 6 times faster than atof in win32.
 // If you find any bugs, please send them to me, niko (at) irrlicht3d.org.
+//
+// The result is correctly rounded. Up to 19 significant digits are collected
+// into an integer. If it and the power of ten are exact in floating point the
+// value is computed with a single multiplication or division, everything else
+// falls back to strtod/strtof.
 // ------------------------------------------------------------------------------------
 template <typename Real>
 inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma = true)
 {
-    Real f = 0;
-
     bool inv = (*c == '-');
     if (inv || *c == '+') {
         ++c;
@@ -294,36 +373,56 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
                                     "or decimal point followed by digit.");
     }
 
-    if (*c != '.' && (! check_comma || c[0] != ','))
-    {
-        f = static_cast<Real>( strtoul10_64 ( c, &c) );
+    // mantissa holds the first 19 significant digits, exp10 the power of ten to
+    // scale it with. Leading zeros don't count, they would only waste digits.
+    uint64_t mantissa = 0;
+    unsigned int numDigits = 0;
+    int exp10 = 0;
+
+    const char* intBegin = c;
+    while (*c == '0') {
+        ++c;
+    }
+    while (*c >= '0' && *c <= '9') {
+        if (numDigits < 19) {
+            mantissa = mantissa * 10 + static_cast<unsigned int>(*c - '0');
+        } else {
+            ++exp10;
+        }
+        ++numDigits;
+        ++c;
     }
+    const char* intEnd = c;
 
+    const char* fracBegin = c;
     if ((*c == '.' || (check_comma && c[0] == ',')) && c[1] >= '0' && c[1] <= '9')
     {
-        ++c;
-
-        // NOTE: The original implementation is highly inaccurate here. The precision of a single
-        // IEEE 754 float is not high enough, everything behind the 6th digit tends to be more
-        // inaccurate than it would need to be. Casting to double seems to solve the problem.
-        // strtol_64 is used to prevent integer overflow.
-
-        // Another fix: this tends to become 0 for long numbers if we don't limit the maximum
-        // number of digits to be read. AI_FAST_ATOF_RELAVANT_DECIMALS can be a value between
-        // 1 and 15.
-        unsigned int diff = AI_FAST_ATOF_RELAVANT_DECIMALS;
-        double pl = static_cast<double>( strtoul10_64 ( c, &c, &diff ));
-
-        pl *= fast_atof_table[diff];
-        f += static_cast<Real>( pl );
+        fracBegin = ++c;
+        if (!numDigits) {
+            while (*c == '0') {
+                --exp10;
+                ++c;
+            }
+        }
+        while (*c >= '0' && *c <= '9') {
+            if (numDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<unsigned int>(*c - '0');
+                --exp10;
+            }
+            ++numDigits;
+            ++c;
+        }
     }
+    const char* fracEnd = c;
+
     // For backwards compatibility: eat trailing dots, but not trailing commas.
-    else if (*c == '.') {
+    if (fracBegin == fracEnd && *c == '.') {
         ++c;
     }
 
     // A major 'E' must be allowed. Necessary for proper reading of some DXF files.
     // Thanks to Zhao Lei to point out that this if() must be outside the if (*c == '.' ..)
+    int exponent = 0;
     if (*c == 'e' || *c == 'E') {
 
         ++c;
@@ -332,14 +431,48 @@ inline const char* fast_atoreal_move(const char* c, Real& out, bool check_comma
             ++c;
         }
 
-        // The reason float constants are used here is that we've seen cases where compilers
-        // would perform such casts on compile-time constants at runtime, which would be
-        // bad considering how frequently fast_atoreal_move<float> is called in Assimp.
-        Real exp = static_cast<Real>( strtoul10_64(c, &c) );
+        // anything beyond this is zero or infinity anyway
+        const uint64_t e = strtoul10_64(c, &c);
+        exponent = e > 100000 ? 100000 : static_cast<int>(e);
         if (einv) {
-            exp = -exp;
+            exponent = -exponent;
+        }
+    }
+    exp10 += exponent;
+
+    Real f = 0;
+    if (0 != mantissa && (numDigits > 19 || !fast_atof_exact(mantissa, exp10, f))) {
+        // write all digits without the decimal point and adjust the exponent
+        char buffer[64];
+        std::string large;
+        const size_t length = (intEnd - intBegin) + (fracEnd - fracBegin) + 16;
+        char* s = buffer;
+        if (length > sizeof(buffer)) {
+            large.resize(length);
+            s = &large[0];
+        }
+
+        char* w = s;
+        for (const char* r = intBegin; r != intEnd; ++r) {
+            *w++ = *r;
+        }
+        for (const char* r = fracBegin; r != fracEnd; ++r) {
+            *w++ = *r;
+        }
+        int e = exponent - static_cast<int>(fracEnd - fracBegin);
+        *w++ = 'e';
+        if (e < 0) {
+            *w++ = '-';
+            e = -e;
         }
-        f *= std::pow(static_cast<Real>(10.0), exp);
+        char* const expBegin = w;
+        do {
+            *w++ = static_cast<char>('0' + e % 10);
+            e /= 10;
+        } while (e);
+        *w = '\0';
+        std::reverse(expBegin, w);
+        fast_atof_strtoreal(s, f);
     }
 
     if (inv) {
@@ -210,6 +210,7 @@ namespace glTF
         ComponentType_UNSIGNED_BYTE = 5121,
         ComponentType_SHORT = 5122,
         ComponentType_UNSIGNED_SHORT = 5123,
+        ComponentType_UNSIGNED_INT = 5125, //!< only for indices, with OES_element_index_uint
         ComponentType_FLOAT = 5126
     };
 
@@ -220,6 +221,7 @@ namespace glTF
             case ComponentType_UNSIGNED_SHORT:
                 return 2;
 
+            case ComponentType_UNSIGNED_INT:
             case ComponentType_FLOAT:
                 return 4;
 
@@ -413,9 +415,16 @@ namespace glTF
 
         inline uint8_t* GetPointer();
 
+        //! Checks that all elements lie within the buffer, throws otherwise
+        inline void CheckRange(size_t elemSize, size_t stride);
+
         template<class T>
         bool ExtractData(T*& outData);
 
+        //! Decodes all values of a scalar integer accessor at once
+        //! \param outData Receives the values, must have room for \ref count of them
+        bool ExtractIndices(unsigned int* outData);
+
         void WriteData(size_t count, const void* src_buffer, size_t src_stride);
 
         //! Helper class to iterate the data
@@ -544,6 +553,11 @@ namespace glTF
 
         bool LoadFromStream(IOStream& stream, size_t length = 0, size_t baseOffset = 0);
 
+        /// \fn bool LoadFromMappedStream(shared_ptr<IOStream> stream, size_t length, size_t baseOffset)
+        /// Reference the data of a memory mapped stream instead of copying it. The buffer keeps the stream open.
+        /// \return false if the stream is not memory mapped or too short, the buffer is unchanged then.
+        bool LoadFromMappedStream(shared_ptr<IOStream> stream, size_t length, size_t baseOffset);
+
 		/// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
 		/// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
 		/// \param [in] pOffset - offset from begin of "bufferView" to encoded region, in bytes.
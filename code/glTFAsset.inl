@@ -339,6 +339,19 @@ inline bool Buffer::LoadFromStream(IOStream& stream, size_t length, size_t baseO
     return true;
 }
 
+inline bool Buffer::LoadFromMappedStream(shared_ptr<IOStream> stream, size_t length, size_t baseOffset)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(stream->GetMappedData());
+    if (!data || baseOffset + length > stream->FileSize()) {
+        return false;
+    }
+
+    // the data is never written to, share ownership of the stream
+    byteLength = length;
+    mData = shared_ptr<uint8_t>(stream, const_cast<uint8_t*>(data) + baseOffset);
+    return true;
+}
+
 inline void Buffer::EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
 {
 	// Check pointer to data
@@ -500,7 +513,51 @@ inline uint8_t* Accessor::GetPointer()
 	return basePtr + offset;
 }
 
+inline void Accessor::CheckRange(size_t elemSize, size_t stride)
+{
+    // decoded regions are sized by their decoder
+    Buffer& buffer = *bufferView->buffer;
+    if (!count || buffer.EncodedRegion_Current) {
+        return;
+    }
+
+    const size_t offset = byteOffset + bufferView->byteOffset;
+    if (offset + (count - 1) * stride + elemSize > buffer.byteLength) {
+        throw DeadlyImportError("GLTF: accessor \"" + id + "\" exceeds the size of its buffer");
+    }
+}
+
 namespace {
+    //! Copies elements of a fixed size, so the compiler can turn each copy into a few moves
+    template<size_t N>
+    inline void CopyElements(size_t count,
+            const uint8_t* src, size_t src_stride,
+                  uint8_t* dst, size_t dst_stride)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(dst + i * dst_stride, src + i * src_stride, N);
+        }
+    }
+
+    //! Widens integer values to unsigned int, tightly packed values take the fast path
+    template<class T>
+    inline void WidenValues(size_t count, const uint8_t* src, size_t src_stride, unsigned int* dst)
+    {
+        T value;
+        if (src_stride == sizeof(T)) {
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(&value, src + i * sizeof(T), sizeof(T));
+                dst[i] = value;
+            }
+        }
+        else {
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(&value, src + i * src_stride, sizeof(T));
+                dst[i] = value;
+            }
+        }
+    }
+
     inline void CopyData(size_t count,
             const uint8_t* src, size_t src_stride,
                   uint8_t* dst, size_t dst_stride)
@@ -534,23 +591,66 @@ bool Accessor::ExtractData(T*& outData)
     const size_t stride = byteStride ? byteStride : elemSize;
 
     const size_t targetElemSize = sizeof(T);
-    ai_assert(elemSize <= targetElemSize);
-
-    ai_assert(count*stride <= bufferView->byteLength);
+    if (elemSize > targetElemSize) {
+        throw DeadlyImportError("GLTF: accessor \"" + id + "\" has elements of unexpected size");
+    }
+    CheckRange(elemSize, stride);
 
     outData = new T[count];
     if (stride == elemSize && targetElemSize == elemSize) {
         memcpy(outData, data, totalSize);
     }
     else {
-        for (size_t i = 0; i < count; ++i) {
-            memcpy(outData + i, data + i*stride, elemSize);
+        // interleaved or narrower data, copy the common sizes in bulk
+        uint8_t* dst = reinterpret_cast<uint8_t*>(outData);
+        switch (elemSize) {
+            case 4:
+                CopyElements<4>(count, data, stride, dst, targetElemSize);
+                break;
+            case 8:
+                CopyElements<8>(count, data, stride, dst, targetElemSize);
+                break;
+            case 12:
+                CopyElements<12>(count, data, stride, dst, targetElemSize);
+                break;
+            case 16:
+                CopyElements<16>(count, data, stride, dst, targetElemSize);
+                break;
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    memcpy(outData + i, data + i*stride, elemSize);
+                }
         }
     }
 
     return true;
 }
 
+inline bool Accessor::ExtractIndices(unsigned int* outData)
+{
+    uint8_t* data = GetPointer();
+    if (!data) return false;
+
+    const size_t elemSize = GetElementSize();
+    const size_t stride = byteStride ? byteStride : elemSize;
+    CheckRange(elemSize, stride);
+
+    switch (elemSize) {
+        case 1:
+            WidenValues<uint8_t>(count, data, stride, outData);
+            break;
+        case 2:
+            WidenValues<uint16_t>(count, data, stride, outData);
+            break;
+        case 4:
+            WidenValues<uint32_t>(count, data, stride, outData);
+            break;
+        default:
+            throw DeadlyImportError("GLTF: accessor \"" + id + "\" does not hold indices");
+    }
+    return true;
+}
+
 inline void Accessor::WriteData(size_t count, const void* src_buffer, size_t src_stride)
 {
     uint8_t* buffer_ptr = bufferView->buffer->GetPointer();
@@ -1341,8 +1441,9 @@ inline void Asset::Load(const std::string& pFile, bool isBinary)
         throw DeadlyImportError("GLTF: JSON document root must be a JSON object");
     }
 
-    // Fill the buffer instance for the current file embedded contents
-    if (mBodyLength > 0) {
+    // Fill the buffer instance for the current file embedded contents,
+    // memory mapped files are referenced in place
+    if (mBodyLength > 0 && !mBodyBuffer->LoadFromMappedStream(stream, mBodyLength, mBodyOffset)) {
         if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
             throw DeadlyImportError("GLTF: Unable to read gltf file");
         }
@@ -1512,43 +1613,58 @@ namespace Util {
         return true;
     }
 
-    template<bool B>
-    struct DATA
+    //! Decoding tables, one per position of a character in its group of four.
+    //! Each entry holds the six bits at their final place within the three
+    //! output bytes, so a group decodes with four lookups and no branches.
+    //! Characters outside the alphabet set the \ref Invalid bit instead.
+    struct Base64Tables
     {
-        static const uint8_t tableDecodeBase64[128];
-    };
+        static const uint32_t Invalid = 0x1000000;
+
+        uint32_t decode[4][256];
+
+        //! Two output characters for every twelve bits of input
+        char encode[4096][2];
+
+        Base64Tables()
+        {
+            for (unsigned int c = 0; c < 256; ++c) {
+                for (unsigned int k = 0; k < 4; ++k) {
+                    decode[k][c] = Invalid;
+                }
+            }
+
+            const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (uint32_t v = 0; v < 64; ++v) {
+                const uint8_t c = uint8_t(alphabet[v]);
+                for (unsigned int k = 0; k < 4; ++k) {
+                    decode[k][c] = v << (18 - 6 * k);
+                }
+            }
 
-    template<bool B>
-    const uint8_t DATA<B>::tableDecodeBase64[128] = {
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 62,  0,  0,  0, 63,
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61,  0,  0,  0, 64,  0,  0,
-         0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,  0,  0,  0,  0,  0,
-         0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,  0,  0,  0,  0,  0
+            for (unsigned int v = 0; v < 4096; ++v) {
+                encode[v][0] = alphabet[v >> 6];
+                encode[v][1] = alphabet[v & 0x3F];
+            }
+        }
     };
 
-    inline char EncodeCharBase64(uint8_t b)
+    inline const Base64Tables& GetBase64Tables()
     {
-        return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/="[size_t(b)];
+        static const Base64Tables tables;
+        return tables;
     }
 
-    inline uint8_t DecodeCharBase64(char c)
+    inline char EncodeCharBase64(uint8_t b)
     {
-        return DATA<true>::tableDecodeBase64[size_t(c)]; // TODO faster with lookup table or ifs?
-        /*if (c >= 'A' && c <= 'Z') return c - 'A';
-        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-        if (c >= '0' && c <= '9') return c - '0' + 52;
-        if (c == '+') return 62;
-        if (c == '/') return 63;
-        return 64; // '-' */
+        return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/="[size_t(b)];
     }
 
     inline size_t DecodeBase64(const char* in, size_t inLength, uint8_t*& out)
     {
-        ai_assert(inLength % 4 == 0);
+        if (inLength % 4 != 0) {
+            throw DeadlyImportError("GLTF: base64 data has an invalid length");
+        }
 
         if (inLength < 4) {
             out = 0;
@@ -1560,30 +1676,44 @@ namespace Util {
 
         size_t outLength = (inLength * 3) / 4 - nEquals;
         out = new uint8_t[outLength];
-        memset(out, 0, outLength);
-
-        size_t i, j = 0;
 
-        for (i = 0; i + 4 < inLength; i += 4) {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            out[j++] = (uint8_t)((b2 << 6) | b3);
+        const Base64Tables& tables = GetBase64Tables();
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(in);
+
+        // all groups but the last one are complete, invalid characters are
+        // collected over the whole loop and only checked once at the end
+        const size_t nGroups = inLength / 4 - 1;
+        uint32_t invalid = 0;
+        for (size_t g = 0; g < nGroups; ++g) {
+            const uint8_t* c = src + g * 4;
+            const uint32_t v = tables.decode[0][c[0]] | tables.decode[1][c[1]] |
+                               tables.decode[2][c[2]] | tables.decode[3][c[3]];
+            invalid |= v;
+
+            uint8_t* o = out + g * 3;
+            o[0] = uint8_t(v >> 16);
+            o[1] = uint8_t(v >> 8);
+            o[2] = uint8_t(v);
         }
 
         {
-            uint8_t b0 = DecodeCharBase64(in[i]);
-            uint8_t b1 = DecodeCharBase64(in[i + 1]);
-            uint8_t b2 = DecodeCharBase64(in[i + 2]);
-            uint8_t b3 = DecodeCharBase64(in[i + 3]);
-
-            out[j++] = (uint8_t)((b0 << 2) | (b1 >> 4));
-            if (b2 < 64) out[j++] = (uint8_t)((b1 << 4) | (b2 >> 2));
-            if (b3 < 64) out[j++] = (uint8_t)((b2 << 6) | b3);
+            // the last group may be padded
+            const uint8_t* c = src + nGroups * 4;
+            const uint32_t v = tables.decode[0][c[0]] | tables.decode[1][c[1]] |
+                               (nEquals > 1 ? 0 : tables.decode[2][c[2]]) |
+                               (nEquals > 0 ? 0 : tables.decode[3][c[3]]);
+            invalid |= v;
+
+            uint8_t* o = out + nGroups * 3;
+            o[0] = uint8_t(v >> 16);
+            if (nEquals < 2) o[1] = uint8_t(v >> 8);
+            if (nEquals < 1) o[2] = uint8_t(v);
+        }
+
+        if (invalid & Base64Tables::Invalid) {
+            delete[] out;
+            out = 0;
+            throw DeadlyImportError("GLTF: invalid character in base64 data");
         }
 
         return outLength;
@@ -1599,34 +1729,39 @@ namespace Util {
 
         size_t j = out.size();
         out.resize(j + outLength);
+        if (!outLength) {
+            return;
+        }
 
-        for (size_t i = 0; i <  inLength; i += 3) {
-            uint8_t b = (in[i] & 0xFC) >> 2;
-            out[j++] = EncodeCharBase64(b);
+        const Base64Tables& tables = GetBase64Tables();
+        char* dst = &out[j];
 
-            b = (in[i] & 0x03) << 4;
-            if (i + 1 < inLength) {
-                b |= (in[i + 1] & 0xF0) >> 4;
-                out[j++] = EncodeCharBase64(b);
+        // complete groups of three bytes first, without any branches
+        const size_t nGroups = inLength / 3;
+        for (size_t g = 0; g < nGroups; ++g) {
+            const uint8_t* i = in + g * 3;
+            const uint32_t v = (uint32_t(i[0]) << 16) | (uint32_t(i[1]) << 8) | i[2];
 
-                b = (in[i + 1] & 0x0F) << 2;
-                if (i + 2 < inLength) {
-                    b |= (in[i + 2] & 0xC0) >> 6;
-                    out[j++] = EncodeCharBase64(b);
+            char* o = dst + g * 4;
+            memcpy(o, tables.encode[v >> 12], 2);
+            memcpy(o + 2, tables.encode[v & 0xFFF], 2);
+        }
 
-                    b = in[i + 2] & 0x3F;
-                    out[j++] = EncodeCharBase64(b);
-                }
-                else {
-                    out[j++] = EncodeCharBase64(b);
-                    out[j++] = '=';
-                }
+        const size_t rest = inLength - nGroups * 3;
+        if (rest) {
+            const uint8_t* i = in + nGroups * 3;
+            char* o = dst + nGroups * 4;
+
+            o[0] = EncodeCharBase64((i[0] & 0xFC) >> 2);
+            if (rest == 2) {
+                o[1] = EncodeCharBase64(uint8_t(((i[0] & 0x03) << 4) | ((i[1] & 0xF0) >> 4)));
+                o[2] = EncodeCharBase64(uint8_t((i[1] & 0x0F) << 2));
             }
             else {
-                out[j++] = EncodeCharBase64(b);
-                out[j++] = '=';
-                out[j++] = '=';
+                o[1] = EncodeCharBase64(uint8_t((i[0] & 0x03) << 4));
+                o[2] = '=';
             }
+            o[3] = '=';
         }
     }
 
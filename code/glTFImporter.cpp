@@ -82,7 +82,8 @@ glTFImporter::glTFImporter()
 : BaseImporter()
 , meshOffsets()
 , embeddedTexIdxs()
-, mScene( NULL ) {
+, mScene( NULL )
+, mPoolFaceIndices( false ) {
     // empty
 }
 
@@ -95,6 +96,11 @@ const aiImporterDesc* glTFImporter::GetInfo() const
     return &desc;
 }
 
+void glTFImporter::SetupProperties(const Importer* pImp)
+{
+    mPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_POOL_FACE_INDICES, false);
+}
+
 bool glTFImporter::CanRead(const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const
 {
     const std::string& extension = GetExtension(pFile);
@@ -214,17 +220,36 @@ void glTFImporter::ImportMaterials(glTF::Asset& r)
 }
 
 
+// Allocates the faces of a mesh, optionally with their indices in one pool
+// owned by the mesh. SetFace() only allocates indices for faces without any.
+static inline aiFace* AllocateFaces(aiMesh* mesh, unsigned int nFaces, unsigned int nIndices, bool pooled)
+{
+    aiFace* faces = new aiFace[nFaces];
+    if (pooled && nFaces) {
+        mesh->mNumFaceIndices = nFaces * nIndices;
+        mesh->mFaceIndices = new unsigned int[mesh->mNumFaceIndices];
+        for (unsigned int i = 0; i < nFaces; ++i) {
+            faces[i].mIndices = mesh->mFaceIndices + i * nIndices;
+        }
+    }
+    return faces;
+}
+
 static inline void SetFace(aiFace& face, int a)
 {
     face.mNumIndices = 1;
-    face.mIndices = new unsigned int[1];
+    if (!face.mIndices) {
+        face.mIndices = new unsigned int[1];
+    }
     face.mIndices[0] = a;
 }
 
 static inline void SetFace(aiFace& face, int a, int b)
 {
     face.mNumIndices = 2;
-    face.mIndices = new unsigned int[2];
+    if (!face.mIndices) {
+        face.mIndices = new unsigned int[2];
+    }
     face.mIndices[0] = a;
     face.mIndices[1] = b;
 }
@@ -232,7 +257,9 @@ static inline void SetFace(aiFace& face, int a, int b)
 static inline void SetFace(aiFace& face, int a, int b, int c)
 {
     face.mNumIndices = 3;
-    face.mIndices = new unsigned int[3];
+    if (!face.mIndices) {
+        face.mIndices = new unsigned int[3];
+    }
     face.mIndices[0] = a;
     face.mIndices[1] = b;
     face.mIndices[2] = c;
@@ -351,24 +378,27 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
 
                 unsigned int count = prim.indices->count;
 
-                Accessor::Indexer data = prim.indices->GetIndexer();
-                ai_assert(data.IsValid());
+                // widen all indices in one pass instead of one lookup per index
+                std::vector<unsigned int> data(count);
+                if (count && !prim.indices->ExtractIndices(&data[0])) {
+                    throw DeadlyImportError("GLTF: index data of mesh \"" + mesh.id + "\" is missing");
+                }
 
                 switch (prim.mode) {
                     case PrimitiveMode_POINTS: {
                         nFaces = count;
-                        faces = new aiFace[nFaces];
+                        faces = AllocateFaces(aim, nFaces, 1, mPoolFaceIndices);
                         for (unsigned int i = 0; i < count; ++i) {
-                            SetFace(faces[i], data.GetUInt(i));
+                            SetFace(faces[i], data[i]);
                         }
                         break;
                     }
 
                     case PrimitiveMode_LINES: {
                         nFaces = count / 2;
-                        faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 2) {
-                            SetFace(faces[i / 2], data.GetUInt(i), data.GetUInt(i + 1));
+                        faces = AllocateFaces(aim, nFaces, 2, mPoolFaceIndices);
+                        for (unsigned int i = 0; i + 1 < count; i += 2) {
+                            SetFace(faces[i / 2], data[i], data[i + 1]);
                         }
                         break;
                     }
@@ -376,10 +406,10 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
                     case PrimitiveMode_LINE_LOOP:
                     case PrimitiveMode_LINE_STRIP: {
                         nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
-                        faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1));
+                        faces = AllocateFaces(aim, nFaces, 2, mPoolFaceIndices);
+                        SetFace(faces[0], data[0], data[1]);
                         for (unsigned int i = 2; i < count; ++i) {
-                            SetFace(faces[i - 1], faces[i - 2].mIndices[1], data.GetUInt(i));
+                            SetFace(faces[i - 1], faces[i - 2].mIndices[1], data[i]);
                         }
                         if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
                             SetFace(faces[count - 1], faces[count - 2].mIndices[1], faces[0].mIndices[0]);
@@ -389,27 +419,27 @@ void glTFImporter::ImportMeshes(glTF::Asset& r)
 
                     case PrimitiveMode_TRIANGLES: {
                         nFaces = count / 3;
-                        faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; i += 3) {
-                            SetFace(faces[i / 3], data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
+                        faces = AllocateFaces(aim, nFaces, 3, mPoolFaceIndices);
+                        for (unsigned int i = 0; i + 2 < count; i += 3) {
+                            SetFace(faces[i / 3], data[i], data[i + 1], data[i + 2]);
                         }
                         break;
                     }
                     case PrimitiveMode_TRIANGLE_STRIP: {
                         nFaces = count - 2;
-                        faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
+                        faces = AllocateFaces(aim, nFaces, 3, mPoolFaceIndices);
+                        SetFace(faces[0], data[0], data[1], data[2]);
                         for (unsigned int i = 3; i < count; ++i) {
-                            SetFace(faces[i - 2], faces[i - 1].mIndices[1], faces[i - 1].mIndices[2], data.GetUInt(i));
+                            SetFace(faces[i - 2], faces[i - 1].mIndices[1], faces[i - 1].mIndices[2], data[i]);
                         }
                         break;
                     }
                     case PrimitiveMode_TRIANGLE_FAN:
                         nFaces = count - 2;
-                        faces = new aiFace[nFaces];
-                        SetFace(faces[0], data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
+                        faces = AllocateFaces(aim, nFaces, 3, mPoolFaceIndices);
+                        SetFace(faces[0], data[0], data[1], data[2]);
                         for (unsigned int i = 3; i < count; ++i) {
-                            SetFace(faces[i - 2], faces[0].mIndices[0], faces[i - 1].mIndices[2], data.GetUInt(i));
+                            SetFace(faces[i - 2], faces[0].mIndices[0], faces[i - 1].mIndices[2], data[i]);
                         }
                         break;
                 }
@@ -651,24 +681,26 @@ void glTFImporter::InternReadFile(const std::string& pFile, aiScene* pScene, IOS
 
     this->mScene = pScene;
 
-    // read the asset file
-    glTF::Asset asset(pIOHandler);
-    asset.Load(pFile, GetExtension(pFile) == "glb");
+    {
+        // read the asset file, it goes out of scope before the meshes are made verbose
+        glTF::Asset asset(pIOHandler);
+        asset.Load(pFile, GetExtension(pFile) == "glb");
 
 
-    //
-    // Copy the data out
-    //
+        //
+        // Copy the data out
+        //
 
-    ImportEmbeddedTextures(asset);
-    ImportMaterials(asset);
+        ImportEmbeddedTextures(asset);
+        ImportMaterials(asset);
 
-    ImportMeshes(asset);
+        ImportMeshes(asset);
 
-    ImportCameras(asset);
-    ImportLights(asset);
+        ImportCameras(asset);
+        ImportLights(asset);
 
-    ImportNodes(asset);
+        ImportNodes(asset);
+    }
 
     // TODO: it does not split the loaded vertices, should it?
     //pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
@@ -65,6 +65,7 @@ public:
 
 protected:
     virtual const aiImporterDesc* GetInfo() const;
+    virtual void SetupProperties( const Importer* pImp );
     virtual void InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler );
 
 private:
@@ -75,6 +76,9 @@ private:
 
     aiScene* mScene;
 
+    //! Keep all face indices of a mesh in one pool
+    bool mPoolFaceIndices;
+
     void ImportEmbeddedTextures(glTF::Asset& a);
     void ImportMaterials(glTF::Asset& a);
     void ImportMeshes(glTF::Asset& a);
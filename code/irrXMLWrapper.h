@@ -53,6 +53,13 @@ namespace Assimp    {
 /** @brief Utility class to make IrrXML work together with our custom IO system
  *  See the IrrXML docs for more details.
  *
+ *  This is not a streaming parser and its memory use is not bounded. IrrXML
+ *  reads the whole file into one buffer and parses it in place, the names,
+ *  text and attribute values it returns point into that buffer and stay valid
+ *  as long as the reader. Expect at least the file size in memory for the
+ *  lifetime of the reader, twice that while files which aren't plain ASCII
+ *  are converted to UTF-8, plus whatever the importer builds from it.
+ *
  *  Construct IrrXML-Reader in BaseImporter::InternReadFile():
  *  @code
  * // open the file
@@ -79,28 +86,36 @@ public:
     explicit CIrrXML_IOStreamReader(IOStream* _stream)
         : stream (_stream)
         , t (0)
+        , size (_stream->FileSize())
+        , passThrough (false)
     {
-
-        // Map the buffer into memory and convert it to UTF8. IrrXML provides its
-        // own conversion, which is merely a cast from uintNN_t to uint8_t. Thus,
-        // it is not suitable for our purposes and we have to do it BEFORE IrrXML
-        // gets the buffer. Sadly, this forces us to map the whole file into
-        // memory.
-
-        data.resize(stream->FileSize());
-        stream->Read(&data[0],data.size(),1);
-
-        // Remove null characters from the input sequence otherwise the parsing will utterly fail
-        unsigned int size = 0;
-        unsigned int size_max = static_cast<unsigned int>(data.size());
-        for(unsigned int i = 0; i < size_max; i++) {
-            if(data[i] != '\0') {
-                data[size++] = data[i];
+        // IrrXML provides its own UTF conversion, which is merely a cast from
+        // uintNN_t to uint8_t. Thus, it is not suitable for our purposes and we
+        // have to do it BEFORE IrrXML gets the buffer, which needs the whole
+        // file in memory. Files starting with plain ASCII can't be UTF-16 or
+        // UTF-32 though, they are passed through to IrrXML without a copy of
+        // our own. IrrXML still reads the whole file into its buffer at once.
+        char head[8];
+        if (size >= sizeof(head) && stream->Read(head, 1, sizeof(head)) == sizeof(head)) {
+            passThrough = true;
+            for (size_t i = 0; i < sizeof(head); ++i) {
+                const unsigned char c = static_cast<unsigned char>(head[i]);
+                passThrough = passThrough && c != 0 && c < 0x80;
             }
+            stream->Seek(0, aiOrigin_SET);
         }
+        if (passThrough) {
+            return;
+        }
+
         data.resize(size);
+        stream->Read(&data[0],data.size(),1);
 
+        // Remove null characters from the input sequence otherwise the parsing will utterly fail.
+        // This has to wait for the conversion, UTF-16 and UTF-32 are full of them.
         BaseImporter::ConvertToUTF8(data);
+        size = RemoveNullCharacters(&data[0], data.size());
+        data.resize(size);
     }
 
     // ----------------------------------------------------------------------------------
@@ -116,6 +131,14 @@ public:
         if(sizeToRead<0) {
             return 0;
         }
+        if (passThrough) {
+            const size_t sizeRead = stream->Read(buffer, 1, sizeToRead);
+            return static_cast<int>(RemoveNullCharacters(static_cast<char*>(buffer), sizeRead));
+        }
+
+        if (data.empty()) {
+            return 0;
+        }
         if(t+sizeToRead>data.size()) {
             sizeToRead = static_cast<int>(data.size()-t);
         }
@@ -123,19 +146,38 @@ public:
         memcpy(buffer,&data.front()+t,sizeToRead);
 
         t += sizeToRead;
+        if (t == data.size()) {
+            // IrrXML reads everything at once, no need to hold the data twice
+            std::vector<char>().swap(data);
+            t = 0;
+        }
         return sizeToRead;
     }
 
     // ----------------------------------------------------------------------------------
     //! Returns size of file in bytes
     virtual int getSize()   {
-        return (int)data.size();
+        return (int)size;
     }
 
 private:
+    // ----------------------------------------------------------------------------------
+    //! Removes null characters in place, returns the new length
+    static size_t RemoveNullCharacters(char* buffer, size_t length) {
+        size_t out = 0;
+        for (size_t i = 0; i < length; ++i) {
+            if (buffer[i] != '\0') {
+                buffer[out++] = buffer[i];
+            }
+        }
+        return out;
+    }
+
     IOStream* stream;
     std::vector<char> data;
     size_t t;
+    size_t size;
+    bool passThrough;
 
 }; // ! class CIrrXML_IOStreamReader
 
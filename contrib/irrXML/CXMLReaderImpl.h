@@ -33,8 +33,11 @@ public:
 	//! Constructor
 	CXMLReaderImpl(IFileReadCallBack* callback, bool deleteCallBack = true)
 		: TextData(0), P(0), TextBegin(0), TextSize(0), CurrentNodeType(EXN_NONE),
-		SourceFormat(ETF_ASCII), TargetFormat(ETF_ASCII)
+		SourceFormat(ETF_ASCII), TargetFormat(ETF_ASCII), NodeName(0), IsEmptyElement(false),
+		PendingElement(false)
 	{
+		NodeName = EmptyString.c_str();
+
 		if (!callback)
 			return;
 
@@ -70,7 +73,7 @@ public:
 	virtual bool read()
 	{
 		// if not end reached, parse the node
-		if (P && (unsigned int)(P - TextBegin) < TextSize - 1 && *P != 0)
+		if (P && (unsigned int)(P - TextBegin) < TextSize - 1 && (*P != 0 || PendingElement))
 		{
 			parseCurrentNode();
 			return true;
@@ -101,7 +104,7 @@ public:
 		if (idx < 0 || idx >= (int)Attributes.size())
 			return 0;
 
-		return Attributes[idx].Name.c_str();
+		return Attributes[idx].Name;
 	}
 
 
@@ -111,7 +114,7 @@ public:
 		if (idx < 0 || idx >= (int)Attributes.size())
 			return 0;
 
-		return Attributes[idx].Value.c_str();
+		return Attributes[idx].Value;
 	}
 
 
@@ -122,7 +125,7 @@ public:
 		if (!attr)
 			return 0;
 
-		return attr->Value.c_str();
+		return attr->Value;
 	}
 
 
@@ -133,7 +136,7 @@ public:
 		if (!attr)
 			return EmptyString.c_str();
 
-		return attr->Value.c_str();
+		return attr->Value;
 	}
 
 
@@ -141,14 +144,25 @@ public:
 	//! Returns the value of an attribute as integer. 
 	int getAttributeValueAsInt(const char_type* name) const
 	{
-		return (int)getAttributeValueAsFloat(name);
+		const SAttribute* attr = getAttributeByName(name);
+		if (!attr)
+			return 0;
+
+		// not through float, which can't hold all counts of large files
+		core::stringc c = attr->Value;
+		return strtol10(c.c_str());
 	}
 
 
 	//! Returns the value of an attribute as integer. 
 	int getAttributeValueAsInt(int idx) const
 	{
-		return (int)getAttributeValueAsFloat(idx);
+		const char_type* attrvalue = getAttributeValue(idx);
+		if (!attrvalue)
+			return 0;
+
+		core::stringc c = attrvalue;
+		return strtol10(c.c_str());
 	}
 
 
@@ -159,7 +173,7 @@ public:
 		if (!attr)
 			return 0;
 
-		core::stringc c = attr->Value.c_str();
+		core::stringc c = attr->Value;
 		return fast_atof(c.c_str());
 	}
 
@@ -179,14 +193,14 @@ public:
 	//! Returns the name of the current node.
 	virtual const char_type* getNodeName() const
 	{
-		return NodeName.c_str();
+		return NodeName;
 	}
 
 
 	//! Returns data of the current node.
 	virtual const char_type* getNodeData() const
 	{
-		return NodeName.c_str();
+		return NodeName;
 	}
 
 
@@ -213,20 +227,28 @@ private:
 	// Reads the current xml node
 	void parseCurrentNode()
 	{
-		char_type* start = P;
-
-		// move forward until '<' found
-		while(*P != L'<' && *P)
-			++P;
+		if (PendingElement)
+		{
+			// the text before this element was terminated in place of its '<'
+			PendingElement = false;
+		}
+		else
+		{
+			char_type* start = P;
 
-		if (!*P)
-			return;
+			// move forward until '<' found
+			while(*P != L'<' && *P)
+				++P;
 
-		if (P - start > 0)
-		{
-			// we found some text, store it
-			if (setText(start, P))
+			if (!*P)
 				return;
+
+			if (P - start > 0)
+			{
+				// we found some text, store it
+				if (setText(start, P))
+					return;
+			}
 		}
 
 		++P;
@@ -267,9 +289,11 @@ private:
 				return false;
 		}
 
-		// set current text to the parsed text, and replace xml special characters
-		core::string<char_type> s(start, (int)(end - start));
-		NodeName = replaceSpecialCharacters(s);
+		// replace xml special characters and terminate the text in place, the
+		// element behind it is parsed with the next call
+		replaceSpecialCharacters(start, end);
+		NodeName = start;
+		PendingElement = true;
 
 		// current XML node type is text
 		CurrentNodeType = EXN_TEXT;
@@ -315,7 +339,13 @@ private:
 		}
 
 		P -= 3;
-		NodeName = core::string<char_type>(pCommentBegin+2, (int)(P - pCommentBegin-2));
+		if (P >= pCommentBegin+2)
+		{
+			*P = 0;
+			NodeName = pCommentBegin+2;
+		}
+		else
+			NodeName = EmptyString.c_str();
 		P += 3;
 	}
 
@@ -328,13 +358,13 @@ private:
 		Attributes.clear();
 
 		// find name
-		const char_type* startName = P;
+		char_type* startName = P;
 
 		// find end of element
 		while(*P != L'>' && !isWhiteSpace(*P))
 			++P;
 
-		const char_type* endName = P;
+		char_type* endName = P;
 
 		// find Attributes
 		while(*P != L'>')
@@ -348,12 +378,12 @@ private:
 					// we've got an attribute
 
 					// read the attribute names
-					const char_type* attributeNameBegin = P;
+					char_type* attributeNameBegin = P;
 
 					while(!isWhiteSpace(*P) && *P != L'=')
 						++P;
 
-					const char_type* attributeNameEnd = P;
+					char_type* attributeNameEnd = P;
 					++P;
 
 					// read the attribute value
@@ -367,7 +397,7 @@ private:
 					const char_type attributeQuoteChar = *P;
 
 					++P;
-					const char_type* attributeValueBegin = P;
+					char_type* attributeValueBegin = P;
 					
 					while(*P != attributeQuoteChar && *P)
 						++P;
@@ -375,17 +405,17 @@ private:
 					if (!*P) // malformatted xml file
 						return;
 
-					const char_type* attributeValueEnd = P;
+					char_type* attributeValueEnd = P;
 					++P;
 
-					SAttribute attr;
-					attr.Name = core::string<char_type>(attributeNameBegin, 
-						(int)(attributeNameEnd - attributeNameBegin));
-
-					core::string<char_type> s(attributeValueBegin, 
-						(int)(attributeValueEnd - attributeValueBegin));
+					// both name and value are terminated in place, the parser
+					// never looks back at their ends
+					*attributeNameEnd = 0;
+					replaceSpecialCharacters(attributeValueBegin, attributeValueEnd);
 
-					attr.Value = replaceSpecialCharacters(s);
+					SAttribute attr;
+					attr.Name = attributeNameBegin;
+					attr.Value = attributeValueBegin;
 					Attributes.push_back(attr);
 				}
 				else
@@ -406,7 +436,9 @@ private:
 			endName--;
 		}
 		
-		NodeName = core::string<char_type>(startName, (int)(endName - startName));
+		// the end of the name may be the '>' at P, it's skipped below
+		*endName = 0;
+		NodeName = startName;
 
 		++P;
 	}
@@ -420,7 +452,7 @@ private:
 		Attributes.clear();
 
 		++P;
-		const char_type* pBeginClose = P;
+		char_type* pBeginClose = P;
 
 		while(*P != L'>')
 			++P;
@@ -429,7 +461,8 @@ private:
     while( isspace( P[-1]))
       --P;
 
-		NodeName = core::string<char_type>(pBeginClose, (int)(P - pBeginClose));
+		*P = 0;
+		NodeName = pBeginClose;
 		++P;
 	}
 
@@ -469,19 +502,22 @@ private:
 		}
 
 		if ( cDataEnd )
-			NodeName = core::string<char_type>(cDataBegin, (int)(cDataEnd - cDataBegin));
+		{
+			*cDataEnd = 0;
+			NodeName = cDataBegin;
+		}
 		else
-			NodeName = "";
+			NodeName = EmptyString.c_str();
 
 		return true;
 	}
 
 
-	// structure for storing attribute-name pairs
+	// structure for storing attribute-name pairs, both point into the text data
 	struct SAttribute
 	{
-		core::string<char_type> Name;
-		core::string<char_type> Value;
+		const char_type* Name;
+		const char_type* Value;
 	};
 
 	// finds a current attribute by name, returns 0 if not found
@@ -490,69 +526,61 @@ private:
 		if (!name)
 			return 0;
 
-		core::string<char_type> n = name;
-
 		for (int i=0; i<(int)Attributes.size(); ++i)
-			if (Attributes[i].Name == n)
+		{
+			const char_type* a = Attributes[i].Name;
+			const char_type* b = name;
+			while (*a && *a == *b)
+				++a, ++b;
+			if (*a == *b)
 				return &Attributes[i];
+		}
 
 		return 0;
 	}
 
-	// replaces xml special characters in a string and creates a new one
-	core::string<char_type> replaceSpecialCharacters(
-		core::string<char_type>& origstr)
+	// replaces xml special characters in [start,end) in place and terminates
+	// the string at its new end
+	void replaceSpecialCharacters(char_type* start, char_type* end)
 	{
-		int pos = origstr.findFirst(L'&');
-		int oldPos = 0;
-
-		if (pos == -1)
-			return origstr;
-
-		core::string<char_type> newstr;
+		char_type* in = start;
+		while (in != end && *in != L'&')
+			++in;
 
-		while(pos != -1 && pos < origstr.size()-2)
+		char_type* out = in;
+		while (in != end)
 		{
 			// check if it is one of the special characters
-
 			int specialChar = -1;
-			for (int i=0; i<(int)SpecialCharacters.size(); ++i)
+			if (*in == L'&')
 			{
-				const char_type* p = &origstr.c_str()[pos]+1;
-
-				if (equalsn(&SpecialCharacters[i][1], p, SpecialCharacters[i].size()-1))
+				for (int i=0; i<(int)SpecialCharacters.size(); ++i)
 				{
-					specialChar = i;
-					break;
+					const int len = SpecialCharacters[i].size()-1;
+					if (end - in > len && equalsn(&SpecialCharacters[i][1], in+1, len))
+					{
+						specialChar = i;
+						break;
+					}
 				}
 			}
 
 			if (specialChar != -1)
 			{
-				newstr.append(origstr.subString(oldPos, pos - oldPos));
-				newstr.append(SpecialCharacters[specialChar][0]);
-				pos += SpecialCharacters[specialChar].size();
+				*out++ = SpecialCharacters[specialChar][0];
+				in += SpecialCharacters[specialChar].size();
 			}
 			else
-			{
-				newstr.append(origstr.subString(oldPos, pos - oldPos + 1));
-				pos += 1;
-			}
-
-			// find next &
-			oldPos = pos;
-			pos = origstr.findNext(L'&', pos);		
+				*out++ = *in++;
 		}
 
-		if (oldPos < origstr.size()-1)
-			newstr.append(origstr.subString(oldPos, origstr.size()-oldPos));
-
-		return newstr;
+		*out = 0;
 	}
 
 
 
 	//! reads the xml file and converts it into the wanted character format.
+	//! The whole file is read at once, there is no incremental parsing.
 	bool readFile(IFileReadCallBack* callback)
 	{
 		int size = callback->getSize();		
@@ -561,11 +589,15 @@ private:
 
 		char* data8 = new char[size];
 
-		if (!callback->read(data8, size-4))
+		// the callback may deliver less than announced
+		const int sizeRead = callback->read(data8, size-4);
+		if (sizeRead <= 0)
 		{
 			delete [] data8;
 			return false;
 		}
+		if (sizeRead < size-4)
+			size = sizeRead + 4;
 
 		// add zeros at end
 
@@ -791,10 +823,11 @@ private:
 	ETEXT_FORMAT SourceFormat;   // source format of the xml file
 	ETEXT_FORMAT TargetFormat;   // output format of this parser
 
-	core::string<char_type> NodeName;    // name of the node currently in
+	const char_type* NodeName;           // name of the node currently in, points into the text data
 	core::string<char_type> EmptyString; // empty string to be returned by getSafe() methods
 
 	bool IsEmptyElement;       // is the currently parsed node empty?
+	bool PendingElement;       // was the '<' at P overwritten to terminate the text before it?
 
 	core::array< core::string<char_type> > SpecialCharacters; // see createSpecialCharacterList()
 
@@ -120,6 +120,17 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Get direct read access to the whole contents of the file
+     *
+     *  Streams which hold the file in memory (i.e. memory-mapped files)
+     *  can expose it directly, so importers need not copy it into a
+     *  buffer of their own. The data is read-only, it is not terminated
+     *  by a zero byte and remains valid until the stream is closed.
+     *  @return NULL if the stream does not support direct access,
+     *    this is the default. */
+    virtual const void* GetMappedData() const;
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -133,6 +144,12 @@ inline IOStream::~IOStream()
 {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+inline const void* IOStream::GetMappedData() const
+{
+    return NULL;
+}
 // ----------------------------------------------------------------------------------
 } //!namespace Assimp
 
@@ -61,6 +61,7 @@ namespace Assimp    {
     class IOStream;
     class IOSystem;
     class ProgressHandler;
+    class TaskExecutor;
 
     // =======================================================================
     // Plugin development
@@ -81,6 +82,7 @@ namespace Assimp    {
 #define AI_PROPERTY_WAS_NOT_EXISTING 0xffffffff
 
 struct aiScene;
+struct aiMesh;
 
 // importerdesc.h
 struct aiImporterDesc;
@@ -88,6 +90,43 @@ struct aiImporterDesc;
 /** @namespace Assimp Assimp's CPP-API and all internal APIs */
 namespace Assimp    {
 
+// ----------------------------------------------------------------------------------
+/** Timing information for a single region of an import.
+ *
+ *  Entries are collected by the Importer if #AI_CONFIG_GLOB_MEASURE_TIME
+ *  is enabled, see Importer::GetProfileEntry().
+ */
+struct ImportProfileEntry {
+    /** Phase of the import a region belongs to */
+    enum Phase {
+        /** Whole ReadFile() call */
+        Phase_Total = 0,
+        /** File format loader */
+        Phase_Import,
+        /** Scene preprocessing */
+        Phase_Preprocess,
+        /** A single post processing step */
+        Phase_PostProcess
+    };
+
+    /** Phase of this region */
+    Phase mPhase;
+
+    /** Name of the region. For Phase_PostProcess this is the class
+     *  name of the step, i.e. "JoinVerticesProcess" */
+    aiString mName;
+
+    /** Wall-clock time spent in this region, in seconds */
+    double mSeconds;
+
+    /** Number of meshes in the scene at the end of the region */
+    unsigned int mNumMeshes;
+
+    /** Memory occupied by the scene at the end of the region, in bytes
+     *  (see Importer::GetMemoryRequirements()) */
+    unsigned int mSceneMemory;
+};
+
 // ----------------------------------------------------------------------------------
 /** CPP-API: The Importer class forms an C++ interface to the functionality of the
 *   Open Asset Import Library.
@@ -353,6 +392,23 @@ public:
      */
     bool IsDefaultProgressHandler() const;
 
+    // -------------------------------------------------------------------
+    /** Supplies a custom task executor to the importer. All parallel
+     *  work of importers and post-processing steps is handed to it
+     *  instead of the importer's own worker threads, whose number is
+     *  set by #AI_CONFIG_GLOB_MULTITHREADING.
+     *  @param pExecutor Executor to be used, it is not deleted by the
+     *    importer. Pass NULL to go back to the importer's own threads.
+     *    The executor may be shared by several importers. */
+    void SetTaskExecutor( TaskExecutor* pExecutor );
+
+    // -------------------------------------------------------------------
+    /** Retrieves the task executor that is currently set.
+     * @return The executor supplied via #SetTaskExecutor() or NULL if
+     *   the importer uses its own threads.
+     */
+    TaskExecutor* GetTaskExecutor() const;
+
     // -------------------------------------------------------------------
     /** @brief Check whether a given set of post-processing flags
      *  is supported.
@@ -493,6 +549,19 @@ public:
      * @return Current scene or NULL if there is currently no scene loaded */
     const aiScene* GetScene() const;
 
+    // -------------------------------------------------------------------
+    /** Returns a mesh of the current scene, loading its data first if
+     *  this has been deferred (see #AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES).
+     *
+     * Other meshes are returned as they are. May be called from several
+     * threads at once.
+     * @param pIndex Index of the mesh in aiScene::mMeshes
+     * @return The mesh or NULL if there is no scene, the index is out of
+     *   range or the mesh cannot be loaded. In the latter case, the
+     *   reason is written to the log only, GetErrorString() isn't
+     *   touched since other threads may read it at the same time. */
+    const aiMesh* LoadMesh(unsigned int pIndex);
+
     // -------------------------------------------------------------------
     /** Returns the scene loaded by the last successful call to ReadFile()
      *  and releases the scene from the ownership of the Importer
@@ -606,6 +675,32 @@ public:
      *   is (naturally) not included.*/
     void GetMemoryRequirements(aiMemoryInfo& in) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the number of timing entries recorded for the last call
+     *  to ReadFile() and any following ApplyPostProcessing() call.
+     *
+     * Timings are only recorded if #AI_CONFIG_GLOB_MEASURE_TIME is set,
+     * otherwise 0 is returned.
+     * @return Number of entries, see GetProfileEntry(). */
+    size_t GetProfileEntryCount() const;
+
+    // -------------------------------------------------------------------
+    /** Returns a timing entry recorded for the last import.
+     *
+     * Entries are stored in the order in which their regions ended, so
+     * the entry of the whole ReadFile() call comes last.
+     * @param index Index of the entry, in range [0,GetProfileEntryCount())
+     * @return NULL if the index is out of range. The returned pointer
+     *   remains valid until the next call to ReadFile(). */
+    const ImportProfileEntry* GetProfileEntry(size_t index) const;
+
+    // -------------------------------------------------------------------
+    /** Returns the largest scene memory footprint seen at the end of any
+     *  profiled region of the last import, in bytes.
+     *
+     * @return 0 if no timings were recorded. */
+    unsigned int GetProfilePeakMemory() const;
+
     // -------------------------------------------------------------------
     /** Enables "extra verbose" mode.
      *
@@ -622,6 +717,9 @@ public:
 
 protected:
 
+    /** Appends a timing entry for the current scene to the profile. */
+    void AddProfileEntry(ImportProfileEntry::Phase phase, const std::string& name, double seconds);
+
     // Just because we don't want you to know how we're hacking around.
     ImporterPimpl* pimpl;
 }; //! class Importer
@@ -0,0 +1,122 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file TaskExecutor.hpp
+ *  @brief Abstract base classes 'Task' and 'TaskExecutor'.
+ */
+#pragma once
+#ifndef AI_TASKEXECUTOR_H_INC
+#define AI_TASKEXECUTOR_H_INC
+
+#include "types.h"
+
+namespace Assimp    {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: A unit of work handed to a #TaskExecutor.
+ *
+ *  Tasks are created by Assimp. The executor must call #Run() exactly once,
+ *  the task releases itself afterwards. */
+class ASSIMP_API Task
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+protected:
+    /** @brief  Default constructor */
+    Task () {
+    }
+public:
+    /** @brief  Virtual destructor  */
+    virtual ~Task () {
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Executes the task and deletes it. May be called from any thread.
+     */
+    virtual void Run() = 0;
+
+}; // !class Task
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Abstract interface for custom thread pools.
+ *
+ *  Each #Importer instance runs its parallel work on a task scheduler,
+ *  which by default owns a pool of worker threads sized by
+ *  #AI_CONFIG_GLOB_MULTITHREADING. Applications which maintain a thread
+ *  pool of their own can supply it via #Importer::SetTaskExecutor()
+ *  instead, Assimp won't start any threads then. */
+class ASSIMP_API TaskExecutor
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+protected:
+    /** @brief  Default constructor */
+    TaskExecutor () {
+    }
+public:
+    /** @brief  Virtual destructor  */
+    virtual ~TaskExecutor () {
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of tasks the executor is able to run
+     *  at the same time, including the thread which submits them.
+     *  @return A value of at least 1.
+     */
+    virtual unsigned int GetConcurrency() const = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Schedules a task for asynchronous execution.
+     *  @param task The task to be run. It must be run eventually, but
+     *    Assimp never waits for a task which hasn't been started yet,
+     *    so it is fine to queue it behind other work.
+     *
+     *  This method may be called from several threads at the same time,
+     *  including from within running tasks.
+     */
+    virtual void Submit(Task* task) = 0;
+
+}; // !class TaskExecutor
+// ------------------------------------------------------------------------------------
+} // Namespace Assimp
+
+#endif // AI_TASKEXECUTOR_H_INC
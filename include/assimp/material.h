@@ -877,6 +877,13 @@ public:
 
      /** Storage allocated */
     unsigned int mNumAllocated;
+
+    /** Internal lookup table for the properties, do not touch */
+#ifdef __cplusplus
+    void* mPrivate;
+#else
+    char* mPrivate;
+#endif
 };
 
 // Go back to extern "C" again
@@ -635,6 +635,19 @@ struct aiMesh
 
     /** Method of morphing when animeshes are specified. */
     unsigned int mMethod;
+
+    /** Optional storage for the indices of all faces.
+     *  If not NULL, the #aiFace::mIndices arrays of the faces may point
+     *  into this array instead of being allocated one by one. The array
+     *  is owned by the mesh, faces with an index array outside of it own
+     *  their indices as usual. Use IsInFaceIndexPool() before releasing
+     *  or replacing the index array of a face.
+     *  See #AI_CONFIG_IMPORT_POOL_FACE_INDICES.
+     */
+    unsigned int* mFaceIndices;
+
+    /** The number of indices in the #mFaceIndices array. */
+    unsigned int mNumFaceIndices;
 	
 #ifdef __cplusplus
 
@@ -653,6 +666,8 @@ struct aiMesh
         , mMaterialIndex( 0 )
         , mNumAnimMeshes( 0 )
         , mAnimMeshes( NULL )
+        , mFaceIndices( NULL )
+        , mNumFaceIndices( 0 )
     {
         for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++)
         {
@@ -693,7 +708,17 @@ struct aiMesh
             delete [] mAnimMeshes;
         }
 
+        // indices in the shared array must not be released by their faces
+        if (mFaceIndices && mFaces) {
+            for( unsigned int a = 0; a < mNumFaces; a++) {
+                if (IsInFaceIndexPool(mFaces[a].mIndices)) {
+                    mFaces[a].mIndices = NULL;
+                }
+            }
+        }
+
         delete [] mFaces;
+        delete [] mFaceIndices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -757,6 +782,47 @@ struct aiMesh
     inline bool HasBones() const
         { return mBones != NULL && mNumBones > 0; }
 
+    //! Check whether the face indices of the mesh are stored in #mFaceIndices
+    bool HasFaceIndexPool() const
+        { return mFaceIndices != NULL && mNumFaceIndices > 0; }
+
+    //! Check whether an index array of a face points into #mFaceIndices,
+    //! i.e. whether it is owned by the mesh instead of the face.
+    bool IsInFaceIndexPool( const unsigned int* pIndices) const
+    {
+        return mFaceIndices != NULL && pIndices >= mFaceIndices &&
+            pIndices < mFaceIndices + mNumFaceIndices;
+    }
+
+    //! Move the index arrays of all faces into a single, newly allocated
+    //! #mFaceIndices array. Faces without index array get room for
+    //! mNumIndices (uninitialized) indices, so importers can set up the
+    //! face sizes first and write the indices afterwards.
+    void PoolFaceIndices()
+    {
+        unsigned int num = 0;
+        for( unsigned int a = 0; a < mNumFaces; a++) {
+            num += mFaces[a].mNumIndices;
+        }
+
+        unsigned int* pool = num ? new unsigned int[num] : NULL, *cur = pool;
+        for( unsigned int a = 0; a < mNumFaces; a++) {
+            aiFace& face = mFaces[a];
+            if (face.mIndices) {
+                ::memcpy( cur, face.mIndices, face.mNumIndices * sizeof( unsigned int));
+                if (!IsInFaceIndexPool(face.mIndices)) {
+                    delete [] face.mIndices;
+                }
+            }
+            face.mIndices = face.mNumIndices ? cur : NULL;
+            cur += face.mNumIndices;
+        }
+
+        delete [] mFaceIndices;
+        mFaceIndices = pool;
+        mNumFaceIndices = num;
+    }
+
 #endif // __cplusplus
 };
 
@@ -0,0 +1,171 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <stdio.h>
+#include <string>
+
+// Helpers for tests which check that an import option or a different code
+// path yields the same meshes as the default import.
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Checks that two meshes hold the same data, field by field. */
+inline void CheckSameMesh( const aiMesh* pExpected, const aiMesh* pActual ) {
+    const aiMesh* a = pExpected;
+    const aiMesh* b = pActual;
+    EXPECT_EQ( a->mPrimitiveTypes, b->mPrimitiveTypes );
+    EXPECT_EQ( a->mMaterialIndex, b->mMaterialIndex );
+    ASSERT_EQ( a->mNumVertices, b->mNumVertices );
+    ASSERT_EQ( a->HasPositions(), b->HasPositions() );
+    ASSERT_EQ( a->HasNormals(), b->HasNormals() );
+    ASSERT_EQ( a->HasTangentsAndBitangents(), b->HasTangentsAndBitangents() );
+    for ( unsigned int v = 0; v < b->mNumVertices; ++v ) {
+        if ( b->HasPositions() ) {
+            EXPECT_EQ( a->mVertices[ v ], b->mVertices[ v ] );
+        }
+        if ( b->HasNormals() ) {
+            EXPECT_EQ( a->mNormals[ v ], b->mNormals[ v ] );
+        }
+        if ( b->HasTangentsAndBitangents() ) {
+            EXPECT_EQ( a->mTangents[ v ], b->mTangents[ v ] );
+            EXPECT_EQ( a->mBitangents[ v ], b->mBitangents[ v ] );
+        }
+    }
+    for ( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c ) {
+        ASSERT_EQ( a->HasVertexColors( c ), b->HasVertexColors( c ) );
+        for ( unsigned int v = 0; b->HasVertexColors( c ) && v < b->mNumVertices; ++v ) {
+            EXPECT_EQ( a->mColors[ c ][ v ], b->mColors[ c ][ v ] );
+        }
+    }
+    for ( unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t ) {
+        ASSERT_EQ( a->HasTextureCoords( t ), b->HasTextureCoords( t ) );
+        EXPECT_EQ( a->mNumUVComponents[ t ], b->mNumUVComponents[ t ] );
+        for ( unsigned int v = 0; b->HasTextureCoords( t ) && v < b->mNumVertices; ++v ) {
+            EXPECT_EQ( a->mTextureCoords[ t ][ v ], b->mTextureCoords[ t ][ v ] );
+        }
+    }
+    ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+    for ( unsigned int f = 0; f < b->mNumFaces; ++f ) {
+        ASSERT_EQ( a->mFaces[ f ].mNumIndices, b->mFaces[ f ].mNumIndices );
+        for ( unsigned int n = 0; n < b->mFaces[ f ].mNumIndices; ++n ) {
+            EXPECT_EQ( a->mFaces[ f ].mIndices[ n ], b->mFaces[ f ].mIndices[ n ] );
+        }
+    }
+    ASSERT_EQ( a->mNumBones, b->mNumBones );
+    for ( unsigned int i = 0; i < b->mNumBones; ++i ) {
+        const aiBone* x = a->mBones[ i ];
+        const aiBone* y = b->mBones[ i ];
+        EXPECT_STREQ( x->mName.C_Str(), y->mName.C_Str() );
+        EXPECT_EQ( x->mOffsetMatrix, y->mOffsetMatrix );
+        ASSERT_EQ( x->mNumWeights, y->mNumWeights );
+        for ( unsigned int w = 0; w < y->mNumWeights; ++w ) {
+            EXPECT_EQ( x->mWeights[ w ].mVertexId, y->mWeights[ w ].mVertexId );
+            EXPECT_EQ( x->mWeights[ w ].mWeight, y->mWeights[ w ].mWeight );
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+/** Checks that two scenes hold the same meshes. */
+inline void CheckSameMeshes( const aiScene* pExpected, const aiScene* pActual ) {
+    ASSERT_TRUE( NULL != pExpected );
+    ASSERT_TRUE( NULL != pActual );
+    ASSERT_EQ( pExpected->mNumMeshes, pActual->mNumMeshes );
+    for ( unsigned int i = 0; i < pActual->mNumMeshes; ++i ) {
+        SCOPED_TRACE( i );
+        CheckSameMesh( pExpected->mMeshes[ i ], pActual->mMeshes[ i ] );
+    }
+}
+
+// ---------------------------------------------------------------------------
+/** Imports a file with a default importer and with the given one, which is
+ *  set up with the option under test, and checks that both produce the same
+ *  meshes.
+ *  @return The scene of pImporter, NULL if the import failed. */
+inline const aiScene* CheckSameImport( Importer& pImporter, const std::string& pFile, unsigned int pFlags = 0 ) {
+    Importer plain;
+    const aiScene* expected = plain.ReadFile( pFile, pFlags );
+    const aiScene* actual = pImporter.ReadFile( pFile, pFlags );
+    EXPECT_TRUE( NULL != expected ) << pFile;
+    EXPECT_TRUE( NULL != actual ) << pFile;
+    if ( NULL == expected || NULL == actual ) {
+        return NULL;
+    }
+    SCOPED_TRACE( pFile );
+    CheckSameMeshes( expected, actual );
+    return actual;
+}
+
+// ---------------------------------------------------------------------------
+/** A file written by a test, placed in the directory for temporary files
+ *  and removed when the object goes out of scope. */
+class TemporaryFile {
+public:
+    explicit TemporaryFile( const char* pName )
+    : mPath( ::testing::internal::TempDir() + pName ) {
+        ::remove( mPath.c_str() );
+    }
+
+    ~TemporaryFile() {
+        ::remove( mPath.c_str() );
+    }
+
+    const std::string& Path() const {
+        return mPath;
+    }
+
+    const char* c_str() const {
+        return mPath.c_str();
+    }
+
+private:
+    TemporaryFile( const TemporaryFile& );
+    TemporaryFile& operator=( const TemporaryFile& );
+
+    std::string mPath;
+};
+
+} // ! namespace Assimp
@@ -0,0 +1,169 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ImportCompare.h"
+#include "SceneCombiner.h"
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utAssbinImportExport : public ::testing::Test {
+protected:
+    // Exports a file to Assbin and reads it back with the given settings
+    static void CheckRoundtrip( const char* pFile, bool pMapped, bool pArena ) {
+        TemporaryFile out( "roundtrip.assbin" );
+        Importer importer;
+        const aiScene* scene = importer.ReadFile( pFile, 0 );
+        ASSERT_NE( nullptr, scene );
+
+        Exporter exporter;
+        ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", out.c_str() ) );
+
+        Importer reader;
+        reader.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, pMapped );
+        reader.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, pArena );
+        const aiScene* actual = reader.ReadFile( out.Path(), aiProcess_ValidateDataStructure );
+        ASSERT_NE( nullptr, actual );
+        CheckSameMeshes( scene, actual );
+    }
+};
+
+TEST_F( utAssbinImportExport, roundtripTest ) {
+    CheckRoundtrip( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", false, false );
+    CheckRoundtrip( ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic.X", false, false );
+    CheckRoundtrip( ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic.X", true, true );
+}
+
+TEST_F( utAssbinImportExport, lazyMeshesTest ) {
+    Importer importer;
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_LT( 1U, scene->mNumMeshes );
+
+    TemporaryFile file( "spider_lazy.assbin" );
+    Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", file.c_str() ) );
+
+    Importer lazy;
+    lazy.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, true );
+    lazy.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES, true );
+    const aiScene* actual = lazy.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, actual );
+    ASSERT_EQ( scene->mNumMeshes, actual->mNumMeshes );
+
+    // meshes only know their sizes until they are loaded
+    const aiMesh* mesh = actual->mMeshes[ 0 ];
+    EXPECT_EQ( scene->mMeshes[ 0 ]->mNumVertices, mesh->mNumVertices );
+    EXPECT_EQ( scene->mMeshes[ 0 ]->mNumFaces, mesh->mNumFaces );
+    EXPECT_EQ( nullptr, mesh->mVertices );
+    EXPECT_EQ( nullptr, mesh->mFaces );
+
+    EXPECT_EQ( mesh, lazy.LoadMesh( 0 ) );
+    CheckSameMesh( scene->mMeshes[ 0 ], mesh );
+    EXPECT_EQ( nullptr, actual->mMeshes[ 1 ]->mVertices );
+    EXPECT_EQ( nullptr, lazy.LoadMesh( actual->mNumMeshes ) );
+
+    // copying the scene loads all of them
+    aiScene* copy = NULL;
+    SceneCombiner::CopyScene( &copy, actual );
+    ASSERT_NE( nullptr, copy );
+    CheckSameMeshes( scene, copy );
+    CheckSameMeshes( scene, actual );
+    delete copy;
+
+    // without a memory mapped file, everything is loaded right away
+    Importer unmapped;
+    unmapped.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES, true );
+    actual = unmapped.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( scene, actual );
+}
+
+TEST_F( utAssbinImportExport, compressedTest ) {
+    Importer importer;
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/X/BCN_Epileptic.X", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    TemporaryFile plainFile( "bcn_plain.assbin" ), compressedFile( "bcn_compressed.assbin" ), storedFile( "bcn_stored.assbin" );
+    Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", plainFile.c_str() ) );
+
+    ExportProperties properties;
+    properties.SetPropertyBool( AI_CONFIG_EXPORT_ASSBIN_COMPRESSED, true );
+    properties.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_COMPRESSION_LEVEL, 1 );
+    properties.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_NUM_THREADS, 4 );
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", compressedFile.c_str(), 0, &properties ) );
+
+    properties.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_COMPRESSION_LEVEL, 0 );
+    properties.SetPropertyInteger( AI_CONFIG_EXPORT_ASSBIN_NUM_THREADS, 1 );
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", storedFile.c_str(), 0, &properties ) );
+
+    Importer plain;
+    const aiScene* expected = plain.ReadFile( plainFile.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+
+    const char* files[] = { compressedFile.c_str(), storedFile.c_str() };
+    for ( const char* file : files ) {
+        for ( int threads = 0; threads < 2; ++threads ) {
+            Importer reader;
+            reader.SetPropertyInteger( AI_CONFIG_IMPORT_ASSBIN_NUM_THREADS, threads );
+            reader.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, 0 == threads );
+            const aiScene* actual = reader.ReadFile( file, aiProcess_ValidateDataStructure );
+            ASSERT_NE( nullptr, actual );
+            CheckSameMeshes( scene, actual );
+            ASSERT_EQ( expected->mNumAnimations, actual->mNumAnimations );
+            EXPECT_EQ( expected->mAnimations[ 0 ]->mNumChannels, actual->mAnimations[ 0 ]->mNumChannels );
+        }
+    }
+
+    // the compressed file loads lazily from the inflated data
+    Importer lazy;
+    lazy.SetPropertyBool( AI_CONFIG_IMPORT_ASSBIN_LAZY_MESHES, true );
+    const aiScene* actual = lazy.ReadFile( compressedFile.Path(), 0 );
+    ASSERT_NE( nullptr, actual );
+    EXPECT_EQ( nullptr, actual->mMeshes[ 0 ]->mVertices );
+    ASSERT_NE( nullptr, lazy.LoadMesh( 0 ) );
+    CheckSameMesh( scene->mMeshes[ 0 ], actual->mMeshes[ 0 ] );
+}
@@ -41,6 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include "Importer.h"
 #include "TestIOSystem.h"
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/Importer.hpp>
 
 using namespace ::Assimp;
 
@@ -76,3 +79,45 @@ TEST_F( BatchLoaderTest, validateAccessTest ) {
     BatchLoader loader2( m_io, true );
     EXPECT_TRUE( loader2.getValidation() );
 }
+
+TEST_F( BatchLoaderTest, numThreadsAccessTest ) {
+    BatchLoader loader( m_io );
+    EXPECT_EQ( 1U, loader.getNumThreads() );
+    loader.setNumThreads( 4 );
+    EXPECT_EQ( 4U, loader.getNumThreads() );
+}
+
+TEST_F( BatchLoaderTest, loadAllThreadedTest ) {
+    static const char* files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply",
+        ASSIMP_TEST_MODELS_DIR "/MD2/sydney.md2",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/does_not_exist.obj"
+    };
+    static const size_t numFiles = sizeof( files ) / sizeof( files[ 0 ] );
+
+    // borrow the default IOSystem of an importer
+    Assimp::Importer owner;
+    BatchLoader loader( owner.GetIOHandler(), true );
+    loader.setNumThreads( 3 );
+    unsigned int ids[ numFiles ];
+    for ( size_t i = 0; i < numFiles; ++i ) {
+        ids[ i ] = loader.AddLoadRequest( files[ i ] );
+    }
+    loader.LoadAll();
+
+    // every request must end up in its own slot, regardless of completion order
+    for ( size_t i = 0; i + 1 < numFiles; ++i ) {
+        aiScene* scene = loader.GetImport( ids[ i ] );
+        ASSERT_NE( nullptr, scene );
+
+        Assimp::Importer importer;
+        const aiScene* expected = importer.ReadFile( files[ i ], aiProcess_ValidateDataStructure );
+        ASSERT_NE( nullptr, expected );
+        EXPECT_EQ( expected->mNumMeshes, scene->mNumMeshes );
+        EXPECT_EQ( expected->mMeshes[ 0 ]->mNumVertices, scene->mMeshes[ 0 ]->mNumVertices );
+        delete scene;
+    }
+    EXPECT_EQ( nullptr, loader.GetImport( ids[ numFiles - 1 ] ) );
+}
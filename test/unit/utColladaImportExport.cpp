@@ -40,8 +40,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "ImportCompare.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <fstream>
 
 using namespace Assimp;
 
@@ -52,8 +56,61 @@ public:
         const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/Collada/duck.dae", 0 );
         return nullptr != scene;
     }
+
+    // Writes a grid with large <float_array> and <p> elements, pSurplus values more than counted
+    static void WriteGrid( const char* pFile, unsigned int pSize, unsigned int pSurplus ) {
+        std::ofstream out( pFile );
+        const unsigned int numVertices = ( pSize + 1 ) * ( pSize + 1 );
+        out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+            << "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+            << "<library_geometries><geometry id=\"grid\"><mesh>\n"
+            << "<source id=\"grid-positions\"><float_array id=\"grid-positions-array\" count=\"" << numVertices * 3 << "\">\n";
+        for ( unsigned int v = 0; v < numVertices + pSurplus; ++v ) {
+            const unsigned int x = v % ( pSize + 1 ), y = v / ( pSize + 1 );
+            out << x * 0.0137f - 1.5f << " " << -( y * 1.0071f ) << "\t" << ( x * y ) % 97 * 1e-3f
+                << ( v % 7 ? " " : "\r\n" );
+        }
+        out << "</float_array>\n<technique_common><accessor source=\"#grid-positions-array\" count=\"" << numVertices
+            << "\" stride=\"3\"><param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/>"
+            << "<param name=\"Z\" type=\"float\"/></accessor></technique_common></source>\n"
+            << "<vertices id=\"grid-vertices\"><input semantic=\"POSITION\" source=\"#grid-positions\"/></vertices>\n"
+            << "<triangles count=\"" << pSize * pSize * 2 << "\"><input semantic=\"VERTEX\" source=\"#grid-vertices\" offset=\"0\"/><p>";
+        for ( unsigned int y = 0; y < pSize; ++y ) {
+            for ( unsigned int x = 0; x < pSize; ++x ) {
+                const unsigned int i = y * ( pSize + 1 ) + x;
+                out << i << " " << i + 1 << " " << i + pSize + 1 << " "
+                    << i + 1 << " " << i + pSize + 2 << " " << i + pSize + 1 << ( x % 5 ? "  " : "\n" );
+            }
+        }
+        out << "</p></triangles>\n</mesh></geometry></library_geometries>\n"
+            << "<library_visual_scenes><visual_scene id=\"Scene\"><node id=\"node\">"
+            << "<instance_geometry url=\"#grid\"/></node></visual_scene></library_visual_scenes>\n"
+            << "<scene><instance_visual_scene url=\"#Scene\"/></scene>\n</COLLADA>\n";
+    }
 };
 
 TEST_F( utColladaImportExport, importBlenFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utColladaImportExport, parallelArrayTest ) {
+    TemporaryFile grid( "grid.dae" );
+    for ( unsigned int surplus = 0; surplus < 2; ++surplus ) {
+        WriteGrid( grid.c_str(), 200, surplus );
+
+        Assimp::Importer serial;
+        const aiScene* expected = serial.ReadFile( grid.Path(), 0 );
+        ASSERT_NE( nullptr, expected );
+        ASSERT_EQ( 1U, expected->mNumMeshes );
+        EXPECT_EQ( 80000U, expected->mMeshes[ 0 ]->mNumFaces );
+
+        const int threads[] = { 0, 3 };
+        for ( int numThreads : threads ) {
+            Assimp::Importer parallel;
+            parallel.SetPropertyInteger( AI_CONFIG_IMPORT_COLLADA_NUM_THREADS, numThreads );
+            const aiScene* actual = parallel.ReadFile( grid.Path(), 0 );
+            ASSERT_NE( nullptr, actual );
+            CheckSameMeshes( expected, actual );
+        }
+    }
+}
@@ -59,3 +59,19 @@ public:
 TEST_F( utFBXImporterExporter, importXFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utFBXImporterExporter, importBinaryWithThreadsTest ) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile( ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", 0 );
+    ASSERT_NE( nullptr, expected );
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_FBX_NUM_THREADS, 4 );
+    parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, scene ) );
+    differ.showReport();
+}
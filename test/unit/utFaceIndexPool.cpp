@@ -0,0 +1,171 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ImportCompare.h"
+#include "SceneCombiner.h"
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utFaceIndexPool : public ::testing::Test {
+protected:
+    // Imports a file twice, with and without pooled face indices, and checks that both
+    // imports produce the same meshes and that all faces of the pooled import use the pool.
+    static void CheckPooledImport( const char* pFile, unsigned int pFlags ) {
+        Importer pooled;
+        pooled.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, true );
+        const aiScene* actual = CheckSameImport( pooled, pFile, pFlags );
+        ASSERT_NE( nullptr, actual );
+        CheckPooled( actual, pFlags == 0 );
+    }
+
+    static void CheckPooled( const aiScene* pScene, bool pAllPooled ) {
+        for ( unsigned int i = 0; i < pScene->mNumMeshes; ++i ) {
+            const aiMesh* mesh = pScene->mMeshes[ i ];
+            EXPECT_TRUE( mesh->HasFaceIndexPool() );
+            for ( unsigned int f = 0; pAllPooled && f < mesh->mNumFaces; ++f ) {
+                EXPECT_TRUE( mesh->IsInFaceIndexPool( mesh->mFaces[ f ].mIndices ) );
+            }
+        }
+    }
+};
+
+TEST_F( utFaceIndexPool, poolFaceIndicesTest ) {
+    aiMesh mesh;
+    mesh.mNumFaces = 3;
+    mesh.mFaces = new aiFace[ 3 ];
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        mesh.mFaces[ i ].mNumIndices = i + 1;
+        mesh.mFaces[ i ].mIndices = new unsigned int[ i + 1 ];
+        for ( unsigned int n = 0; n <= i; ++n ) {
+            mesh.mFaces[ i ].mIndices[ n ] = 10 * i + n;
+        }
+    }
+    EXPECT_FALSE( mesh.HasFaceIndexPool() );
+
+    mesh.PoolFaceIndices();
+    ASSERT_TRUE( mesh.HasFaceIndexPool() );
+    EXPECT_EQ( 6U, mesh.mNumFaceIndices );
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        EXPECT_TRUE( mesh.IsInFaceIndexPool( mesh.mFaces[ i ].mIndices ) );
+        for ( unsigned int n = 0; n <= i; ++n ) {
+            EXPECT_EQ( 10 * i + n, mesh.mFaces[ i ].mIndices[ n ] );
+        }
+    }
+
+    // faces added later own their indices, pooling again merges them
+    aiFace* faces = new aiFace[ 4 ];
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        faces[ i ].mNumIndices = mesh.mFaces[ i ].mNumIndices;
+        faces[ i ].mIndices = mesh.mFaces[ i ].mIndices;
+        mesh.mFaces[ i ].mIndices = NULL;
+    }
+    faces[ 3 ].mNumIndices = 2;
+    faces[ 3 ].mIndices = new unsigned int[ 2 ];
+    faces[ 3 ].mIndices[ 0 ] = 30;
+    faces[ 3 ].mIndices[ 1 ] = 31;
+    delete[] mesh.mFaces;
+    mesh.mFaces = faces;
+    mesh.mNumFaces = 4;
+    EXPECT_FALSE( mesh.IsInFaceIndexPool( faces[ 3 ].mIndices ) );
+
+    mesh.PoolFaceIndices();
+    EXPECT_EQ( 8U, mesh.mNumFaceIndices );
+    EXPECT_TRUE( mesh.IsInFaceIndexPool( faces[ 3 ].mIndices ) );
+    EXPECT_EQ( 31U, faces[ 3 ].mIndices[ 1 ] );
+    EXPECT_EQ( 20U, faces[ 2 ].mIndices[ 0 ] );
+}
+
+TEST_F( utFaceIndexPool, importTest ) {
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", 0 );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0 );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", 0 );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/OBJ/testmixed.obj", 0 );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF/BoxTextured.gltf", 0 );
+}
+
+TEST_F( utFaceIndexPool, postProcessTest ) {
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_SortByPType | aiProcess_FindDegenerates |
+        aiProcess_PreTransformVertices | aiProcess_JoinIdenticalVertices;
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", flags );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/OBJ/testmixed.obj", flags );
+    CheckPooledImport( ASSIMP_TEST_MODELS_DIR "/OBJ/concave_polygon.obj", flags );
+}
+
+TEST_F( utFaceIndexPool, copySceneTest ) {
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, true );
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    aiScene* copy = NULL;
+    SceneCombiner::CopyScene( &copy, scene );
+    ASSERT_NE( nullptr, copy );
+    CheckSameMeshes( scene, copy );
+    CheckPooled( copy, true );
+    for ( unsigned int i = 0; i < copy->mNumMeshes; ++i ) {
+        EXPECT_NE( scene->mMeshes[ i ]->mFaceIndices, copy->mMeshes[ i ]->mFaceIndices );
+    }
+    delete copy;
+}
+
+TEST_F( utFaceIndexPool, assbinRoundtripTest ) {
+    Importer importer;
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    TemporaryFile file( "spider_pooled.assbin" );
+    Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", file.c_str() ) );
+
+    Importer pooled;
+    pooled.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, true );
+    const aiScene* actual = pooled.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( scene, actual );
+    CheckPooled( actual, true );
+}
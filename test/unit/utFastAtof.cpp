@@ -186,3 +186,45 @@ TEST_F(FastAtofTest, FastAtof)
 {
     RunTest<ai_real>(FastAtofWrapper());
 }
+
+TEST_F(FastAtofTest, CorrectRounding)
+{
+    static const char* const cases[] = {
+        "0.1", "1.354", "-34555.534954e-5", "16777217", "9007199254740993",
+        "1.00000005960464477539062499", "1.000000059604644775390625",
+        "1.00000005960464477539062501", "2.2250738585072011e-308", "4.9e-324",
+        "1.7976931348623157e308", "1.17549435e-38", "1.4e-45", "3.4028235e38",
+        "7.038531e-26", "123456789012345678901234567890", "0.000000000000000000000000000001234",
+        "1e400", "1e-400", "-0.0", "3.", "1.e5", "0.30000000000000004"
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        double d;
+        float f;
+        Assimp::fast_atoreal_move<double>(cases[i], d);
+        Assimp::fast_atoreal_move<float>(cases[i], f);
+        EXPECT_EQ(::strtod(cases[i], NULL), d) << cases[i];
+        EXPECT_EQ(::strtof(cases[i], NULL), f) << cases[i];
+    }
+
+    // printing with enough digits and reading back must give the same bits
+    char buffer[64];
+    uint32_t bits = 12345;
+    for (unsigned int i = 0; i < 100000; ++i) {
+        bits = bits * 1664525u + 1013904223u;
+        float expected;
+        ::memcpy(&expected, &bits, sizeof(expected));
+        if (IsNan(expected) || IsInf(expected)) {
+            continue;
+        }
+        ::snprintf(buffer, sizeof(buffer), "%.9g", expected);
+        float actual;
+        Assimp::fast_atoreal_move<float>(buffer, actual);
+        ASSERT_EQ(expected, actual) << buffer;
+
+        const double value = expected * 1234.5678;
+        ::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        double parsed;
+        Assimp::fast_atoreal_move<double>(buffer, parsed);
+        ASSERT_EQ(value, parsed) << buffer;
+    }
+}
@@ -39,9 +39,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 #include "UnitTestPCH.h"
+#include "SceneDiffer.h"
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 
 using namespace Assimp;
 
@@ -59,3 +61,19 @@ public:
 TEST_F( utIFCImportExport, importIFCFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utIFCImportExport, importIFCWithThreadsTest ) {
+    Assimp::Importer serial;
+    const aiScene *expected = serial.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, expected );
+
+    Assimp::Importer parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_IFC_NUM_THREADS, 4 );
+    parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+    const aiScene *scene = parallel.ReadFile( ASSIMP_TEST_MODELS_DIR "/IFC/AC14-FZK-Haus.ifc", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    SceneDiffer differ;
+    EXPECT_TRUE( differ.isEqual( expected, scene ) );
+    differ.showReport();
+}
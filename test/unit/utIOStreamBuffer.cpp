@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include "IOStreamBuffer.h"
 #include "TestIOStream.h"
+#include "MemoryIOWrapper.h"
 
 class IOStreamBufferTest : public ::testing::Test {
     // empty
@@ -109,6 +110,49 @@ TEST_F( IOStreamBufferTest, readlineTest ) {
     EXPECT_TRUE( myBuffer.close() );
 }
 
+TEST_F( IOStreamBufferTest, getNextLineTest ) {
+    static const char text[] = "first\nthis line is longer than the cache\r\nlast";
+    MemoryIOStream myStream( reinterpret_cast<const uint8_t*>( text ), sizeof( text ) - 1 );
+    IOStreamBuffer<char> myBuffer( 8 );
+    EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+    // lines are terminated with a single line feed
+    std::vector<char> line;
+    ASSERT_TRUE( myBuffer.getNextLine( line ) );
+    EXPECT_EQ( "first", std::string( &line[ 0 ], 5 ) );
+    EXPECT_EQ( '\n', line[ 5 ] );
+    ASSERT_TRUE( myBuffer.getNextLine( line ) );
+    EXPECT_EQ( "this line is longer than the cache", std::string( &line[ 0 ], 34 ) );
+    EXPECT_EQ( '\n', line[ 34 ] );
+
+    // the line feed after the carriage return gives an empty line
+    ASSERT_TRUE( myBuffer.getNextLine( line ) );
+    EXPECT_EQ( '\n', line[ 0 ] );
+    ASSERT_TRUE( myBuffer.getNextLine( line ) );
+    EXPECT_EQ( "last", std::string( &line[ 0 ], 4 ) );
+    EXPECT_EQ( '\n', line[ 4 ] );
+    EXPECT_FALSE( myBuffer.getNextLine( line ) );
+    EXPECT_TRUE( myBuffer.close() );
+}
+
+TEST_F( IOStreamBufferTest, getNextLineBlockTest ) {
+    static const char text[] = "one\ntwo\nthree is a long line\nfour";
+    MemoryIOStream myStream( reinterpret_cast<const uint8_t*>( text ), sizeof( text ) - 1 );
+    IOStreamBuffer<char> myBuffer( 10 );
+    EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+    // blocks end after the last complete line of the cache
+    std::vector<char> block;
+    ASSERT_TRUE( myBuffer.getNextLineBlock( block ) );
+    EXPECT_STREQ( "one\ntwo\n", &block[ 0 ] );
+    ASSERT_TRUE( myBuffer.getNextLineBlock( block ) );
+    EXPECT_STREQ( "three is a long line\n", &block[ 0 ] );
+    ASSERT_TRUE( myBuffer.getNextLineBlock( block ) );
+    EXPECT_STREQ( "four\n", &block[ 0 ] );
+    EXPECT_FALSE( myBuffer.getNextLineBlock( block ) );
+    EXPECT_TRUE( myBuffer.close() );
+}
+
 TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
@@ -46,6 +46,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <BaseImporter.h>
 #include "TestIOSystem.h"
 #include "DefaultIOSystem.h"
+#include "ImportCache.h"
+#include "ImportCompare.h"
+#include "SceneDiffer.h"
+#include <fstream>
 
 using namespace ::std;
 using namespace ::Assimp;
@@ -272,6 +276,252 @@ TEST_F(ImporterTest, testMultipleReads)
     //EXPECT_TRUE(pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/X/dwarf.x",flags)); # is in nonbsd
 }
 
+TEST_F(ImporterTest, testParallelPostProcessing)
+{
+    // Per-mesh parallel post-processing must yield exactly the same
+    // scene as the serial execution.
+    const unsigned int flags =
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_GenSmoothNormals |
+        aiProcess_CalcTangentSpace |
+        aiProcess_ImproveCacheLocality |
+        aiProcess_ValidateDataStructure;
+
+    Importer serial;
+    const aiScene* expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",flags);
+    ASSERT_TRUE(NULL != expected);
+    ASSERT_TRUE(expected->mNumMeshes > 1);
+
+    pImp->SetPropertyBool(AI_CONFIG_PP_PARALLEL_MESHES,true);
+    pImp->SetPropertyInteger(AI_CONFIG_PP_PARALLEL_NUM_THREADS,4);
+    pImp->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,4);
+    const aiScene* parallel = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",flags);
+    ASSERT_TRUE(NULL != parallel);
+
+    SceneDiffer differ;
+    EXPECT_TRUE(differ.isEqual(expected,parallel));
+    for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+        EXPECT_EQ(expected->mMeshes[i]->mNumVertices,parallel->mMeshes[i]->mNumVertices);
+        EXPECT_EQ(0,memcmp(expected->mMeshes[i]->mTangents,parallel->mMeshes[i]->mTangents,
+            expected->mMeshes[i]->mNumVertices*sizeof(aiVector3D)));
+    }
+}
+
+TEST_F(ImporterTest, testProfile)
+{
+    // no timings unless they have been requested
+    EXPECT_TRUE(NULL != pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",aiProcess_Triangulate));
+    EXPECT_EQ(0U,pImp->GetProfileEntryCount());
+
+    pImp->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME,true);
+    EXPECT_TRUE(NULL != pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices));
+
+    bool import = false, triangulate = false, join = false;
+    for (size_t i = 0; i < pImp->GetProfileEntryCount(); ++i) {
+        const ImportProfileEntry* entry = pImp->GetProfileEntry(i);
+        ASSERT_TRUE(NULL != entry);
+        EXPECT_LE(0.0,entry->mSeconds);
+        if (entry->mPhase == ImportProfileEntry::Phase_Import) {
+            import = true;
+        } else if (entry->mPhase == ImportProfileEntry::Phase_PostProcess) {
+            triangulate |= !strcmp(entry->mName.C_Str(),"TriangulateProcess");
+            join |= !strcmp(entry->mName.C_Str(),"JoinVerticesProcess");
+        }
+    }
+    EXPECT_TRUE(import);
+    EXPECT_TRUE(triangulate);
+    EXPECT_TRUE(join);
+
+    // the whole import is reported last
+    const ImportProfileEntry* total = pImp->GetProfileEntry(pImp->GetProfileEntryCount() - 1);
+    ASSERT_TRUE(NULL != total);
+    EXPECT_EQ(ImportProfileEntry::Phase_Total,total->mPhase);
+    EXPECT_EQ(pImp->GetScene()->mNumMeshes,total->mNumMeshes);
+    EXPECT_LE(total->mSceneMemory,pImp->GetProfilePeakMemory());
+    EXPECT_TRUE(NULL == pImp->GetProfileEntry(pImp->GetProfileEntryCount()));
+}
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+static bool FileExists(const std::string& path)
+{
+    FILE* file = ::fopen(path.c_str(), "rb");
+    if (file) {
+        ::fclose(file);
+    }
+    return NULL != file;
+}
+
+static void RemoveCacheEntry(const ImportCache& entry)
+{
+    ::remove(entry.GetEntryPath().c_str());
+    ::remove(entry.GetDependencyPath().c_str());
+}
+
+TEST_F(ImporterTest, testImportCache)
+{
+    const char* file = ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj";
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices;
+    const std::string directory = ::testing::internal::TempDir();
+
+    // drop the entries of previous runs
+    ImportCache entry(directory), otherEntry(directory);
+    ASSERT_TRUE(entry.ComputeKey(pImp, file, pImp->GetImporter("obj"), flags));
+    ASSERT_TRUE(otherEntry.ComputeKey(pImp, file, pImp->GetImporter("obj"), aiProcess_Triangulate));
+    EXPECT_NE(entry.GetEntryPath(), otherEntry.GetEntryPath());
+    RemoveCacheEntry(entry);
+    RemoveCacheEntry(otherEntry);
+
+    // the first import fills the cache
+    pImp->SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY, directory);
+    const aiScene* expected = pImp->ReadFile(file, flags);
+    ASSERT_TRUE(NULL != expected);
+    EXPECT_TRUE(FileExists(entry.GetEntryPath()));
+    EXPECT_TRUE(FileExists(entry.GetDependencyPath()));
+
+    // the second one is served from it, so nothing is imported or post-processed
+    Importer cached;
+    cached.SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY, directory);
+    cached.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+    const aiScene* scene = cached.ReadFile(file, flags);
+    ASSERT_TRUE(NULL != scene);
+    ASSERT_EQ(1U, cached.GetProfileEntryCount());
+    EXPECT_EQ(ImportProfileEntry::Phase_Total, cached.GetProfileEntry(0)->mPhase);
+    CheckSameMeshes(expected, scene);
+
+    // different post-processing flags mean a different entry
+    Importer other;
+    other.SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY, directory);
+    other.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+    ASSERT_TRUE(NULL != other.ReadFile(file, aiProcess_Triangulate));
+    EXPECT_LT(1U, other.GetProfileEntryCount());
+    EXPECT_TRUE(FileExists(otherEntry.GetEntryPath()));
+
+    RemoveCacheEntry(entry);
+    RemoveCacheEntry(otherEntry);
+}
+
+static aiColor4D ReadCachedDiffuse(const std::string& file, bool& cached)
+{
+    Importer importer;
+    importer.SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY, ::testing::internal::TempDir());
+    importer.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, true);
+    const aiScene* scene = importer.ReadFile(file, 0);
+    aiColor4D diffuse;
+    EXPECT_TRUE(NULL != scene);
+    if (scene) {
+        cached = 1U == importer.GetProfileEntryCount();
+        scene->mMaterials[scene->mMeshes[0]->mMaterialIndex]->Get(AI_MATKEY_COLOR_DIFFUSE, diffuse);
+    }
+    return diffuse;
+}
+
+static void WriteFile(const TemporaryFile& file, const char* content)
+{
+    std::ofstream out(file.c_str(), std::ios::binary);
+    out << content;
+}
+
+TEST_F(ImporterTest, testImportCacheDependencies)
+{
+    TemporaryFile obj("cache_dependency.obj"), mtl("cache_dependency.mtl");
+    WriteFile(obj, "mtllib cache_dependency.mtl\nusemtl red\nv 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n");
+
+    // drop the entry of a previous run
+    ImportCache entry(::testing::internal::TempDir());
+    ASSERT_TRUE(entry.ComputeKey(pImp, obj.Path(), pImp->GetImporter("obj"), 0));
+    RemoveCacheEntry(entry);
+
+    // the material library doesn't exist yet
+    bool cached = true;
+    EXPECT_EQ(aiColor4D(0.6f, 0.6f, 0.6f, 1.f), ReadCachedDiffuse(obj.Path(), cached));
+    EXPECT_FALSE(cached);
+    ReadCachedDiffuse(obj.Path(), cached);
+    EXPECT_TRUE(cached);
+
+    WriteFile(mtl, "newmtl red\nKd 1 0 0\n");
+    EXPECT_EQ(aiColor4D(1.f, 0.f, 0.f, 1.f), ReadCachedDiffuse(obj.Path(), cached));
+    EXPECT_FALSE(cached);
+    ReadCachedDiffuse(obj.Path(), cached);
+    EXPECT_TRUE(cached);
+
+    // changing the material library invalidates the entry
+    WriteFile(mtl, "newmtl red\nKd 0 1 0\n");
+    EXPECT_EQ(aiColor4D(0.f, 1.f, 0.f, 1.f), ReadCachedDiffuse(obj.Path(), cached));
+    EXPECT_FALSE(cached);
+
+    RemoveCacheEntry(entry);
+}
+
+static const aiImporterDesc oversizedDesc = {
+    "UNIT TEST - OVERSIZED MESH IMPORTER",
+    "",
+    "",
+    "",
+    0,
+    0,
+    0,
+    0,
+    0,
+    "oversized"
+};
+
+// Claims more vertices than fit into an assbin mesh block. The exporter only
+// counts their bytes before it gives up, so one vertex is actually allocated.
+class OversizedMeshPlugin : public BaseImporter
+{
+public:
+    virtual bool CanRead(
+        const std::string& pFile, IOSystem* /*pIOHandler*/, bool /*test*/) const
+    {
+        return SimpleExtensionCheck(pFile, "oversized");
+    }
+
+    virtual const aiImporterDesc* GetInfo () const
+    {
+        return & oversizedDesc;
+    }
+
+    virtual void InternReadFile(
+        const std::string& /*pFile*/, aiScene* pScene, IOSystem* /*pIOHandler*/)
+    {
+        aiMesh* mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POINT;
+        mesh->mNumVertices = 0x20000000;
+        mesh->mVertices = new aiVector3D[1];
+
+        pScene->mNumMeshes = 1;
+        pScene->mMeshes = new aiMesh*[1];
+        pScene->mMeshes[0] = mesh;
+        pScene->mRootNode = new aiNode();
+        pScene->mRootNode->mNumMeshes = 1;
+        pScene->mRootNode->mMeshes = new unsigned int[1];
+        pScene->mRootNode->mMeshes[0] = 0;
+    }
+};
+
+TEST_F(ImporterTest, testImportCacheExportFailure)
+{
+    TemporaryFile file("cache_export.oversized");
+    WriteFile(file, "oversized");
+    pImp->RegisterLoader(new OversizedMeshPlugin());
+
+    ImportCache entry(::testing::internal::TempDir());
+    ASSERT_TRUE(entry.ComputeKey(pImp, file.Path(), pImp->GetImporter("oversized"), 0));
+    RemoveCacheEntry(entry);
+
+    // the export throws, the import still succeeds and nothing is left behind
+    pImp->SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE_DIRECTORY, ::testing::internal::TempDir());
+    const aiScene* scene = pImp->ReadFile(file.Path(), 0);
+    ASSERT_TRUE(NULL != scene);
+    EXPECT_EQ(0x20000000U, scene->mMeshes[0]->mNumVertices);
+    EXPECT_FALSE(FileExists(entry.GetEntryPath()));
+    EXPECT_FALSE(FileExists(entry.GetEntryPath() + ".tmp"));
+    EXPECT_FALSE(FileExists(entry.GetDependencyPath()));
+}
+#endif // ASSIMP_BUILD_NO_IMPORT_CACHE
+
 TEST_F( ImporterTest, SearchFileHeaderForTokenTest ) {
     //DefaultIOSystem ioSystem;
 //    BaseImporter::SearchFileHeaderForToken( &ioSystem, assetPath, Token, 2 )
@@ -0,0 +1,178 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "irrXMLWrapper.h"
+#include "MemoryIOWrapper.h"
+#include "fast_atof.h"
+#include "./../contrib/irrXML/CXMLReaderImpl.h"
+
+#include <memory>
+
+using namespace Assimp;
+using namespace irr::io;
+
+class utIrrXMLWrapper : public ::testing::Test {
+protected:
+    static IrrXMLReader* CreateReader( const char* pText, size_t pLength, std::unique_ptr<IOStream>& pStream ) {
+        pStream.reset( new MemoryIOStream( reinterpret_cast<const uint8_t*>( pText ), pLength ) );
+        CIrrXML_IOStreamReader wrapper( pStream.get() );
+        // the reader is built into the library without exporting it
+        return new CXMLReaderImpl<char, IXMLBase>( &wrapper, false );
+    }
+
+    // Reads the next node which isn't blank text
+    static bool Next( IrrXMLReader* pReader ) {
+        while ( pReader->read() ) {
+            if ( pReader->getNodeType() != EXN_TEXT ||
+                    strspn( pReader->getNodeData(), " \t\r\n" ) != strlen( pReader->getNodeData() ) ) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F( utIrrXMLWrapper, readTest ) {
+    const char xml[] =
+        "<?xml version=\"1.0\"?>\n"
+        "<root a=\"1 &amp; 2\" b='&lt;x&gt;'>\n"
+        "  <!-- a comment -->\n"
+        "  <item name=\"first\"/>\n"
+        "  <text>x &lt; y &quot;z&quot; &unknown; end</text>\n"
+        "  <![CDATA[raw <data>]]>\n"
+        "</root>";
+
+    std::unique_ptr<IOStream> stream;
+    std::unique_ptr<IrrXMLReader> reader( CreateReader( xml, sizeof( xml ) - 1, stream ) );
+    ASSERT_NE( nullptr, reader.get() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_UNKNOWN, reader->getNodeType() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT, reader->getNodeType() );
+    EXPECT_STREQ( "root", reader->getNodeName() );
+    EXPECT_FALSE( reader->isEmptyElement() );
+    ASSERT_EQ( 2, reader->getAttributeCount() );
+    EXPECT_STREQ( "a", reader->getAttributeName( 0 ) );
+    EXPECT_STREQ( "1 & 2", reader->getAttributeValue( "a" ) );
+    EXPECT_STREQ( "<x>", reader->getAttributeValue( "b" ) );
+    EXPECT_EQ( nullptr, reader->getAttributeValue( "c" ) );
+    const char* rootName = reader->getNodeName();
+    const char* value = reader->getAttributeValue( "a" );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_COMMENT, reader->getNodeType() );
+    EXPECT_STREQ( " a comment ", reader->getNodeData() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT, reader->getNodeType() );
+    EXPECT_STREQ( "item", reader->getNodeName() );
+    EXPECT_TRUE( reader->isEmptyElement() );
+    EXPECT_STREQ( "first", reader->getAttributeValueSafe( "name" ) );
+    EXPECT_STREQ( "", reader->getAttributeValueSafe( "other" ) );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT, reader->getNodeType() );
+    EXPECT_STREQ( "text", reader->getNodeName() );
+    EXPECT_EQ( 0, reader->getAttributeCount() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_TEXT, reader->getNodeType() );
+    EXPECT_STREQ( "x < y \"z\" &unknown; end", reader->getNodeData() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT_END, reader->getNodeType() );
+    EXPECT_STREQ( "text", reader->getNodeName() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_CDATA, reader->getNodeType() );
+    EXPECT_STREQ( "raw <data>", reader->getNodeData() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT_END, reader->getNodeType() );
+    EXPECT_STREQ( "root", reader->getNodeName() );
+    EXPECT_FALSE( Next( reader.get() ) );
+
+    // names and values stay valid as long as the reader
+    EXPECT_STREQ( "root", rootName );
+    EXPECT_STREQ( "1 & 2", value );
+}
+
+TEST_F( utIrrXMLWrapper, nullCharacterTest ) {
+    const char xml[] = "<root  >\0<x/>\0</root>";
+
+    std::unique_ptr<IOStream> stream;
+    std::unique_ptr<IrrXMLReader> reader( CreateReader( xml, sizeof( xml ) - 1, stream ) );
+    ASSERT_NE( nullptr, reader.get() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_STREQ( "root", reader->getNodeName() );
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_STREQ( "x", reader->getNodeName() );
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT_END, reader->getNodeType() );
+    EXPECT_FALSE( Next( reader.get() ) );
+}
+
+TEST_F( utIrrXMLWrapper, utf16Test ) {
+    const char ascii[] = "<a b=\"c\">d</a>";
+    std::vector<char> xml;
+    xml.push_back( '\xff' );
+    xml.push_back( '\xfe' );
+    for ( size_t i = 0; i + 1 < sizeof( ascii ); ++i ) {
+        xml.push_back( ascii[ i ] );
+        xml.push_back( '\0' );
+    }
+
+    std::unique_ptr<IOStream> stream;
+    std::unique_ptr<IrrXMLReader> reader( CreateReader( &xml[ 0 ], xml.size(), stream ) );
+    ASSERT_NE( nullptr, reader.get() );
+
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_STREQ( "a", reader->getNodeName() );
+    EXPECT_STREQ( "c", reader->getAttributeValue( "b" ) );
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_STREQ( "d", reader->getNodeData() );
+    ASSERT_TRUE( Next( reader.get() ) );
+    EXPECT_EQ( EXN_ELEMENT_END, reader->getNodeType() );
+}
@@ -141,3 +141,21 @@ TEST_F(JoinVerticesTest, testProcess)
     EXPECT_EQ(150.f*299.f*3.f, fSum); // gaussian sum equation
 }
 
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(JoinVerticesTest, testProcessWithSpatialGrid)
+{
+    piProcess->SetUseSpatialGrid(true);
+    piProcess->ProcessMesh(pcMesh,0);
+
+    ASSERT_EQ(300U, pcMesh->mNumFaces);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    float fSum = 0.f;
+    for (unsigned int i = 0; i < 300;++i)
+    {
+        aiVector3D& v = pcMesh->mVertices[i];
+        fSum += v.x + v.y + v.z;
+    }
+    EXPECT_EQ(150.f*299.f*3.f, fSum); // gaussian sum equation
+}
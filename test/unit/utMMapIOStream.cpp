@@ -0,0 +1,98 @@
+/*-------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+-------------------------------------------------------------------------*/
+#include "UnitTestPCH.h"
+#include "ImportCompare.h"
+
+#include "MMapIOStream.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <memory>
+#include <vector>
+
+using namespace ::Assimp;
+
+class utMMapIOStream : public ::testing::Test {
+protected:
+    // Import a file with and without memory mapped files, the results must match
+    static void compareImports( const char *file ) {
+        Importer mapped;
+        mapped.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, true );
+        EXPECT_TRUE( NULL != CheckSameImport( mapped, file, aiProcess_ValidateDataStructure ) );
+    }
+};
+
+TEST_F( utMMapIOStream, openMissingFileTest ) {
+    std::unique_ptr<MMapIOStream> stream( MMapIOStream::Open( ASSIMP_TEST_MODELS_DIR "/STL/does_not_exist.stl" ) );
+    EXPECT_TRUE( NULL == stream.get() );
+}
+
+TEST_F( utMMapIOStream, readSeekTest ) {
+    std::unique_ptr<MMapIOStream> stream( MMapIOStream::Open( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl" ) );
+    ASSERT_TRUE( NULL != stream.get() );
+    ASSERT_TRUE( NULL != stream->GetMappedData() );
+
+    const size_t size = stream->FileSize();
+    ASSERT_LT( 84U, size );
+
+    // reads copy out of the mapping
+    std::vector<char> header( 80 );
+    EXPECT_EQ( 1U, stream->Read( &header[ 0 ], header.size(), 1 ) );
+    EXPECT_EQ( 0, memcmp( &header[ 0 ], stream->GetMappedData(), header.size() ) );
+    EXPECT_EQ( 80U, stream->Tell() );
+
+    EXPECT_EQ( aiReturn_SUCCESS, stream->Seek( 4, aiOrigin_CUR ) );
+    EXPECT_EQ( 84U, stream->Tell() );
+    EXPECT_EQ( aiReturn_SUCCESS, stream->Seek( 0, aiOrigin_END ) );
+    EXPECT_EQ( size, stream->Tell() );
+    EXPECT_EQ( 0U, stream->Read( &header[ 0 ], 1, 1 ) );
+    EXPECT_EQ( aiReturn_FAILURE, stream->Seek( size + 1, aiOrigin_SET ) );
+    EXPECT_EQ( size, stream->Tell() );
+
+    // the stream is read-only
+    EXPECT_EQ( 0U, stream->Write( &header[ 0 ], 1, 1 ) );
+}
+
+TEST_F( utMMapIOStream, importBinaryFilesTest ) {
+    compareImports( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl" );
+    compareImports( ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl" );
+    compareImports( ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx" );
+    compareImports( ASSIMP_TEST_MODELS_DIR "/MD2/faerie.md2" );
+    compareImports( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Binary/BoxTextured.glb" );
+}
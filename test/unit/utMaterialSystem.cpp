@@ -127,3 +127,63 @@ TEST_F(MaterialSystemTest, testStringProperty)
     EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey6",0,0,s));
     EXPECT_STREQ("Hello, this is a small test", s.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testManyProperties)
+{
+    // enough properties to resize the property array and the lookup table several times
+    for (int i = 0; i < 200; ++i) {
+        this->pcMat->AddProperty(&i,1,"testKey7",i % 4,i / 4);
+    }
+    EXPECT_EQ(200U, pcMat->mNumProperties);
+
+    // replacing keeps the number of properties
+    int pf = -1;
+    this->pcMat->AddProperty(&pf,1,"testKey7",1,5);
+    EXPECT_EQ(200U, pcMat->mNumProperties);
+
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey7",i % 4,i / 4,pf));
+        EXPECT_EQ(i == 21 ? -1 : i, pf);
+    }
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey7",4,0,pf));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey8",0,0,pf));
+
+    // wildcards still find the first matching property
+    const aiMaterialProperty* prop = NULL;
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialProperty(pcMat,"testKey7",UINT_MAX,3,&prop));
+    ASSERT_TRUE(NULL != prop);
+    EXPECT_EQ(0U, prop->mSemantic);
+    EXPECT_EQ(3U, prop->mIndex);
+
+    // properties behind a removed one are still found
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty("testKey7",0,0));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey7",0,0,pf));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey7",3,49,pf));
+    EXPECT_EQ(199, pf);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testDirectlyModifiedProperties)
+{
+    int pf = 1;
+    this->pcMat->AddProperty(&pf,1,"testKey9");
+    pf = 2;
+    this->pcMat->AddProperty(&pf,1,"testKey10");
+
+    // remove the first property without the aiMaterial API, as some loaders do
+    delete pcMat->mProperties[0];
+    pcMat->mProperties[0] = pcMat->mProperties[1];
+    pcMat->mNumProperties--;
+
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("testKey9",0,0,pf));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey10",0,0,pf));
+    EXPECT_EQ(2, pf);
+
+    // adding a property brings the lookup table up to date again
+    pf = 3;
+    this->pcMat->AddProperty(&pf,1,"testKey9");
+    EXPECT_EQ(2U, pcMat->mNumProperties);
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("testKey9",0,0,pf));
+    EXPECT_EQ(3, pf);
+}
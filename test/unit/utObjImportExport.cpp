@@ -252,3 +252,28 @@ TEST_F( utObjImportExport, issue809_vertex_color_Test ) {
     EXPECT_EQ( aiReturn_SUCCESS, exporter.Export( scene, "obj", ASSIMP_TEST_MODELS_DIR "/OBJ/test.obj" ) );
 #endif // ASSIMP_BUILD_NO_EXPORT
 }
+
+TEST_F( utObjImportExport, parallel_vertex_parsing_Test ) {
+    static const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/cube_with_vertexcolors.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/WusonOBJ.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/number_formats.obj",
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box_without_lineending.obj"
+    };
+    for ( size_t i = 0; i < sizeof( files ) / sizeof( files[ 0 ] ); ++i ) {
+        ::Assimp::Importer serial;
+        const aiScene *expected = serial.ReadFile( files[ i ], 0 );
+        ASSERT_NE( nullptr, expected );
+
+        ::Assimp::Importer parallel;
+        parallel.SetPropertyInteger( AI_CONFIG_IMPORT_OBJ_NUM_THREADS, 4 );
+        parallel.SetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, 4 );
+        const aiScene *scene = parallel.ReadFile( files[ i ], 0 );
+        ASSERT_NE( nullptr, scene );
+
+        SceneDiffer differ;
+        EXPECT_TRUE( differ.isEqual( expected, scene ) );
+        differ.showReport();
+    }
+}
@@ -40,8 +40,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 
+#include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 #include "AbstractImportExportBase.h"
+#include "ImportCompare.h"
+#include <fstream>
 
 using namespace ::Assimp;
 
@@ -61,4 +65,125 @@ TEST_F( utPLYImportExport, importTest ) {
 TEST_F( utPLYImportExport, vertexColorTest ) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PLY/float-color.ply", 0 );
-}
\ No newline at end of file
+}
+TEST_F( utPLYImportExport, binaryTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PLY/Wuson.ply", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    TemporaryFile asciiFile( "wuson_ascii.ply" ), binaryFile( "wuson_binary.ply" );
+    Assimp::Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "ply", asciiFile.c_str() ) );
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "plyb", binaryFile.c_str() ) );
+
+    // the binary file is read without building the DOM
+    Assimp::Importer ascii, binary;
+    const aiScene *expected = ascii.ReadFile( asciiFile.Path(), 0 );
+    const aiScene *actual = binary.ReadFile( binaryFile.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( expected, actual );
+}
+
+TEST_F( utPLYImportExport, bigEndianTest ) {
+    static const char header[] =
+        "element vertex 4\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "property uchar red\n"
+        "property uchar green\n"
+        "property uchar blue\n"
+        "element face 2\n"
+        "property uchar flags\n"
+        "property list uchar int vertex_indices\n"
+        "end_header\n";
+    static const float positions[ 4 ][ 3 ] = { { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 1.f, 1.f, 0.f }, { 0.f, 1.5f, -2.f } };
+    static const unsigned char colors[ 4 ][ 3 ] = { { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 }, { 51, 102, 153 } };
+    static const int faces[ 2 ][ 4 ] = { { 0, 1, 2, -1 }, { 0, 2, 3, 1 } };
+    static const unsigned char numIndices[ 2 ] = { 3, 4 };
+
+    TemporaryFile asciiFile( "bigendian_ascii.ply" ), binaryFile( "bigendian_binary.ply" );
+    std::ofstream ascii( asciiFile.c_str() );
+    ascii << "ply\nformat ascii 1.0\n" << header;
+    for ( unsigned int i = 0; i < 4; ++i ) {
+        ascii << positions[ i ][ 0 ] << ' ' << positions[ i ][ 1 ] << ' ' << positions[ i ][ 2 ] << ' '
+            << int( colors[ i ][ 0 ] ) << ' ' << int( colors[ i ][ 1 ] ) << ' ' << int( colors[ i ][ 2 ] ) << '\n';
+    }
+    for ( unsigned int i = 0; i < 2; ++i ) {
+        ascii << "7 " << int( numIndices[ i ] );
+        for ( unsigned int n = 0; n < numIndices[ i ]; ++n ) {
+            ascii << ' ' << faces[ i ][ n ];
+        }
+        ascii << '\n';
+    }
+    ascii.close();
+
+    std::ofstream binary( binaryFile.c_str(), std::ios::binary );
+    binary << "ply\nformat binary_big_endian 1.0\n" << header;
+    for ( unsigned int i = 0; i < 4; ++i ) {
+        for ( unsigned int c = 0; c < 3; ++c ) {
+            uint32_t v;
+            ::memcpy( &v, &positions[ i ][ c ], 4 );
+            const char bytes[ 4 ] = { char( v >> 24 ), char( v >> 16 ), char( v >> 8 ), char( v ) };
+            binary.write( bytes, 4 );
+        }
+        binary.write( reinterpret_cast<const char*>( colors[ i ] ), 3 );
+    }
+    for ( unsigned int i = 0; i < 2; ++i ) {
+        const char flags = 7;
+        binary.write( &flags, 1 );
+        binary.write( reinterpret_cast<const char*>( &numIndices[ i ] ), 1 );
+        for ( unsigned int n = 0; n < numIndices[ i ]; ++n ) {
+            const uint32_t v = faces[ i ][ n ];
+            const char bytes[ 4 ] = { char( v >> 24 ), char( v >> 16 ), char( v >> 8 ), char( v ) };
+            binary.write( bytes, 4 );
+        }
+    }
+    binary.close();
+
+    Assimp::Importer asciiImporter, binaryImporter;
+    const aiScene *expected = asciiImporter.ReadFile( asciiFile.Path(), 0 );
+    const aiScene *actual = binaryImporter.ReadFile( binaryFile.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( expected, actual );
+    EXPECT_EQ( aiColor4D( 0.2f, 0.4f, 0.6f, 1.f ), actual->mMeshes[ 0 ]->mColors[ 0 ][ 5 ] );
+}
+
+TEST_F( utPLYImportExport, mappedASCIITest ) {
+    // only the format line decides whether the file can be parsed in place
+    TemporaryFile file( "binary_comment.ply" );
+    std::ofstream out( file.c_str(), std::ios::binary );
+    out << "ply\nformat ascii 1.0\ncomment converted from binary_little_endian\n"
+        << "element vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+        << "element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+        << "0 0 0\n1 0 0\n1 1 0\n";
+
+    // the file ends exactly at a page boundary, without a zero behind the data
+    out << std::string( 4096 - 7 - static_cast<size_t>( out.tellp() ), ' ' ) << "3 0 1 2";
+    out.close();
+
+    Assimp::Importer mapped;
+    mapped.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, true );
+    const aiScene *scene = CheckSameImport( mapped, file.Path() );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( 1U, scene->mMeshes[ 0 ]->mNumFaces );
+}
+
+TEST_F( utPLYImportExport, pointCloudTest ) {
+    // without faces, each three vertices form a triangle
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PLY/pond.0.ply", 0 );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 1U, scene->mNumMeshes );
+
+    const aiMesh* mesh = scene->mMeshes[ 0 ];
+    EXPECT_EQ( 70050U, mesh->mNumVertices );
+    EXPECT_TRUE( mesh->HasNormals() );
+    ASSERT_EQ( 23350U, mesh->mNumFaces );
+    for ( unsigned int f = 0; f < mesh->mNumFaces; ++f ) {
+        ASSERT_EQ( 3U, mesh->mFaces[ f ].mNumIndices );
+        EXPECT_EQ( f * 3 + 2, mesh->mFaces[ f ].mIndices[ 2 ] );
+    }
+}
@@ -0,0 +1,116 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ParsingUtils.h"
+
+using namespace Assimp;
+
+class utParsingUtils : public ::testing::Test {
+    // empty
+};
+
+TEST_F( utParsingUtils, readRealArrayTest ) {
+    const char* text = " 1.5\t-2\r\n3e1\n\n.25 8";
+    float values[ 4 ];
+    EXPECT_EQ( 4U, ReadRealArray( text, values, 4 ) );
+    EXPECT_EQ( 1.5f, values[ 0 ] );
+    EXPECT_EQ( -2.f, values[ 1 ] );
+    EXPECT_EQ( 30.f, values[ 2 ] );
+    EXPECT_EQ( 0.25f, values[ 3 ] );
+    EXPECT_STREQ( " 8", text );
+
+    // the end of the text stops reading
+    double rest[ 3 ] = { 0.0, 0.0, 0.0 };
+    EXPECT_EQ( 1U, ReadRealArray( text, rest, 3 ) );
+    EXPECT_EQ( 8.0, rest[ 0 ] );
+    EXPECT_STREQ( "", text );
+
+    const char* invalid = "1 x";
+    EXPECT_THROW( ReadRealArray( invalid, values, 2 ), std::invalid_argument );
+}
+
+TEST_F( utParsingUtils, readLineTest ) {
+    const char* text = "1 2\n3 4";
+    float values[ 3 ] = { 0.f, 0.f, 0.f };
+    EXPECT_EQ( 2U, ReadRealArray( text, values, 3, true ) );
+    EXPECT_EQ( 2.f, values[ 1 ] );
+    EXPECT_EQ( 0.f, values[ 2 ] );
+    EXPECT_EQ( '\n', *text );
+
+    // commas are decimal separators unless told otherwise
+    const char* comma = "1,5 2,5";
+    EXPECT_EQ( 2U, ReadRealArray( comma, values, 3 ) );
+    EXPECT_EQ( 2.5f, values[ 1 ] );
+    comma = "1,5";
+    EXPECT_EQ( 1U, ReadRealArray( comma, values, 1, false, false ) );
+    EXPECT_EQ( 1.f, values[ 0 ] );
+    EXPECT_STREQ( ",5", comma );
+    EXPECT_THROW( ReadRealArray( comma, values, 1, false, false ), std::invalid_argument );
+}
+
+TEST_F( utParsingUtils, readNumberListTest ) {
+    const char* text = "  3 -1 42\n7  ";
+    std::vector<int> values;
+    ReadNumberList( text, values, []( const char* c, int& value ) {
+        value = strtol10( c, &c );
+        return c;
+    } );
+    ASSERT_EQ( 4U, values.size() );
+    EXPECT_EQ( -1, values[ 1 ] );
+    EXPECT_EQ( 7, values[ 3 ] );
+
+    // a parser that doesn't move ends the list
+    const char* garbage = "1 2 abc 3";
+    values.clear();
+    ReadNumberList( garbage, values, []( const char* c, int& value ) {
+        value = int( strtoul10( c, &c ) );
+        return c;
+    } );
+    EXPECT_EQ( 2U, values.size() );
+    EXPECT_STREQ( "abc 3", garbage );
+
+    std::vector<float> reals;
+    const char* list = "0.5 .5\t-.5\n";
+    ReadRealList( list, reals, false );
+    ASSERT_EQ( 3U, reals.size() );
+    EXPECT_EQ( -0.5f, reals[ 2 ] );
+}
@@ -0,0 +1,237 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2017, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include "AbstractImportExportBase.h"
+#include "ImportCompare.h"
+#include <fstream>
+
+using namespace ::Assimp;
+
+namespace {
+    // Welding must keep the position of each face corner
+    void CheckWelded( const aiScene* pExpected, const aiScene* pActual ) {
+        ASSERT_EQ( 1U, pActual->mNumMeshes );
+        const aiMesh* a = pExpected->mMeshes[ 0 ];
+        const aiMesh* b = pActual->mMeshes[ 0 ];
+        EXPECT_LT( b->mNumVertices, a->mNumVertices );
+        EXPECT_FALSE( b->HasNormals() );
+        ASSERT_EQ( a->HasVertexColors( 0 ), b->HasVertexColors( 0 ) );
+        ASSERT_EQ( a->mNumFaces, b->mNumFaces );
+        for ( unsigned int f = 0; f < b->mNumFaces; ++f ) {
+            ASSERT_EQ( 3U, b->mFaces[ f ].mNumIndices );
+            for ( unsigned int n = 0; n < 3; ++n ) {
+                const unsigned int ia = a->mFaces[ f ].mIndices[ n ], ib = b->mFaces[ f ].mIndices[ n ];
+                ASSERT_LT( ib, b->mNumVertices );
+                EXPECT_EQ( a->mVertices[ ia ], b->mVertices[ ib ] );
+                if ( b->HasVertexColors( 0 ) ) {
+                    EXPECT_EQ( a->mColors[ 0 ][ ia ], b->mColors[ 0 ][ ib ] );
+                }
+            }
+        }
+    }
+
+    // Writes a binary STL with a triangulated grid, spanning several decode
+    // blocks. Every third row of facets carries a color, if requested.
+    void WriteGrid( const char* pFile, unsigned int pSize, bool pColored = true ) {
+        std::ofstream out( pFile, std::ios::binary );
+        const char header[ 80 ] = "binary grid";
+        out.write( header, 80 );
+        const uint32_t numFacets = pSize * pSize * 2;
+        out.write( reinterpret_cast<const char*>( &numFacets ), 4 );
+        for ( unsigned int y = 0; y < pSize; ++y ) {
+            for ( unsigned int x = 0; x < pSize; ++x ) {
+                const float fx = float( x ), fy = float( y );
+                const float tris[ 2 ][ 12 ] = {
+                    { 0.f, 0.f, 1.f, fx, fy, 0.f, fx + 1.f, fy, 0.f, fx + 1.f, fy + 1.f, 0.f },
+                    { 0.f, 0.f, 1.f, fx, fy, 0.f, fx + 1.f, fy + 1.f, 0.f, fx, fy + 1.f, 0.f }
+                };
+                const uint16_t color = ( !pColored || y % 3 ) ? 0 : uint16_t( 0x8000 | ( x & 0x7fff ) );
+                for ( unsigned int t = 0; t < 2; ++t ) {
+                    out.write( reinterpret_cast<const char*>( tris[ t ] ), sizeof( tris[ t ] ) );
+                    out.write( reinterpret_cast<const char*>( &color ), 2 );
+                }
+            }
+        }
+    }
+
+    // Writes the same grid as ASCII STL with CRLF line ends. Some facets have
+    // their numbers spread over several lines, the last line has no line end.
+    void WriteASCIIGrid( const char* pFile, unsigned int pSize ) {
+        std::ofstream out( pFile, std::ios::binary );
+        out << "solid grid\r\n";
+        for ( unsigned int y = 0; y < pSize; ++y ) {
+            for ( unsigned int x = 0; x < pSize; ++x ) {
+                const unsigned int corners[ 2 ][ 6 ] = {
+                    { x, y, x + 1, y, x + 1, y + 1 },
+                    { x, y, x + 1, y + 1, x, y + 1 }
+                };
+                const char* sep = ( x % 7 ) ? " " : "\r\n  ";
+                for ( unsigned int t = 0; t < 2; ++t ) {
+                    out << "  facet normal 0 0" << sep << "1\r\n    outer loop\r\n";
+                    for ( unsigned int c = 0; c < 3; ++c ) {
+                        out << "      vertex " << corners[ t ][ c * 2 ] << sep << corners[ t ][ c * 2 + 1 ] << " 0\r\n";
+                    }
+                    out << "    endloop\r\n  endfacet\r\n";
+                }
+            }
+        }
+        out << "endsolid grid";
+    }
+}
+
+class utSTLImportExport : public AbstractImportExportBase {
+public:
+    virtual bool importerTest() {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0 );
+        return nullptr != scene;
+    }
+};
+
+TEST_F( utSTLImportExport, importTest ) {
+    EXPECT_TRUE( importerTest() );
+}
+
+TEST_F( utSTLImportExport, parallelBinaryTest ) {
+    TemporaryFile grid( "stl_grid.stl" );
+    WriteGrid( grid.c_str(), 150 );
+
+    Assimp::Importer serial, parallel;
+    parallel.SetPropertyInteger( AI_CONFIG_IMPORT_STL_NUM_THREADS, 0 );
+    const aiScene *expected = serial.ReadFile( grid.Path(), 0 );
+    const aiScene *actual = parallel.ReadFile( grid.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, actual );
+    ASSERT_EQ( 45000U, actual->mMeshes[ 0 ]->mNumFaces );
+    ASSERT_TRUE( actual->mMeshes[ 0 ]->HasVertexColors( 0 ) );
+    CheckSameMeshes( expected, actual );
+}
+
+TEST_F( utSTLImportExport, weldVerticesTest ) {
+    TemporaryFile grid( "stl_grid.stl" );
+    WriteGrid( grid.c_str(), 150 );
+    const char* files[] = {
+        grid.c_str(),
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl"
+    };
+    for ( unsigned int i = 0; i < sizeof( files ) / sizeof( files[ 0 ] ); ++i ) {
+        Assimp::Importer plain;
+        const aiScene *expected = plain.ReadFile( files[ i ], 0 );
+        ASSERT_NE( nullptr, expected );
+
+        // welding combines with the scene arena and the face index pool
+        for ( unsigned int options = 0; options < 4; ++options ) {
+            Assimp::Importer welded;
+            welded.SetPropertyBool( AI_CONFIG_IMPORT_STL_WELD_VERTICES, true );
+            welded.SetPropertyInteger( AI_CONFIG_IMPORT_STL_NUM_THREADS, 0 );
+            welded.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, ( options & 1 ) != 0 );
+            welded.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, ( options & 2 ) != 0 );
+            const aiScene *actual = welded.ReadFile( files[ i ], 0 );
+            ASSERT_NE( nullptr, actual );
+            CheckWelded( expected, actual );
+        }
+    }
+
+    // vertex normals for welded meshes come from post-processing
+    Assimp::Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_IMPORT_STL_WELD_VERTICES, true );
+    const aiScene *scene = importer.ReadFile( grid.Path(), aiProcess_GenNormals );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_TRUE( scene->mMeshes[ 0 ]->HasNormals() );
+}
+
+TEST_F( utSTLImportExport, asciiStreamTest ) {
+    TemporaryFile grid( "stl_grid.stl" ), asciiGrid( "stl_grid_ascii.stl" );
+    WriteGrid( grid.c_str(), 150, false );
+    WriteASCIIGrid( asciiGrid.c_str(), 150 );
+
+    // the ASCII file is several times larger than the stream cache
+    Assimp::Importer binary, ascii;
+    const aiScene *expected = binary.ReadFile( grid.Path(), 0 );
+    const aiScene *actual = ascii.ReadFile( asciiGrid.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, actual );
+    EXPECT_STREQ( "grid", actual->mRootNode->mName.C_Str() );
+    CheckSameMeshes( expected, actual );
+}
+
+TEST_F( utSTLImportExport, asciiSolidsTest ) {
+    static const char* solid =
+        "solid %s\n"
+        "facet normal 0 0 1\n"
+        "outer loop\n"
+        "vertex 0 0 %d\n"
+        "vertex 1 0 %d\n"
+        "vertex 1 1 %d\n"
+        "endloop\n"
+        "endfacet\n"
+        "endsolid %s\n";
+    TemporaryFile file( "stl_solids.stl" );
+    {
+        std::ofstream out( file.c_str(), std::ios::binary );
+        out << "\xEF\xBB\xBF";
+        for ( int i = 0; i < 3; ++i ) {
+            char text[ 256 ];
+            // keywords within a name don't count
+            const std::string name = ( i == 1 ? "x_endsolid" : "part" ) + std::to_string( i );
+            ::snprintf( text, sizeof( text ), solid, name.c_str(), i, i, i, name.c_str() );
+            out << text;
+        }
+    }
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( 3U, scene->mNumMeshes );
+    for ( unsigned int i = 0; i < 3; ++i ) {
+        const aiMesh* mesh = scene->mMeshes[ i ];
+        ASSERT_EQ( 1U, mesh->mNumFaces );
+        ASSERT_EQ( 3U, mesh->mNumVertices );
+        EXPECT_EQ( aiVector3D( 1.f, 1.f, ai_real( i ) ), mesh->mVertices[ 2 ] );
+        EXPECT_EQ( aiVector3D( 0.f, 0.f, 1.f ), mesh->mNormals[ 2 ] );
+    }
+    EXPECT_STREQ( "part2", scene->mRootNode->mName.C_Str() );
+}
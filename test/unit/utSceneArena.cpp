@@ -0,0 +1,199 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "ImportCompare.h"
+#include "SceneArena.h"
+#include "SceneCombiner.h"
+#include "ScenePrivate.h"
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utSceneArena : public ::testing::Test {
+protected:
+    // Imports a file with and without arena and compares the results
+    static void CheckArenaImport( const char* pFile, unsigned int pFlags, bool pPooled ) {
+        Importer arena;
+        arena.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+        arena.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, pPooled );
+        const aiScene* actual = CheckSameImport( arena, pFile, pFlags );
+        ASSERT_NE( nullptr, actual );
+
+        // post-processing moves everything back to the heap
+        SceneArena* sceneArena = ScenePriv( actual )->mArena;
+        if ( pFlags ) {
+            EXPECT_EQ( nullptr, sceneArena );
+        } else {
+            ASSERT_NE( nullptr, sceneArena );
+            EXPECT_TRUE( sceneArena->Owns( actual->mMeshes[ 0 ]->mVertices ) );
+            EXPECT_TRUE( sceneArena->Owns( actual->mMeshes[ 0 ]->mFaces ) );
+
+            // the scene is released without looking at its faces, so none
+            // of them may reference indices on the heap
+            const aiMesh* mesh = actual->mMeshes[ 0 ];
+            for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+                ASSERT_TRUE( sceneArena->Owns( mesh->mFaces[ i ].mIndices ) ) << i;
+            }
+        }
+    }
+};
+
+TEST_F( utSceneArena, allocateTest ) {
+    SceneArena arena( 1024 );
+    EXPECT_EQ( 0U, arena.GetReservedMemory() );
+
+    char* a = static_cast<char*>( arena.Allocate( 3, 1 ) );
+    double* b = static_cast<double*>( arena.Allocate( sizeof( double ), alignof( double ) ) );
+    EXPECT_EQ( 0U, reinterpret_cast<size_t>( b ) % alignof( double ) );
+    EXPECT_TRUE( arena.Owns( a ) );
+    EXPECT_TRUE( arena.Owns( b ) );
+
+    int local = 0;
+    EXPECT_FALSE( arena.Owns( &local ) );
+
+    // large blocks get a chunk of their own and don't disturb the current one
+    char* large = static_cast<char*>( arena.Allocate( 100000, 16 ) );
+    EXPECT_TRUE( arena.Owns( large ) );
+    EXPECT_TRUE( arena.Owns( large + 99999 ) );
+    char* c = static_cast<char*>( arena.Allocate( 1, 1 ) );
+    EXPECT_TRUE( arena.Owns( c ) );
+    EXPECT_GE( arena.GetReservedMemory(), 101024U );
+
+    aiVector3D* v = arena.AllocateArray<aiVector3D>( 5000 );
+    for ( unsigned int i = 0; i < 5000; ++i ) {
+        EXPECT_EQ( aiVector3D(), v[ i ] );
+    }
+}
+
+TEST_F( utSceneArena, importTest ) {
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", 0, false );
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0, false );
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0, true );
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", 0, false );
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", 0, true );
+}
+
+TEST_F( utSceneArena, postProcessTest ) {
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType;
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", flags, false );
+    CheckArenaImport( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", flags, true );
+
+    // post-processing an arena scene later on works as well
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+    ASSERT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply", 0 ) );
+    const aiScene* scene = importer.ApplyPostProcessing( flags );
+    ASSERT_NE( nullptr, scene );
+    EXPECT_EQ( nullptr, ScenePriv( scene )->mArena );
+}
+
+TEST_F( utSceneArena, copySceneTest ) {
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    aiScene* copy = NULL;
+    SceneCombiner::CopyScene( &copy, scene );
+    ASSERT_NE( nullptr, copy );
+    EXPECT_FALSE( ScenePriv( scene )->mArena->Owns( copy->mMeshes[ 0 ]->mVertices ) );
+    CheckSameMeshes( scene, copy );
+    delete copy;
+}
+
+TEST_F( utSceneArena, assbinTest ) {
+    Importer importer;
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    TemporaryFile file( "spider_arena.assbin" );
+    Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", file.c_str() ) );
+
+    Importer arena;
+    arena.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+    const aiScene* actual = arena.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, actual );
+    SceneArena* sceneArena = ScenePriv( actual )->mArena;
+    ASSERT_NE( nullptr, sceneArena );
+    for ( unsigned int i = 0; i < actual->mMeshes[ 0 ]->mNumFaces; ++i ) {
+        ASSERT_TRUE( sceneArena->Owns( actual->mMeshes[ 0 ]->mFaces[ i ].mIndices ) ) << i;
+    }
+    CheckSameMeshes( scene, actual );
+}
+
+TEST_F( utSceneArena, assbinInPlaceTest ) {
+    Importer importer;
+    const aiScene* scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0 );
+    ASSERT_NE( nullptr, scene );
+
+    TemporaryFile file( "spider_inplace.assbin" );
+    Exporter exporter;
+    ASSERT_EQ( AI_SUCCESS, exporter.Export( scene, "assbin", file.c_str() ) );
+
+    Importer plain, mapped;
+    plain.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+    mapped.SetPropertyBool( AI_CONFIG_GLOB_SCENE_ARENA, true );
+    mapped.SetPropertyBool( AI_CONFIG_GLOB_MEMORY_MAPPED_IO, true );
+    const aiScene* expected = plain.ReadFile( file.Path(), 0 );
+    const aiScene* actual = mapped.ReadFile( file.Path(), 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_NE( nullptr, actual );
+
+    // the arrays of the mapped file are used in place, but owned by the arena
+    SceneArena* arena = ScenePriv( actual )->mArena;
+    ASSERT_NE( nullptr, arena );
+    EXPECT_TRUE( arena->Owns( actual->mMeshes[ 0 ]->mVertices ) );
+    for ( unsigned int i = 0; i < actual->mMeshes[ 0 ]->mNumFaces; ++i ) {
+        ASSERT_TRUE( arena->Owns( actual->mMeshes[ 0 ]->mFaces[ i ].mIndices ) ) << i;
+    }
+    EXPECT_EQ( 0U, reinterpret_cast<size_t>( actual->mMeshes[ 0 ]->mVertices ) % 16 );
+    EXPECT_LE( arena->GetReservedMemory(), ScenePriv( expected )->mArena->GetReservedMemory() );
+    CheckSameMeshes( scene, actual );
+
+    // and copied to the heap for post-processing
+    ASSERT_NE( nullptr, mapped.ApplyPostProcessing( aiProcess_JoinIdenticalVertices ) );
+    EXPECT_EQ( nullptr, ScenePriv( actual )->mArena );
+}
@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <SpatialGrid.h>
+#include <SpatialSort.h>
+#include <algorithm>
+
+using namespace std;
+using namespace Assimp;
+
+class SpatialGridTest : public ::testing::Test
+{
+public:
+    virtual void SetUp();
+
+protected:
+    // checks that both classes return the same indices for all positions
+    void compareWithSpatialSort( const vector<aiVector3D>& positions, ai_real radius );
+
+    // positions on a plane orthogonal to the sorting plane of SpatialSort
+    vector<aiVector3D> planarPositions;
+    // random positions, some duplicated
+    vector<aiVector3D> randomPositions;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGridTest::SetUp()
+{
+    // two vectors perpendicular to SpatialSort's reference plane normal
+    aiVector3D normal( 0.8523f, 0.34321f, 0.5736f);
+    normal.Normalize();
+    aiVector3D u = normal ^ aiVector3D( 0.f, 0.f, 1.f);
+    u.Normalize();
+    const aiVector3D v = normal ^ u;
+
+    for (unsigned int y = 0; y < 100; ++y) {
+        for (unsigned int x = 0; x < 100; ++x) {
+            planarPositions.push_back( u * (ai_real)x + v * (ai_real)y );
+        }
+    }
+
+    srand( 42 );
+    for (unsigned int i = 0; i < 5000; ++i) {
+        randomPositions.push_back( aiVector3D( (ai_real)(rand() % 1000), (ai_real)(rand() % 1000), (ai_real)(rand() % 1000) ) * (ai_real)0.01 );
+    }
+    for (unsigned int i = 0; i < 1000; ++i) {
+        randomPositions.push_back( randomPositions[ rand() % 5000 ] );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGridTest::compareWithSpatialSort( const vector<aiVector3D>& positions, ai_real radius )
+{
+    const unsigned int num = (unsigned int)positions.size();
+    SpatialSort sort( &positions[0], num, sizeof( aiVector3D ) );
+    SpatialGrid grid( &positions[0], num, sizeof( aiVector3D ) );
+
+    vector<unsigned int> expected, found;
+    for (unsigned int i = 0; i < num; ++i) {
+        sort.FindPositions( positions[i], radius, expected );
+        grid.FindPositions( positions[i], radius, found );
+        std::sort( expected.begin(), expected.end() );
+        std::sort( found.begin(), found.end() );
+        ASSERT_EQ( expected, found );
+
+        sort.FindIdenticalPositions( positions[i], expected );
+        grid.FindIdenticalPositions( positions[i], found );
+        std::sort( expected.begin(), expected.end() );
+        std::sort( found.begin(), found.end() );
+        ASSERT_EQ( expected, found );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialGridTest, testFindPositions)
+{
+    compareWithSpatialSort( randomPositions, (ai_real)0.05 );
+    // SpatialSort is slow on the full plane, a part of it is enough
+    compareWithSpatialSort( vector<aiVector3D>( planarPositions.begin(), planarPositions.begin() + 2000 ), (ai_real)1.5 );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialGridTest, testLargeRadius)
+{
+    SpatialGrid grid( &randomPositions[0], (unsigned int)randomPositions.size(), sizeof( aiVector3D ) );
+
+    vector<unsigned int> found;
+    grid.FindPositions( aiVector3D( 5.f ), 100.f, found );
+    EXPECT_EQ( randomPositions.size(), found.size() );
+
+    grid.FindPositions( aiVector3D( -100.f ), 1.f, found );
+    EXPECT_TRUE( found.empty() );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialGridTest, testGenerateMappingTable)
+{
+    SpatialGrid grid( &randomPositions[0], (unsigned int)randomPositions.size(), sizeof( aiVector3D ) );
+
+    vector<unsigned int> fill;
+    const unsigned int num = grid.GenerateMappingTable( fill, (ai_real)1e-5 );
+    ASSERT_EQ( randomPositions.size(), fill.size() );
+
+    // duplicates share their output ID
+    for (size_t i = 0; i < fill.size(); ++i) {
+        ASSERT_LT( fill[i], num );
+        for (size_t j = 0; j < i; ++j) {
+            if (randomPositions[i] == randomPositions[j]) {
+                ASSERT_EQ( fill[i], fill[j] );
+            }
+        }
+    }
+
+    // and only they do
+    vector<aiVector3D> unique( randomPositions );
+    std::sort( unique.begin(), unique.end() );
+    EXPECT_EQ( (unsigned int)( std::unique( unique.begin(), unique.end() ) - unique.begin() ), num );
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SpatialGridTest, testPlanarPositions)
+{
+    // all positions share one coordinate, which degrades the SpatialSort
+    const unsigned int num = (unsigned int)planarPositions.size();
+    vector<unsigned int> foundSort, foundGrid;
+    SpatialSort sort( &planarPositions[0], num, sizeof( aiVector3D ) );
+    SpatialGrid grid( &planarPositions[0], num, sizeof( aiVector3D ) );
+    for (unsigned int i = 0; i < num; ++i) {
+        sort.FindIdenticalPositions( planarPositions[i], foundSort );
+        grid.FindIdenticalPositions( planarPositions[i], foundGrid );
+        std::sort( foundSort.begin(), foundSort.end() );
+        std::sort( foundGrid.begin(), foundGrid.end() );
+        ASSERT_EQ( foundSort, foundGrid );
+    }
+}
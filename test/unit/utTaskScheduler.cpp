@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "SceneDiffer.h"
+
+#include <TaskScheduler.h>
+#include <assimp/Importer.hpp>
+#include <assimp/TaskExecutor.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace Assimp;
+
+class TaskSchedulerTest : public ::testing::Test
+{
+};
+
+// executor which runs the tasks on the submitting thread, counting them
+class InlineExecutor : public TaskExecutor
+{
+public:
+    InlineExecutor() : submitted(0) {}
+
+    unsigned int GetConcurrency() const {
+        return 4;
+    }
+
+    void Submit(Task* task) {
+        ++submitted;
+        task->Run();
+    }
+
+    atomic<unsigned int> submitted;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TaskSchedulerTest, testConcurrency)
+{
+    EXPECT_EQ(1U, TaskScheduler(1).GetConcurrency());
+    EXPECT_EQ(3U, TaskScheduler(3).GetConcurrency());
+    EXPECT_LE(1U, TaskScheduler(0).GetConcurrency());
+
+    // the executor limits the thread count
+    InlineExecutor executor;
+    EXPECT_EQ(4U, TaskScheduler(0, &executor).GetConcurrency());
+    EXPECT_EQ(2U, TaskScheduler(2, &executor).GetConcurrency());
+    EXPECT_EQ(4U, TaskScheduler(8, &executor).GetConcurrency());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TaskSchedulerTest, testParallelFor)
+{
+    TaskScheduler scheduler(4);
+    vector<atomic<unsigned int> > calls(10000);
+    for (size_t i = 0; i < calls.size(); ++i) {
+        calls[i] = 0;
+    }
+
+    // run it twice to reuse the threads
+    for (unsigned int run = 1; run <= 2; ++run) {
+        scheduler.ParallelFor(calls.size(), [&calls](size_t i) {
+            ++calls[i];
+        });
+        for (size_t i = 0; i < calls.size(); ++i) {
+            EXPECT_EQ(run, calls[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TaskSchedulerTest, testNestedParallelFor)
+{
+    // all threads are busy with the outer loop, the inner loops must not wait for them
+    TaskScheduler scheduler(3);
+    atomic<size_t> sum(0);
+    scheduler.ParallelFor(16, [&scheduler, &sum](size_t i) {
+        scheduler.ParallelFor(100, [&sum, i](size_t j) {
+            sum += i * 100 + j;
+        });
+    });
+    EXPECT_EQ(1599U * 1600U / 2U, sum);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TaskSchedulerTest, testException)
+{
+    TaskScheduler scheduler(4);
+    bool caught = false;
+    try {
+        scheduler.ParallelFor(1000, [](size_t i) {
+            if (500 == i) {
+                throw runtime_error("failure");
+            }
+        });
+    }
+    catch (const runtime_error&) {
+        caught = true;
+    }
+    EXPECT_TRUE(caught);
+
+    // the scheduler is still usable afterwards
+    atomic<size_t> count(0);
+    scheduler.ParallelFor(100, [&count](size_t) { ++count; });
+    EXPECT_EQ(100U, count);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(TaskSchedulerTest, testCustomExecutor)
+{
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals;
+
+    Importer serial;
+    const aiScene* expected = serial.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != expected);
+
+    // the work of the post-processing steps is handed to the executor
+    InlineExecutor executor;
+    Importer importer;
+    importer.SetTaskExecutor(&executor);
+    EXPECT_EQ(&executor, importer.GetTaskExecutor());
+    importer.SetPropertyBool(AI_CONFIG_PP_PARALLEL_MESHES, true);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_TRUE(NULL != scene);
+    EXPECT_LT(0U, executor.submitted);
+
+    SceneDiffer differ;
+    EXPECT_TRUE(differ.isEqual(expected, scene));
+    differ.showReport();
+
+    importer.SetTaskExecutor(NULL);
+    EXPECT_TRUE(NULL == importer.GetTaskExecutor());
+}
@@ -0,0 +1,122 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+#include "AbstractImportExportBase.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <sstream>
+
+using namespace Assimp;
+
+class utX3DImportExport : public AbstractImportExportBase {
+public:
+    // Builds a scene with pNumShapes shapes. Every shape defines its own grid of pGridSize x pGridSize quads
+    // split into triangles, and then all grids are instanced a second time through "USE".
+    static std::string MakeGridScene( unsigned int pNumShapes, unsigned int pGridSize ) {
+        std::ostringstream coords, indices;
+        for ( unsigned int y = 0; y <= pGridSize; ++y ) {
+            for ( unsigned int x = 0; x <= pGridSize; ++x ) {
+                coords << x << " " << y << " 0 ";
+            }
+        }
+        for ( unsigned int y = 0; y < pGridSize; ++y ) {
+            for ( unsigned int x = 0; x < pGridSize; ++x ) {
+                const unsigned int i = y * ( pGridSize + 1 ) + x;
+                indices << i << " " << i + 1 << " " << i + pGridSize + 2 << " -1 ";
+                indices << i << " " << i + pGridSize + 2 << " " << i + pGridSize + 1 << " -1 ";
+            }
+        }
+
+        std::ostringstream x3d;
+        x3d << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<X3D profile=\"Interchange\" version=\"3.3\">\n<Scene>\n";
+        for ( unsigned int s = 0; s < pNumShapes; ++s ) {
+            x3d << "<Shape><IndexedFaceSet coordIndex=\"" << indices.str() << "\">"
+                << "<Coordinate DEF=\"grid" << s << "\" point=\"" << coords.str() << "\"/>"
+                << "</IndexedFaceSet></Shape>\n";
+        }
+        for ( unsigned int s = 0; s < pNumShapes; ++s ) {
+            x3d << "<Shape><IndexedFaceSet coordIndex=\"" << indices.str() << "\">"
+                << "<Coordinate USE=\"grid" << s << "\"/>"
+                << "</IndexedFaceSet></Shape>\n";
+        }
+        x3d << "</Scene>\n</X3D>\n";
+
+        return x3d.str();
+    }
+
+    virtual bool importerTest() {
+        const std::string x3d = MakeGridScene( 2, 2 );
+
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFileFromMemory( x3d.c_str(), x3d.size(), 0, "x3d" );
+        return nullptr != scene;
+    }
+};
+
+TEST_F( utX3DImportExport, importX3DFromMemoryTest ) {
+    EXPECT_TRUE( importerTest() );
+}
+
+TEST_F( utX3DImportExport, importIndexedFaceSetWithDefUseTest ) {
+    const unsigned int numShapes = 64;
+    const unsigned int gridSize = 16;
+    const std::string x3d = MakeGridScene( numShapes, gridSize );
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory( x3d.c_str(), x3d.size(), 0, "x3d" );
+    ASSERT_NE( nullptr, scene );
+    ASSERT_EQ( numShapes * 2, scene->mNumMeshes );
+
+    for ( unsigned int i = 0; i < scene->mNumMeshes; ++i ) {
+        const aiMesh *mesh = scene->mMeshes[ i ];
+        EXPECT_EQ( ( gridSize + 1 ) * ( gridSize + 1 ), mesh->mNumVertices );
+        ASSERT_EQ( gridSize * gridSize * 2, mesh->mNumFaces );
+        EXPECT_EQ( static_cast<unsigned int>( aiPrimitiveType_TRIANGLE ), mesh->mPrimitiveTypes );
+        EXPECT_EQ( 3u, mesh->mFaces[ 0 ].mNumIndices );
+        EXPECT_EQ( gridSize + 2, mesh->mFaces[ 0 ].mIndices[ 2 ] );
+        EXPECT_FLOAT_EQ( static_cast<float>( gridSize ), mesh->mVertices[ mesh->mNumVertices - 1 ].x );
+    }
+}
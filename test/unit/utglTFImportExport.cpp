@@ -40,8 +40,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "ImportCompare.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+
+#include "Exceptional.h"
+#include "glTFAsset.h"
+
+#include <fstream>
+#include <sstream>
 
 using namespace Assimp;
 
@@ -59,3 +69,91 @@ public:
 TEST_F( utglTFImportExport, importglTFromFileTest ) {
     EXPECT_TRUE( importerTest() );
 }
+
+TEST_F( utglTFImportExport, binaryTest ) {
+    Assimp::Importer text, binary, pooled;
+    pooled.SetPropertyBool( AI_CONFIG_IMPORT_POOL_FACE_INDICES, true );
+
+    const aiScene* expected = text.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF/BoxTextured.gltf", 0 );
+    ASSERT_NE( nullptr, expected );
+    ASSERT_EQ( 1U, expected->mNumMeshes );
+    EXPECT_EQ( 12U, expected->mMeshes[ 0 ]->mNumFaces );
+    EXPECT_TRUE( expected->mMeshes[ 0 ]->HasNormals() );
+    ASSERT_TRUE( expected->mMeshes[ 0 ]->HasTextureCoords( 0 ) );
+
+    // the texture coordinates are interleaved with a stride of their own size
+    const aiMesh* mesh = expected->mMeshes[ 0 ];
+    for ( unsigned int v = 0; v < mesh->mNumVertices; ++v ) {
+        EXPECT_EQ( 0.f, mesh->mTextureCoords[ 0 ][ v ].z );
+    }
+
+    const aiScene* actual = binary.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Binary/BoxTextured.glb", 0 );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( expected, actual );
+
+    actual = pooled.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Binary/BoxTextured.glb", 0 );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( expected, actual );
+}
+
+TEST_F( utglTFImportExport, accessorRangeTest ) {
+    std::ifstream in( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Embedded/BoxTextured.gltf" );
+    std::stringstream content;
+    content << in.rdbuf();
+    std::string json = content.str();
+
+    // let the texture coordinates run past the end of their buffer
+    const std::string::size_type accessor = json.find( "\"accessor_27\": {" );
+    ASSERT_NE( std::string::npos, accessor );
+    const std::string::size_type count = json.find( "\"count\": 24", accessor );
+    ASSERT_NE( std::string::npos, count );
+    json.replace( count, 11, "\"count\": 240" );
+
+    TemporaryFile file( "BoxTexturedBroken.gltf" );
+    std::ofstream out( file.c_str() );
+    out << json;
+    out.close();
+
+    Assimp::Importer importer;
+    EXPECT_EQ( nullptr, importer.ReadFile( file.Path(), 0 ) );
+}
+
+TEST_F( utglTFImportExport, base64Test ) {
+    std::string encoded;
+    glTF::Util::EncodeBase64( reinterpret_cast<const uint8_t*>( "Man" ), 3, encoded );
+    EXPECT_EQ( "TWFu", encoded );
+    glTF::Util::EncodeBase64( reinterpret_cast<const uint8_t*>( "Ma" ), 2, encoded );
+    EXPECT_EQ( "TWFuTWE=", encoded );
+    glTF::Util::EncodeBase64( reinterpret_cast<const uint8_t*>( "M" ), 1, encoded );
+    EXPECT_EQ( "TWFuTWE=TQ==", encoded );
+
+    // every byte value, all lengths of the last group
+    std::vector<uint8_t> bytes( 1000 );
+    for ( size_t i = 0; i < bytes.size(); ++i ) {
+        bytes[ i ] = static_cast<uint8_t>( i * 7 + i / 256 );
+    }
+    for ( size_t length = 0; length < 10; ++length ) {
+        std::string text;
+        glTF::Util::EncodeBase64( &bytes[ 0 ], bytes.size() - length, text );
+        EXPECT_EQ( 0U, text.size() % 4 );
+
+        uint8_t* decoded = nullptr;
+        ASSERT_EQ( bytes.size() - length, glTF::Util::DecodeBase64( text.c_str(), text.size(), decoded ) );
+        EXPECT_EQ( 0, memcmp( &bytes[ 0 ], decoded, bytes.size() - length ) );
+        delete[] decoded;
+    }
+
+    uint8_t* decoded = nullptr;
+    EXPECT_THROW( glTF::Util::DecodeBase64( "TW!u", 4, decoded ), DeadlyImportError );
+    EXPECT_THROW( glTF::Util::DecodeBase64( "TW\xc3u", 4, decoded ), DeadlyImportError );
+    EXPECT_THROW( glTF::Util::DecodeBase64( "TWFuT", 5, decoded ), DeadlyImportError );
+}
+
+TEST_F( utglTFImportExport, embeddedTest ) {
+    Assimp::Importer text, embedded;
+    const aiScene* expected = text.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF/BoxTextured.gltf", 0 );
+    ASSERT_NE( nullptr, expected );
+    const aiScene* actual = embedded.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF/BoxTextured-glTF-Embedded/BoxTextured.gltf", 0 );
+    ASSERT_NE( nullptr, actual );
+    CheckSameMeshes( expected, actual );
+}
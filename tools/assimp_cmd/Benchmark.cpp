@@ -0,0 +1,202 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2016, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Benchmark.cpp
+ *  @brief Implementation of the 'assimp benchmark' utility
+ */
+
+#include "Main.h"
+
+#include <assimp/config.h>
+#include "Exceptional.h"
+#include "glTFAsset.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+const char* AICMD_MSG_BENCHMARK_HELP_E =
+"assimp benchmark <file> [-n<runs>] [-t<threads>] [-w] [-p]\n"
+"\tImport a file repeatedly and report the throughput in MB/s\n"
+"\t-n<runs>: Number of timed imports, defaults to 5\n"
+"\t-t<threads>: Worker threads for importers that support them, 0 for all\n"
+"\t-w: Weld identical vertices of STL files during import\n"
+"\t-p: Apply aiProcessPreset_TargetRealtime_Fast, raw import otherwise\n"
+"assimp benchmark --base64 [-n<runs>] [-s<size>]\n"
+"\tEncode and decode random data with the base64 codec of the glTF\n"
+"\timporter and exporter and report the throughput in MB/s\n"
+"\t-s<size>: Size of the data in MB, defaults to 64\n";
+
+
+// -----------------------------------------------------------------------------------
+static long GetFileSize(const std::string& file)
+{
+	FILE* f = fopen(file.c_str(),"rb");
+	if (!f) {
+		return -1;
+	}
+	fseek(f,0,SEEK_END);
+	const long size = ftell(f);
+	fclose(f);
+	return size;
+}
+
+// -----------------------------------------------------------------------------------
+static int BenchmarkBase64(unsigned int runs, unsigned int size)
+{
+	std::vector<uint8_t> data(static_cast<size_t>(size) * 1024 * 1024);
+	srand(42);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(rand());
+	}
+
+	double bestEncode = 0.0, bestDecode = 0.0;
+	for (unsigned int i = 0; i < runs; ++i) {
+		std::string text;
+		uint8_t* decoded = NULL;
+		const std::chrono::steady_clock::time_point first = std::chrono::steady_clock::now();
+		glTF::Util::EncodeBase64(&data[0],data.size(),text);
+		const std::chrono::steady_clock::time_point second = std::chrono::steady_clock::now();
+		const size_t length = glTF::Util::DecodeBase64(text.c_str(),text.size(),decoded);
+		const std::chrono::steady_clock::time_point third = std::chrono::steady_clock::now();
+
+		const bool same = length == data.size() && !memcmp(decoded,&data[0],length);
+		delete[] decoded;
+		if (!same) {
+			printf("assimp benchmark: Decoded data differs from the input\n");
+			return 5;
+		}
+
+		const double encode = std::chrono::duration<double>(second - first).count();
+		const double decode = std::chrono::duration<double>(third - second).count();
+		printf("Run %2u: encode %.4f s, decode %.4f s\n",i+1,encode,decode);
+		bestEncode = i ? std::min(bestEncode,encode) : encode;
+		bestDecode = i ? std::min(bestDecode,decode) : decode;
+	}
+
+	// both are measured in MB of binary data
+	printf("\nData size:  %u MB\n",size);
+	printf("Encode:     %.4f s, %.2f MB/s\n",bestEncode,size / bestEncode);
+	printf("Decode:     %.4f s, %.2f MB/s\n",bestDecode,size / bestDecode);
+	return 0;
+}
+
+// -----------------------------------------------------------------------------------
+int Assimp_Benchmark (const char* const* params, unsigned int num)
+{
+	if (num < 1) {
+		printf("assimp benchmark: Invalid number of arguments. "
+			"See \'assimp benchmark --help\'\n");
+		return 1;
+	}
+
+	// --help
+	if (!strcmp( params[0],"-h")||!strcmp( params[0],"--help")||!strcmp( params[0],"-?") ) {
+		printf("%s",AICMD_MSG_BENCHMARK_HELP_E);
+		return 0;
+	}
+
+	const std::string in = std::string(params[0]);
+
+	unsigned int runs = 5, flags = 0, size = 64;
+	int threads = 1;
+	bool weld = false;
+	for (unsigned int i = 1; i < num; ++i) {
+		if (!strncmp(params[i],"-n",2)) {
+			runs = std::max(1,atoi(params[i]+2));
+		}
+		else if (!strncmp(params[i],"-s",2)) {
+			size = std::max(1,atoi(params[i]+2));
+		}
+		else if (!strncmp(params[i],"-t",2)) {
+			threads = atoi(params[i]+2);
+		}
+		else if (!strcmp(params[i],"-w")) {
+			weld = true;
+		}
+		else if (!strcmp(params[i],"-p")) {
+			flags = aiProcessPreset_TargetRealtime_Fast;
+		}
+	}
+
+	if (in == "--base64") {
+		return BenchmarkBase64(runs,size);
+	}
+
+	const long fileSize = GetFileSize(in);
+	if (fileSize <= 0) {
+		printf("assimp benchmark: Unable to open input file %s\n",
+			in.c_str());
+		return 5;
+	}
+
+	globalImporter->SetPropertyInteger(AI_CONFIG_IMPORT_STL_NUM_THREADS,threads);
+	globalImporter->SetPropertyInteger(AI_CONFIG_IMPORT_OBJ_NUM_THREADS,threads);
+	globalImporter->SetPropertyInteger(AI_CONFIG_IMPORT_FBX_NUM_THREADS,threads);
+	globalImporter->SetPropertyInteger(AI_CONFIG_PP_PARALLEL_NUM_THREADS,threads);
+	globalImporter->SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES,weld);
+
+	double best = 0.0, total = 0.0;
+	for (unsigned int i = 0; i < runs; ++i) {
+		const std::chrono::steady_clock::time_point first = std::chrono::steady_clock::now();
+		const aiScene* scene = globalImporter->ReadFile(in,flags);
+		const std::chrono::steady_clock::time_point second = std::chrono::steady_clock::now();
+		if (!scene) {
+			printf("assimp benchmark: Unable to load input file %s: %s\n",
+				in.c_str(),globalImporter->GetErrorString());
+			return 5;
+		}
+
+		const double seconds = std::chrono::duration<double>(second - first).count();
+		printf("Run %2u: %.4f s\n",i+1,seconds);
+		best = i ? std::min(best,seconds) : seconds;
+		total += seconds;
+	}
+	globalImporter->FreeScene();
+
+	const double mb = fileSize / (1024.0 * 1024.0);
+	printf("\nFile size:  %.2f MB\n",mb);
+	printf("Average:    %.4f s, %.2f MB/s\n",total / runs,mb * runs / total);
+	printf("Best:       %.4f s, %.2f MB/s\n",best,mb / best);
+	return 0;
+}
@@ -45,9 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Main.h"
 
 const char* AICMD_MSG_INFO_HELP_E =
-"assimp info <file> [-r]\n"
+"assimp info <file> [-r] [-p<file>]\n"
 "\tPrint basic structure of a 3D model\n"
-"\t-r,--raw: No postprocessing, do a raw import\n";
+"\t-r,--raw: No postprocessing, do a raw import\n"
+"\t-p<file>,--profile=<file>: Write the import timings as JSON to <file>\n";
 
 
 // -----------------------------------------------------------------------------------
@@ -180,6 +181,57 @@ std::string FindPTypes(const aiScene* scene)
 		(haveit[2]?"triangles":"")+(haveit[3]?"n-polygons":"");
 }
 
+// -----------------------------------------------------------------------------------
+const char* GetProfilePhaseName(Assimp::ImportProfileEntry::Phase phase)
+{
+	switch (phase) {
+	case Assimp::ImportProfileEntry::Phase_Total:
+		return "total";
+	case Assimp::ImportProfileEntry::Phase_Import:
+		return "import";
+	case Assimp::ImportProfileEntry::Phase_Preprocess:
+		return "preprocess";
+	case Assimp::ImportProfileEntry::Phase_PostProcess:
+		return "postprocess";
+	}
+	return "unknown";
+}
+
+// -----------------------------------------------------------------------------------
+bool WriteProfileJSON(const Assimp::Importer& imp, const std::string& file)
+{
+	FILE* out = fopen(file.c_str(),"wt");
+	if (!out) {
+		return false;
+	}
+
+	fprintf(out,"{\n  \"peak_scene_memory\": %u,\n  \"regions\": [",
+		imp.GetProfilePeakMemory());
+	for (size_t i = 0; i < imp.GetProfileEntryCount(); ++i) {
+		const Assimp::ImportProfileEntry* entry = imp.GetProfileEntry(i);
+
+		// the names are class or importer names, escape just in case
+		std::string name;
+		for (const char* c = entry->mName.data; *c; ++c) {
+			if (*c == '\"' || *c == '\\') {
+				name += '\\';
+			}
+			name += *c;
+		}
+		fprintf(out,"%s\n    { \"phase\": \"%s\", \"name\": \"%s\", \"seconds\": %.6f, "
+			"\"meshes\": %u, \"scene_memory\": %u }",
+			(i ? "," : ""),
+			GetProfilePhaseName(entry->mPhase),
+			name.c_str(),
+			entry->mSeconds,
+			entry->mNumMeshes,
+			entry->mSceneMemory);
+	}
+	fprintf(out,"\n  ]\n}\n");
+	fclose(out);
+	return true;
+}
+
 // -----------------------------------------------------------------------------------
 void PrintHierarchy(const aiNode* root, unsigned int maxnest, unsigned int maxline,
 					unsigned int cline, unsigned int cnest=0)
@@ -219,7 +271,7 @@ int Assimp_Info (const char* const* params, unsigned int num)
 		return 0;
 	}
 
-	// asssimp info <file> [-r]
+	// asssimp info <file> [-r] [-p<file>]
 	if (num < 1) {
 		printf("assimp info: Invalid number of arguments. "
 			"See \'assimp info --help\'\n");
@@ -230,8 +282,20 @@ int Assimp_Info (const char* const* params, unsigned int num)
 
 	// do maximum post-processing unless -r was specified
 	ImportData import;
-	import.ppFlags = num>1&&(!strcmp(params[1],"--raw")||!strcmp(params[1],"-r")) ? 0
-		: aiProcessPreset_TargetRealtime_MaxQuality;
+	import.ppFlags = aiProcessPreset_TargetRealtime_MaxQuality;
+
+	std::string profile;
+	for (unsigned int i = 1; i < num; ++i) {
+		if (!strcmp(params[i],"--raw")||!strcmp(params[i],"-r")) {
+			import.ppFlags = 0;
+		}
+		else if (!strncmp(params[i],"--profile=",10)) {
+			profile = std::string(params[i]+10);
+		}
+		else if (!strncmp(params[i],"-p",2)) {
+			profile = std::string(params[i]+2);
+		}
+	}
 
 	// import the main model
 	const aiScene* scene = ImportModel(import,in);
@@ -241,6 +305,11 @@ int Assimp_Info (const char* const* params, unsigned int num)
 		return 5;
 	}
 
+	if (profile.length() && !WriteProfileJSON(*globalImporter,profile)) {
+		printf("assimp info: Unable to write profile to %s\n",
+			profile.c_str());
+	}
+
 	aiMemoryInfo mem;
 	globalImporter->GetMemoryRequirements(mem);
 
@@ -57,6 +57,7 @@ const char* AICMD_MSG_HELP =
 "assimp <verb> <parameters>\n\n"
 " verbs:\n"
 " \tinfo       - Quick file stats\n"
+" \tbenchmark  - Measure the import or base64 throughput\n"
 " \tlistext    - List all known file extensions available for import\n"
 " \tknowext    - Check whether a file extension is recognized by Assimp\n"
 #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -205,6 +206,12 @@ int main (int argc, char* argv[])
 		return Assimp_Info ((const char**)&argv[2],argc-2);
 	}
 
+	// assimp benchmark
+	// Measure import times and throughput
+	if (! strcmp(argv[1], "benchmark")) {
+		return Assimp_Benchmark ((const char**)&argv[2],argc-2);
+	}
+
 	// assimp dump 
 	// Dump a model to a file 
 	if (! strcmp(argv[1], "dump")) {
@@ -204,5 +204,14 @@ int Assimp_TestBatchLoad (
 	const char* const* params, 
 	unsigned int num);
 
+// ------------------------------------------------------------------------------
+/** @brief assimp benchmark utility
+ *  @param params Command line parameters to 'assimp benchmark'
+ *  @param Number of params
+ *  @return 0 for success */
+int Assimp_Benchmark (
+	const char* const* params, 
+	unsigned int num);
+
 
 #endif // !! AICMD_MAIN_INCLUDED
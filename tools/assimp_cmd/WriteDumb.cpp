@@ -668,7 +668,7 @@ void WriteBinaryDump(const aiScene* scene, FILE* _out, const char* src, const ch
 	fprintf(out,"ASSIMP.binary-dump.%s",asctime(p));
 	// == 44 bytes
 
-	Write<unsigned int>(ASSBIN_VERSION_MAJOR);
+	Write<unsigned int>(ASSBIN_VERSION_MAJOR_INLINE);
 	Write<unsigned int>(ASSBIN_VERSION_MINOR);
 	Write<unsigned int>(aiGetVersionRevision());
 	Write<unsigned int>(aiGetCompileFlags());